@@ -1,5 +1,6 @@
 #include "FitLogger.h"
 #include "PlotUtils.h"
+#include "PrepareUtils.h"
 #include "TFile.h"
 #include "TH1D.h"
 #include "TTree.h"
@@ -23,6 +24,7 @@ std::string gFluxFile = "";
 std::string gTarget = "";
 double MonoEnergy;
 int gNEvents = -999;
+int gNWorkers = -1;
 bool IsMonoE = false;
 bool useNOvAWeights = false;
 
@@ -33,6 +35,59 @@ void RunGENIEPrepareMono(std::string input, std::string target,
 void RunGENIEPrepare(std::string input, std::string flux, std::string target,
                      std::string output);
 bool CheckConfig(std::string filename);
+TChain *OpenGENIEChain(std::string input, std::string &first_file);
+
+// Reads the probe energy, spline cross-section and interaction string of each
+// gtree entry. Worker processes reopen the inputs for themselves.
+class GENIEEntryReader : public PrepareUtils::EntryReader {
+public:
+  GENIEEntryReader(std::string const &input, TChain *tn)
+      : fInput(input), fChain(tn), fRecord(NULL) {
+    SetBranch();
+  }
+
+  void OpenWorker() {
+    std::string first_file;
+    StopTalking();
+    fChain = OpenGENIEChain(fInput, first_file);
+    StartTalking();
+    SetBranch();
+  }
+
+  void Read(Long64_t i, PrepareUtils::EntrySummary &entry, std::string &mode) {
+    fChain->GetEntry(i);
+
+    // Hussssch GENIE
+    StopTalking();
+    // Get the event
+    EventRecord &event = *(fRecord->event);
+    // Get the neutrino
+    GHepParticle *neu = event.Probe();
+    StartTalking();
+
+    // Get XSec From Spline
+    GHepRecord genie_record = static_cast<GHepRecord>(event);
+    entry.E = neu->E();
+    entry.Weight = (genie_record.XSec() / (1E-38 * genie::units::cm2));
+    entry.Key = 0;
+
+    mode = genie_record.Summary()->AsString();
+
+    // Clear Event
+    fRecord->Clear();
+  }
+
+private:
+  void SetBranch() {
+    StopTalking();
+    fChain->SetBranchAddress("gmcrec", &fRecord);
+    StartTalking();
+  }
+
+  std::string fInput;
+  TChain *fChain;
+  NtpMCEventRecord *fRecord;
+};
 
 int main(int argc, char *argv[]) {
   ParseOptions(argc, argv);
@@ -85,15 +140,9 @@ bool CheckConfig(std::string filename) {
   return ShouldScale;
 }
 
-void RunGENIEPrepareMono(std::string input, std::string target,
-    std::string output) {
-
-  NUIS_LOG(FIT, "Running GENIE Prepare in mono energetic with E = " << MonoEnergy
-      << " GeV");
-
-  // Setup TTree
+TChain *OpenGENIEChain(std::string input, std::string &first_file) {
   TChain *tn = new TChain("gtree");
-  std::string first_file = "";
+  first_file = "";
 
   if (input.find_first_of(',') != std::string::npos) {
     std::vector<std::string> inputvect = GeneralUtils::ParseToStr(input, ",");
@@ -117,6 +166,19 @@ void RunGENIEPrepareMono(std::string input, std::string target,
     throw;
   }
 
+  return tn;
+}
+
+void RunGENIEPrepareMono(std::string input, std::string target,
+    std::string output) {
+
+  NUIS_LOG(FIT, "Running GENIE Prepare in mono energetic with E = " << MonoEnergy
+      << " GeV");
+
+  // Setup TTree
+  std::string first_file = "";
+  TChain *tn = OpenGENIEChain(input, first_file);
+
   int nevt = tn->GetEntries();
   if (gNEvents != -999) {
     NUIS_LOG(FIT, "Overriding number of events by user from " << nevt << " to "
@@ -131,11 +193,6 @@ void RunGENIEPrepareMono(std::string input, std::string target,
     NUIS_LOG(FIT, "Found " << nevt << " input entries in " << input);
   }
 
-  StopTalking();
-  NtpMCEventRecord *genientpl = NULL;
-  tn->SetBranchAddress("gmcrec", &genientpl);
-  StartTalking();
-
   // Have the TH1D go from MonoEnergy/2 to MonoEnergy/2
   TH1D *fluxhist =
     new TH1D("flux", "flux", 1000, MonoEnergy / 2., MonoEnergy * 2.);
@@ -155,21 +212,19 @@ void RunGENIEPrepareMono(std::string input, std::string target,
   std::vector<std::string> targetids;
   std::vector<std::string> interids;
 
-  // Loop over all events
-  for (int i = 0; i < nevt; i++) {
-    tn->GetEntry(i);
+  // Loop over all events, possibly read by worker processes
+  PrepareUtils::ChunkedEntryLoop loop(nevt, gNWorkers);
+  GENIEEntryReader reader(input, tn);
+  loop.Start(reader);
 
-    StopTalking();
-    EventRecord &event = *(genientpl->event);
-    GHepParticle *neu = event.Probe();
-    StartTalking();
+  PrepareUtils::EntrySummary entry;
+  std::string mode;
 
-    // Get XSec From Spline
-    GHepRecord genie_record = static_cast<GHepRecord>(event);
-    double xsec = (genie_record.XSec() / (1E-38 * genie::units::cm2));
+  for (int i = 0; i < nevt; i++) {
+    loop.Next(i, entry, mode);
+    double xsec = entry.Weight;
 
     // Parse Interaction String
-    std::string mode = genie_record.Summary()->AsString();
     std::vector<std::string> modevec = GeneralUtils::ParseToStr(mode, ";");
     std::string targ = (modevec[0] + ";" + modevec[1]);
     std::string inter = mode;
@@ -197,24 +252,26 @@ void RunGENIEPrepareMono(std::string input, std::string target,
     }
 
     // Fill XSec Histograms
-    modexsec[mode]->Fill(neu->E(), xsec);
-    modecount[mode]->Fill(neu->E());
+    modexsec[mode]->Fill(entry.E, xsec);
+    modecount[mode]->Fill(entry.E);
 
     // Fill total event hist
-    eventhist->Fill(neu->E());
-
-    // Clear Event
-    genientpl->Clear();
+    eventhist->Fill(entry.E);
 
     size_t freq = nevt / 20;
     if (freq && !(i % freq)) {
       NUIS_LOG(FIT, "Processed "
-          << i << "/" << nevt << " GENIE events (E: " << neu->E()
+          << i << "/" << nevt << " GENIE events (E: " << entry.E
           << " GeV, xsec: " << xsec << " E-38 cm^2/nucleon)");
     }
   }
+  loop.Finish();
   NUIS_LOG(FIT, "Processed all events");
 
+  // Workers read the entries, make sure the chain is on the last file as it
+  // would be after reading them here
+  tn->LoadTree(nevt - 1);
+
   // Check if we need to correct MEC events before possibly deleting the TChain below
   bool MECcorrect = CheckConfig(std::string(tn->GetFile()->GetName()));
 
@@ -524,30 +581,8 @@ void RunGENIEPrepare(std::string input, std::string flux, std::string target,
   }
 
   // Setup TTree
-  TChain *tn = new TChain("gtree");
   std::string first_file = "";
-
-  if (input.find_first_of(',') != std::string::npos) {
-    std::vector<std::string> inputvect = GeneralUtils::ParseToStr(input, ",");
-
-    for (size_t iv_it = 0; iv_it < inputvect.size(); ++iv_it) {
-      tn->AddFile(inputvect[iv_it].c_str());
-      NUIS_LOG(FIT, "Added input file: " << inputvect[iv_it]);
-      if (!first_file.length()) {
-        first_file = inputvect[iv_it];
-      }
-    }
-  } else { // The Add form can accept wildcards.
-    tn->Add(input.c_str());
-    first_file = input;
-  }
-
-  if (tn->GetFile() == NULL) {
-    tn->Print();
-    NUIS_ERR(FTL, "gtree not located in GENIE file: " << input);
-    NUIS_ABORT("Check your inputs, they may need to be completely regenerated!");
-    throw;
-  }
+  TChain *tn = OpenGENIEChain(input, first_file);
 
   int nevt = tn->GetEntries();
   if (gNEvents != -999) {
@@ -563,11 +598,6 @@ void RunGENIEPrepare(std::string input, std::string flux, std::string target,
     NUIS_LOG(FIT, "Found " << nevt << " input entries in " << input);
   }
 
-  StopTalking();
-  NtpMCEventRecord *genientpl = NULL;
-  tn->SetBranchAddress("gmcrec", &genientpl);
-  StartTalking();
-
   // Make Event and xsec Hist
   TH1D *eventhist = (TH1D *)fluxhist->Clone();
   eventhist->SetDirectory(NULL);
@@ -582,25 +612,19 @@ void RunGENIEPrepare(std::string input, std::string flux, std::string target,
   std::vector<std::string> targetids;
   std::vector<std::string> interids;
 
-  // Loop over all events
-  for (int i = 0; i < nevt; i++) {
-    tn->GetEntry(i);
+  // Loop over all events, possibly read by worker processes
+  PrepareUtils::ChunkedEntryLoop loop(nevt, gNWorkers);
+  GENIEEntryReader reader(input, tn);
+  loop.Start(reader);
 
-    // Hussssch GENIE
-    StopTalking();
-    // Get the event
-    EventRecord &event = *(genientpl->event);
-    // Get the neutrino
-    GHepParticle *neu = event.Probe();
-    StartTalking();
+  PrepareUtils::EntrySummary entry;
+  std::string mode;
 
-    // Get XSec From Spline
-    // Get the GHepRecord
-    GHepRecord genie_record = static_cast<GHepRecord>(event);
-    double xsec = (genie_record.XSec() / (1E-38 * genie::units::cm2));
+  for (int i = 0; i < nevt; i++) {
+    loop.Next(i, entry, mode);
+    double xsec = entry.Weight;
 
     // Parse Interaction String
-    std::string mode = genie_record.Summary()->AsString();
     std::vector<std::string> modevec = GeneralUtils::ParseToStr(mode, ";");
     std::string targ = (modevec[0] + ";" + modevec[1]);
     std::string inter = mode;
@@ -637,26 +661,28 @@ void RunGENIEPrepare(std::string input, std::string flux, std::string target,
     }
 
     // Fill XSec Histograms
-    modexsec[mode]->Fill(neu->E(), xsec);
-    modecount[mode]->Fill(neu->E());
+    modexsec[mode]->Fill(entry.E, xsec);
+    modecount[mode]->Fill(entry.E);
 
     // Fill total event hist
-    eventhist->Fill(neu->E());
+    eventhist->Fill(entry.E);
 
     int countwidth = nevt / 20;
     countwidth = (countwidth >= 1) ? countwidth : 1;
 
     if (i % countwidth == 0) {
       NUIS_LOG(FIT, "Processed "
-          << i << "/" << nevt << " GENIE events (E: " << neu->E()
+          << i << "/" << nevt << " GENIE events (E: " << entry.E
           << " GeV, xsec: " << xsec << " E-38 cm^2/nucleon)");
     }
-
-    // Clear Event
-    genientpl->Clear();
   }
+  loop.Finish();
   NUIS_LOG(FIT, "Processed all events");
 
+  // Workers read the entries, make sure the chain is on the last file as it
+  // would be after reading them here
+  tn->LoadTree(nevt - 1);
+
   // Check if we need to correct MEC events before possibly deleting the TChain below
   bool MECcorrect = CheckConfig(std::string(tn->GetFile()->GetName()));
 
@@ -925,7 +951,7 @@ void PrintOptions() {
     "inputfile1.root,inputfile2.root,inputfile3.root,...] "
     << "[-f flux_root_file.root,flux_hist_name] [-t "
     "target1[frac1],target2[frac2],...]"
-    << "[-n number_of_events (experimental)]" << std::endl
+    << "[-n number_of_events (experimental)] [-j nworkers]" << std::endl
     << std::endl;
 
   std::cout << "Prepare Mode [Default] : Takes a single GHep file, "
@@ -958,6 +984,9 @@ void PrintOptions() {
   std::cout << " [ -n number_of_evt ] : Run with a reduced number of events "
     "for debugging purposes"
     << std::endl;
+  std::cout << " [ -j nworkers ] : Read the GENIE records with nworkers "
+    "processes, 0 for one per core. The output does not depend on this."
+    << std::endl;
 }
 
 void ParseOptions(int argc, char *argv[]) {
@@ -1000,6 +1029,9 @@ void ParseOptions(int argc, char *argv[]) {
       } else if (!std::strcmp(argv[i], "-n")) {
         gNEvents = GeneralUtils::StrToInt(argv[i + 1]);
         ++i;
+      } else if (!std::strcmp(argv[i], "-j")) {
+        gNWorkers = GeneralUtils::StrToInt(argv[i + 1]);
+        ++i;
       } else if (!std::strcmp(argv[i], "-m")) {
         MonoEnergy = GeneralUtils::StrToDbl(argv[i + 1]);
         IsMonoE = true;
@@ -1041,5 +1073,7 @@ void ParseOptions(int argc, char *argv[]) {
     exit(-1);
   }
 
+  gNWorkers = PrepareUtils::ChunkedEntryLoop::ResolveNWorkers(gNWorkers);
+
   return;
 }
@@ -1,5 +1,6 @@
 #include "FitLogger.h"
 #include "PlotUtils.h"
+#include "PrepareUtils.h"
 #include "StatUtils.h"
 #include "TFile.h"
 #include "TH1D.h"
@@ -18,6 +19,7 @@ bool fFluxInGeV = false;
 bool fIsMonoEFlux = false;
 double fMonoEEnergy = 0xdeadbeef;
 double fXSecOverride = 0;
+int fNWorkers = -1;
 
 void PrintOptions();
 void ParseOptions(int argc, char *argv[]);
@@ -26,6 +28,37 @@ void AddMonoRateHistogram(std::string inputList, double MonoE,
 void CreateRateHistogram(std::string inputList, std::string flux,
                          std::string output);
 
+// Reads the neutrino energy and Totcrs of each neuttree entry. Worker
+// processes reopen the inputs for themselves.
+class NEUTEntryReader : public PrepareUtils::EntryReader {
+public:
+  NEUTEntryReader(std::vector<std::string> const &inputs, TChain *tn)
+      : fInputs(inputs), fChain(tn), fNeutVect(NULL) {
+    fChain->SetBranchAddress("vectorbranch", &fNeutVect);
+  }
+
+  void OpenWorker() {
+    fChain = new TChain("neuttree");
+    for (size_t i = 0; i < fInputs.size(); ++i) {
+      fChain->AddFile(fInputs[i].c_str());
+    }
+    fChain->SetBranchAddress("vectorbranch", &fNeutVect);
+  }
+
+  void Read(Long64_t i, PrepareUtils::EntrySummary &entry, std::string &) {
+    fChain->GetEntry(i);
+    NeutPart *part = fNeutVect->PartInfo(0);
+    entry.E = part->fP.E();
+    entry.Weight = fNeutVect->Totcrs;
+    entry.Key = 0;
+  }
+
+private:
+  std::vector<std::string> fInputs;
+  TChain *fChain;
+  NeutVect *fNeutVect;
+};
+
 //*******************************
 int main(int argc, char *argv[]) {
   //*******************************
@@ -200,9 +233,6 @@ void CreateRateHistogram(std::string inputList, std::string flux,
     NUIS_ABORT("Either the input file is not from NEUT, or it's empty...");
   }
 
-  NeutVect *fNeutVect = NULL;
-  tn->SetBranchAddress("vectorbranch", &fNeutVect);
-
   // Get Flux Hist
   std::vector<std::string> fluxvect = GeneralUtils::ParseToStr(flux, ",");
   TH1D *fluxHist = NULL;
@@ -228,11 +258,18 @@ void CreateRateHistogram(std::string inputList, std::string flux,
   // Make a total cross section hist for shits and giggles
   TH1D *entryHist = (TH1D *)xsecHist->Clone();
 
+  // Entries may be read by worker processes, but are filled here in order
+  PrepareUtils::ChunkedEntryLoop loop(nevts, fNWorkers);
+  NEUTEntryReader reader(inputs, tn);
+  loop.Start(reader);
+
+  PrepareUtils::EntrySummary entry;
+  std::string label;
+
   for (int i = 0; i < nevts; ++i) {
-    tn->GetEntry(i);
-    NeutPart *part = fNeutVect->PartInfo(0);
-    double E = part->fP.E();
-    double xsec = fNeutVect->Totcrs;
+    loop.Next(i, entry, label);
+    double E = entry.E;
+    double xsec = entry.Weight;
 
     // Unit conversion
     if (fFluxInGeV)
@@ -246,6 +283,7 @@ void CreateRateHistogram(std::string inputList, std::string flux,
                              << "(Enu = " << E << ", xsec = " << xsec << ") ");
     }
   }
+  loop.Finish();
   NUIS_LOG(FIT, "Processed all events");
 
   xsecHist->Divide(entryHist);
@@ -361,6 +399,10 @@ void PrintOptions() {
   std::cout << "          Used to add dummy flux and evt rate histograms to "
                "mono-energetic vectors. Adheres to the -G flag."
             << std::endl;
+  std::cout << "    [-j nworkers]" << std::endl;
+  std::cout << "          Read the NEUT vectors with nworkers processes, 0 for "
+               "one per core. The output does not depend on this."
+            << std::endl;
 }
 
 void ParseOptions(int argc, char *argv[]) {
@@ -393,6 +435,9 @@ void ParseOptions(int argc, char *argv[]) {
         fIsMonoEFlux = true;
         fMonoEEnergy = GeneralUtils::StrToDbl(argv[i + 1]);
         ++i;
+      } else if (!std::strcmp(argv[i], "-j")) {
+        fNWorkers = GeneralUtils::StrToInt(argv[i + 1]);
+        ++i;
       } else if (!std::strcmp(argv[i],"-X")){
         fXSecOverride = GeneralUtils::StrToDbl(argv[i + 1]);
 	++i;
@@ -419,5 +464,7 @@ void ParseOptions(int argc, char *argv[]) {
     exit(-1);
   }
 
+  fNWorkers = PrepareUtils::ChunkedEntryLoop::ResolveNWorkers(fNWorkers);
+
   return;
 }
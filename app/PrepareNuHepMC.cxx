@@ -0,0 +1,94 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+
+#include "FitLogger.h"
+#include "NuHepMCInputHandler.h"
+
+#include <string>
+#include <vector>
+
+std::vector<std::string> fInputFiles;
+bool fForce = false;
+
+void PrintOptions() {
+  std::cout << "[USAGE]: PrepareNuHepMC [-h] [-f] input.hepmc3 [input2.hepmc3 "
+               "...]"
+            << std::endl
+            << "\t-h : Print this message." << std::endl
+            << "\t-f : Rebuild the offset index even if an up to date one "
+               "exists."
+            << std::endl
+            << std::endl
+            << "Writes <input>.nuisidx next to each uncompressed HepMC3 ASCII "
+               "input so that NUISANCE can seek directly to any event."
+            << std::endl;
+}
+
+void ParseOptions(int argc, char *argv[]) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "-h") {
+      PrintOptions();
+      exit(0);
+    } else if (arg == "-f") {
+      fForce = true;
+    } else {
+      fInputFiles.push_back(arg);
+    }
+  }
+
+  if (fInputFiles.empty()) {
+    PrintOptions();
+    NUIS_ABORT("No input files specified.");
+  }
+}
+
+int main(int argc, char *argv[]) {
+
+  SETVERBOSITY(FitPar::Config().GetParI("VERBOSITY"));
+  SETERRVERBOSITY(FitPar::Config().GetParI("ERROR"));
+
+  ParseOptions(argc, argv);
+  NUIS_LOG(FIT, "Running PrepareNuHepMC");
+
+  std::vector<std::streamoff> offsets;
+  for (size_t i = 0; i < fInputFiles.size(); ++i) {
+    std::string const &file = fInputFiles[i];
+
+    if (!fForce && NuHepMCInputHandler::ReadOffsetIndex(file, offsets)) {
+      NUIS_LOG(FIT, "Offset index for " << file << " is up to date ("
+                                        << offsets.size() << " events).");
+      continue;
+    }
+
+    if (!NuHepMCInputHandler::BuildOffsetIndex(file, offsets)) {
+      NUIS_ERR(WRN, "Cannot index " << file
+                                    << ", only uncompressed HepMC3 ASCII "
+                                       "files support random access.");
+      continue;
+    }
+
+    if (!NuHepMCInputHandler::WriteOffsetIndex(file, offsets)) {
+      NUIS_ABORT("Failed to write "
+                 << NuHepMCInputHandler::GetOffsetIndexName(file));
+    }
+    NUIS_LOG(FIT, "Wrote " << NuHepMCInputHandler::GetOffsetIndexName(file)
+                           << " (" << offsets.size() << " events).");
+  }
+}
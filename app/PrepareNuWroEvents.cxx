@@ -6,19 +6,22 @@
 // #include "params.h"
 #include "FitLogger.h"
 #include "PlotUtils.h"
+#include "PrepareUtils.h"
 #include "TFile.h"
 #include "TH1D.h"
 #include "TTree.h"
 
 void printInputCommands(char *argv[]) {
   std::cout << "[USAGE]: " << argv[0]
-            << " [-h] [-f] [-F <FluxRootFile>,<FluxHistName>[,PDG[,speciesFraction]] [-o output.root] "
+            << " [-h] [-f] [-F <FluxRootFile>,<FluxHistName>[,PDG[,speciesFraction]] [-o output.root] [-j nworkers] "
                "inputfile.root [file2.root ...]"
             << std::endl
             << "\t-h : Print this message." << std::endl
             << "\t-f : Pass -f argument to '$ hadd' invocation." << std::endl
             << "\t-F : Read input flux from input descriptor." << std::endl
             << "\t-o : Write full output to a new file." << std::endl
+            << "\t-j : Read events with this many processes, 0 for one per "
+               "core." << std::endl
             << std::endl;
 };
 void CreateRateHistograms(std::string inputs, bool force_out);
@@ -27,6 +30,7 @@ void HaddNuwroFiles(std::vector<std::string> &inputs, bool force_out);
 bool outputNewFile = false;
 std::string ofile = "";
 bool haveFluxInputs = false;
+int nWorkers = -1;
 
 struct FluxInputBlob {
   FluxInputBlob(std::string _File, std::string _Hist, int _PDG,
@@ -42,6 +46,37 @@ std::vector<FluxInputBlob> FluxInputs;
 
 bool haddedFiles = false;
 
+// Reads the neutrino energy, weight and PDG of each treeout entry. Worker
+// processes reopen the input file for themselves.
+class NuWroEntryReader : public PrepareUtils::EntryReader {
+public:
+  NuWroEntryReader(std::string const &input, TTree *tree, event *evt)
+      : fInput(input), fTree(tree), fEvent(evt) {}
+
+  void OpenWorker() {
+    TFile *inpFile = new TFile(fInput.c_str(), "READ");
+    fTree = inpFile ? dynamic_cast<TTree *>(inpFile->Get("treeout")) : NULL;
+    if (!fTree) {
+      NUIS_ABORT("Cannot find TTree \"treeout\" in input root file: "
+                 << fInput);
+    }
+    fEvent = new event();
+    fTree->SetBranchAddress("e", &fEvent);
+  }
+
+  void Read(Long64_t i, PrepareUtils::EntrySummary &entry, std::string &) {
+    fTree->GetEntry(i);
+    entry.E = fEvent->in[0].t / 1000.0;
+    entry.Weight = fEvent->weight;
+    entry.Key = fEvent->in[0].pdg;
+  }
+
+private:
+  std::string fInput;
+  TTree *fTree;
+  event *fEvent;
+};
+
 TH1D *F2D(TH1F *f) {
   Double_t *bins = new Double_t[f->GetXaxis()->GetNbins() + 1];
   for (Int_t bi_it = 0; bi_it < f->GetXaxis()->GetNbins(); ++bi_it) {
@@ -124,6 +159,8 @@ int main(int argc, char *argv[]) {
     } else if (!std::strcmp(argv[i], "-o")) {
       outputNewFile = true;
       ofile = argv[++i];
+    } else if (!std::strcmp(argv[i], "-j")) {
+      nWorkers = GeneralUtils::StrToInt(argv[++i]);
     } else if (!std::strcmp(argv[i], "-F")) {
       std::string inpLine = argv[++i];
       std::vector<std::string> fluxInputDescriptor =
@@ -158,6 +195,8 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  nWorkers = PrepareUtils::ChunkedEntryLoop::ResolveNWorkers(nWorkers);
+
   // If one input file just create flux histograms
   if (inputfiles.size() > (UInt_t)1) {
     HaddNuwroFiles(inputfiles, force_output);
@@ -408,14 +447,23 @@ void CreateRateHistograms(std::string inputs, bool force_out) {
   int countwidth = nevents / 50.0;
   countwidth = countwidth ? countwidth : 1;
 
+  // Entries may be read by worker processes from the input file, which has
+  // the same entries as any clone, but are filled here in order
+  PrepareUtils::ChunkedEntryLoop loop(nevents, nWorkers);
+  NuWroEntryReader reader(inputs, nuwrotree, evt);
+  loop.Start(reader);
+
+  PrepareUtils::EntrySummary entry;
+  std::string label;
+
   for (int i = 0; i < nevents; i++) {
-    nuwrotree->GetEntry(i);
+    loop.Next(i, entry, label);
 
     // Get Variables
-    Enu = evt->in[0].t / 1000.0;
-    TotXSec = evt->weight;
-    pdg = evt->in[0].pdg;
-    
+    Enu = entry.E;
+    TotXSec = entry.Weight;
+    pdg = entry.Key;
+
     if (std::find(allpdg.begin(), allpdg.end(), pdg) == allpdg.end()) {
       NUIS_ABORT("Not set up to handle PDG: " << pdg << " check your inputs");
     }
@@ -436,6 +484,7 @@ void CreateRateHistograms(std::string inputs, bool force_out) {
                                  << ", " << pdg)
     }
   }
+  loop.Finish();
 
   TH1D *zeroevents = (TH1D *)eventlist[0]->Clone();
 
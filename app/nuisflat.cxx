@@ -76,7 +76,12 @@ void PrintSyntax() {
       << "\n\t[-t options]: Pass OPTION to the FlatTree sample. "
       << "\n\t              Similar to type field in comparison xml configs."
       << "\n\t"
-      << "\n\t[-q con=val]: Configuration overrides." << std::endl;
+      << "\n\t[-q con=val]: Configuration overrides."
+      << "\n\t              e.g. -q nuisflat_NThreads=8 to flatten "
+         "GenericVectors"
+      << "\n\t              on 8 threads or -q nuisflat_Branches=Enu_true,Q2 "
+         "to"
+      << "\n\t              save only those branches." << std::endl;
 
   exit(-1);
 };
@@ -164,6 +169,7 @@ int main(int argc, char *argv[]) {
   std::cout << "[ NUISANCE ]: Setting ERROR=" << errorcount << std::endl;
   SETVERBOSITY(verbocount);
   SETTRACE(trace);
+  SETLOGBUFFER(Config::GetParB("LOGBUFFER"));
 
   // Make output file
   TFile *f = new TFile(gOptOutputFile.c_str(), "RECREATE");
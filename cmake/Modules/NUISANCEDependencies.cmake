@@ -19,6 +19,19 @@ endif()
 
 target_compile_options(GeneratorCompileDependencies INTERFACE -Wno-unused-function -Wno-unused-variable)
 
+# Most verbose NUIS_LOG level compiled in: 3 = SAM, 4 = REC, ..., 7 = DEB.
+# Release builds drop the per-reconfigure and debug output by default.
+if(NOT DEFINED NUISANCE_LOG_COMPILED_LEVEL)
+  string(TOUPPER "${CMAKE_BUILD_TYPE}" BUILD_TYPE_UPPER)
+  if(BUILD_TYPE_UPPER STREQUAL "RELEASE")
+    set(NUISANCE_LOG_COMPILED_LEVEL 3)
+  else()
+    set(NUISANCE_LOG_COMPILED_LEVEL 7)
+  endif()
+endif()
+cmessage(STATUS "Compiling in NUIS_LOG levels up to ${NUISANCE_LOG_COMPILED_LEVEL}")
+target_compile_definitions(GeneratorCompileDependencies INTERFACE NUIS_LOG_COMPILED_LEVEL=${NUISANCE_LOG_COMPILED_LEVEL})
+
 set(GiBUU_ENABLED TRUE)
 target_compile_definitions(GeneratorCompileDependencies INTERFACE GiBUU_ENABLED)
 
@@ -31,6 +44,22 @@ DefineEnabledRequiredSwitch(GENIE TRUE)
 DefineEnabledRequiredSwitch(NuWro TRUE)
 DefineEnabledRequiredSwitch(Prob3plusplus FALSE)
 DefineEnabledRequiredSwitch(NuHepMC FALSE)
+DefineEnabledRequiredSwitch(OpenMP FALSE)
+
+if (OpenMP_ENABLED)
+  find_package(OpenMP)
+
+  if(NOT OpenMP_CXX_FOUND)
+    if(OpenMP_REQUIRED)
+      cmessage(FATAL_ERROR "OpenMP was explicitly enabled but cannot be found.")
+    endif()
+    SET(OpenMP_ENABLED FALSE)
+  else()
+    SET(OpenMP_ENABLED TRUE)
+    target_compile_definitions(GeneratorCompileDependencies INTERFACE __USE_OPENMP__)
+    target_link_libraries(GeneratorCompileDependencies INTERFACE OpenMP::OpenMP_CXX)
+  endif()
+endif()
 
 if (T2KReWeight_ENABLED)
   include(T2KReWeight)
@@ -91,7 +91,6 @@ struct EffMap {
 };
 
 class CLASAccepter : public ISmearcepter {
-  TRandom3 rand;
   // Maps a particle PDG to the relevant generated and accepted histograms from
   // the input map.
   std::map<int, EffMap> Acceptance;
@@ -101,9 +100,6 @@ public:
   CLASAccepter() :  DefaultAccRatio(0) { ElementName = "CLASAccepter"; }
 
   void SpecifcSetup(nuiskey &nk) {
-    rand.~TRandom3();
-    new (&rand) TRandom3();
-
     InstanceName = nk.GetS("name");
     DefaultAccRatio = nk.GetD("DefaultAccRatio");
 
@@ -166,8 +162,10 @@ public:
     delete f;
   }
 
-  RecoInfo *Smearcept(FitEvent *fe) {
-    RecoInfo *ri = new RecoInfo();
+  using ISmearcepter::Smearcept;
+
+  void Smearcept(FitEvent *fe, RecoInfo *ri, TRandom3 *rng) {
+    ri->Reset();
 
     for (size_t p_it = 0; p_it < fe->NParticles(); ++p_it) {
       FitParticle *fp = fe->GetParticle(p_it);
@@ -199,11 +197,11 @@ public:
         continue;
       }
 
-      EffMap const &eff = Acceptance[PDG];
+      EffMap const &eff = Acceptance.find(PDG)->second;
 
       double acc_ratio = eff.GetAccRatio(p, cost, phi, DefaultAccRatio);
 
-      bool accepted = (rand.Uniform() < acc_ratio);
+      bool accepted = (rng->Uniform() < acc_ratio);
       if (accepted) {
 #ifdef DEBUG_CLASACCEPT
         std::cout << "(" << p << ", " << cost << ", " << phi << ")."
@@ -231,7 +229,6 @@ public:
                 << std::endl;
     }
 #endif
-    return ri;
   }
 
   double GetEfficiency(FitEvent *fe) {
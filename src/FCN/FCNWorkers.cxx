@@ -0,0 +1,354 @@
+#include "FCNWorkers.h"
+
+#include "FitLogger.h"
+
+#include "TFile.h"
+#include "TROOT.h"
+#include "TUrl.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdint.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+struct MessageHeader {
+  int32_t Type;
+  int32_t Pad;
+  uint64_t Count;
+};
+
+// A 64 bit key does not fit in one double, so it is sent as two halves
+std::vector<double> EncodeKey(uint64_t key) {
+  std::vector<double> payload(2);
+  payload[0] = double(key >> 32);
+  payload[1] = double(key & 0xffffffffULL);
+  return payload;
+}
+
+bool SendAll(int fd, const char *buf, size_t len) {
+  while (len) {
+    ssize_t n = send(fd, buf, len, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    buf += n;
+    len -= n;
+  }
+  return true;
+}
+
+bool ReceiveAll(int fd, char *buf, size_t len) {
+  while (len) {
+    ssize_t n = recv(fd, buf, len, 0);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    buf += n;
+    len -= n;
+  }
+  return true;
+}
+
+// Workers exchange many small messages, don't wait to batch them.
+void SetNoDelay(int fd) {
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+// Bound how long a blocking receive can wait, 0 waits forever.
+void SetReceiveTimeout(int fd, int seconds) {
+  struct timeval tv;
+  tv.tv_sec = seconds;
+  tv.tv_usec = 0;
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+}
+
+} // namespace
+
+namespace FCNWorkers {
+
+bool Send(int fd, int type, std::vector<double> const &payload) {
+  MessageHeader head;
+  head.Type = type;
+  head.Pad = 0;
+  head.Count = payload.size();
+  return SendAll(fd, (const char *)&head, sizeof(head)) &&
+         (payload.empty() ||
+          SendAll(fd, (const char *)&payload[0],
+                  payload.size() * sizeof(double)));
+}
+
+bool Receive(int fd, int &type, std::vector<double> &payload,
+             uint64_t maxcount) {
+  MessageHeader head;
+  if (!ReceiveAll(fd, (char *)&head, sizeof(head))) {
+    return false;
+  }
+  if (head.Count > maxcount) {
+    return false;
+  }
+  type = head.Type;
+  payload.resize(head.Count);
+  return payload.empty() ||
+         ReceiveAll(fd, (char *)&payload[0], payload.size() * sizeof(double));
+}
+
+uint64_t Hash(std::string const &text) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < text.size(); i++) {
+    hash = (hash ^ (unsigned char)text[i]) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+int ConnectToMaster(std::string const &hostport, int timeout, uint64_t key) {
+  size_t colon = hostport.rfind(':');
+  if (colon == std::string::npos) {
+    NUIS_ABORT("DistributedMaster should be host:port, not " << hostport);
+  }
+  std::string host = hostport.substr(0, colon);
+  std::string port = hostport.substr(colon + 1);
+
+  NUIS_LOG(FIT, "Connecting to FCN master at " << hostport);
+  for (int attempt = 0; attempt <= timeout; attempt++) {
+    if (attempt) {
+      sleep(1);
+    }
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo *addrs = NULL;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addrs) != 0) {
+      continue;
+    }
+
+    for (struct addrinfo *a = addrs; a; a = a->ai_next) {
+      int fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+      if (fd < 0) {
+        continue;
+      }
+      if (connect(fd, a->ai_addr, a->ai_addrlen) == 0) {
+        freeaddrinfo(addrs);
+        SetNoDelay(fd);
+        if (!Send(fd, kFCNWorkerHello, EncodeKey(key))) {
+          NUIS_ABORT("Lost the FCN master at " << hostport << " during setup");
+        }
+        return fd;
+      }
+      close(fd);
+    }
+    freeaddrinfo(addrs);
+  }
+
+  NUIS_ABORT("Could not connect to FCN master at " << hostport << " within "
+                                                   << timeout << "s");
+  return -1;
+}
+
+void ReopenROOTFiles() {
+  TIter next(gROOT->GetListOfFiles());
+  while (TObject *obj = next()) {
+    TFile *file = dynamic_cast<TFile *>(obj);
+    if (!file || file->GetFd() < 0 || file->IsWritable()) {
+      continue;
+    }
+
+    std::string path = file->GetEndpointUrl()->GetFile();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0 || dup2(fd, file->GetFd()) < 0) {
+      NUIS_ABORT("Worker could not reopen " << path << ": "
+                                            << strerror(errno));
+    }
+    close(fd);
+  }
+}
+
+void Exit(int fd) {
+  close(fd);
+  LOGFLUSH();
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(NULL);
+  _exit(0);
+}
+
+} // namespace FCNWorkers
+
+FCNWorkerPool::FCNWorkerPool() {}
+
+FCNWorkerPool::~FCNWorkerPool() { Stop(); }
+
+int FCNWorkerPool::ForkLocal(int nlocal, int &slice) {
+  if (nlocal <= 0) {
+    return -1;
+  }
+
+  NUIS_LOG(FIT, "Forking " << nlocal << " local FCN workers.");
+
+  // Anything still buffered would otherwise be printed by every worker.
+  LOGFLUSH();
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(NULL);
+
+  for (int c = 0; c < nlocal; c++) {
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+      NUIS_ABORT("Could not create a socket pair for worker " << c);
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+      NUIS_ABORT("Failed to fork FCN worker " << c);
+    } else if (pid == 0) {
+      close(sv[0]);
+      for (size_t i = 0; i < fSockets.size(); i++) {
+        close(fSockets[i]);
+      }
+      fSockets.clear();
+      fPIDs.clear();
+      FCNWorkers::ReopenROOTFiles();
+      slice = c;
+      return sv[1];
+    }
+
+    close(sv[1]);
+    fSockets.push_back(sv[0]);
+    fPIDs.push_back(pid);
+  }
+  return -1;
+}
+
+void FCNWorkerPool::AcceptRemote(std::string const &bindaddr, int port,
+                                 int nremote, int firstslice, int nslices,
+                                 int timeout, uint64_t key) {
+  if (nremote <= 0) {
+    return;
+  }
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  if (inet_pton(AF_INET, bindaddr.c_str(), &addr.sin_addr) != 1) {
+    NUIS_ABORT("DistributedBindAddress should be an IPv4 address, not "
+               << bindaddr);
+  }
+
+  int listenfd = socket(AF_INET, SOCK_STREAM, 0);
+  int one = 1;
+  setsockopt(listenfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  if (listenfd < 0 || bind(listenfd, (struct sockaddr *)&addr, sizeof(addr)) ||
+      listen(listenfd, nremote)) {
+    NUIS_ABORT("Could not listen for FCN workers on " << bindaddr << ":"
+                                                      << port << ": "
+                                                      << strerror(errno));
+  }
+
+  NUIS_LOG(FIT, "Waiting for " << nremote << " remote FCN workers on "
+                               << bindaddr << ":" << port);
+  std::vector<double> const expected = EncodeKey(key);
+  for (int r = 0; r < nremote;) {
+    struct pollfd pfd;
+    pfd.fd = listenfd;
+    pfd.events = POLLIN;
+    int fd = -1;
+    if (poll(&pfd, 1, timeout * 1000) > 0) {
+      fd = accept(listenfd, NULL, NULL);
+    }
+    if (fd < 0) {
+      NUIS_ABORT("Only " << r << " of " << nremote
+                         << " remote FCN workers connected within "
+                         << timeout << "s");
+    }
+    SetNoDelay(fd);
+
+    // Only hand slices to workers set up exactly as this process. Nothing
+    // is trusted yet, so the hello can not ask for a big buffer or stall
+    // the master half way through a message.
+    SetReceiveTimeout(fd, timeout);
+    int type = 0;
+    std::vector<double> hello;
+    if (!FCNWorkers::Receive(fd, type, hello, expected.size()) ||
+        type != kFCNWorkerHello || hello != expected) {
+      NUIS_ERR(WRN, "Dropped a connection on port "
+                        << port
+                        << " that is not an FCN worker with the same card, "
+                           "build and inputs.");
+      close(fd);
+      continue;
+    }
+    // Fills can legitimately take longer than the connection timeout
+    SetReceiveTimeout(fd, 0);
+
+    std::vector<double> assign(2);
+    assign[0] = firstslice + r;
+    assign[1] = nslices;
+    if (!FCNWorkers::Send(fd, kFCNWorkerAssign, assign)) {
+      NUIS_ABORT("Lost remote FCN worker " << r << " during setup");
+    }
+    fSockets.push_back(fd);
+    fPIDs.push_back(0);
+    NUIS_LOG(FIT, "Remote FCN worker " << r + 1 << "/" << nremote
+                                       << " connected.");
+    r++;
+  }
+  close(listenfd);
+}
+
+void FCNWorkerPool::Broadcast(int type, std::vector<double> const &payload) {
+  for (size_t i = 0; i < fSockets.size(); i++) {
+    if (!FCNWorkers::Send(fSockets[i], type, payload)) {
+      NUIS_ABORT("Lost FCN worker " << i);
+    }
+  }
+}
+
+void FCNWorkerPool::Gather(int type,
+                           std::vector<std::vector<double> > &payloads) {
+  payloads.resize(fSockets.size());
+  for (size_t i = 0; i < fSockets.size(); i++) {
+    int got = 0;
+    if (!FCNWorkers::Receive(fSockets[i], got, payloads[i]) || got != type) {
+      NUIS_ABORT("Lost FCN worker " << i << " while waiting for its results");
+    }
+  }
+}
+
+void FCNWorkerPool::Stop() {
+  std::vector<double> none;
+  for (size_t i = 0; i < fSockets.size(); i++) {
+    FCNWorkers::Send(fSockets[i], kFCNWorkerStop, none);
+    close(fSockets[i]);
+  }
+  for (size_t i = 0; i < fPIDs.size(); i++) {
+    if (fPIDs[i] > 0) {
+      int status = 0;
+      waitpid(fPIDs[i], &status, 0);
+    }
+  }
+  fSockets.clear();
+  fPIDs.clear();
+}
@@ -0,0 +1,101 @@
+#ifndef _FCN_WORKERS_H_
+#define _FCN_WORKERS_H_
+/*!
+ *  \addtogroup FCN
+ *  @{
+ */
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <string>
+#include <vector>
+
+//! Messages between a JointFCN master and its workers. Every message is a
+//! type, a count and that many doubles, in the byte order of the machine
+//! that sent it, so all nodes in a fit must share an architecture.
+enum FCNWorkerMessage {
+  kFCNWorkerAssign = 1, //!< master -> remote worker: slice, nslices
+  kFCNWorkerReconfigure, //!< master -> worker: full flag, dial values
+  kFCNWorkerFills,       //!< worker -> master: packed histogram fills
+  kFCNWorkerStop,        //!< master -> worker: exit
+  kFCNWorkerToyFits,     //!< toy fit worker -> master: fit results
+  kFCNWorkerScanPoints,  //!< scan worker -> master: point likelihoods
+  kFCNWorkerHello        //!< remote worker -> master: setup key hash
+};
+
+//! Master side connections to the worker processes that each fill one slice
+//! of every input's entries.
+//!
+//! Local workers are forked and talk over Unix socket pairs. Remote workers
+//! are separate nuisance processes, possibly on other nodes, that connect
+//! over TCP with FCNWorkers::ConnectToMaster.
+class FCNWorkerPool {
+public:
+  FCNWorkerPool();
+
+  //! Stops any workers still connected.
+  ~FCNWorkerPool();
+
+  //! Fork nlocal workers and give them slices 0 to nlocal-1. Returns -1 in
+  //! the master. In each worker it returns the socket to the master, with
+  //! slice set, and the pool emptied.
+  int ForkLocal(int nlocal, int &slice);
+
+  //! Wait up to timeout seconds for each of nremote workers to connect on
+  //! bindaddr:port, and assign them slices firstslice onwards of nslices.
+  //! Connections whose hello does not carry key, i.e. from processes with a
+  //! different card, build or inputs, are dropped without a slice.
+  void AcceptRemote(std::string const &bindaddr, int port, int nremote,
+                    int firstslice, int nslices, int timeout, uint64_t key);
+
+  //! Send the same message to every worker.
+  void Broadcast(int type, std::vector<double> const &payload);
+
+  //! Read one message of the given type from every worker, in slice order.
+  void Gather(int type, std::vector<std::vector<double> > &payloads);
+
+  //! Tell every worker to exit and reap the local ones.
+  void Stop();
+
+  inline size_t GetNWorkers() const { return fSockets.size(); };
+
+private:
+  std::vector<int> fSockets;
+  std::vector<pid_t> fPIDs; //!< 0 for remote workers
+};
+
+//! Transport helpers shared by both ends of an FCNWorkerPool.
+namespace FCNWorkers {
+
+//! Write a whole message, false if the peer has gone.
+bool Send(int fd, int type, std::vector<double> const &payload);
+
+//! Largest payload, in doubles, accepted from a peer by default.
+const uint64_t kFCNWorkerMaxPayload = uint64_t(1) << 27;
+
+//! Read a whole message, false on EOF, error or a payload longer than
+//! maxcount, which is rejected before anything is allocated for it.
+bool Receive(int fd, int &type, std::vector<double> &payload,
+             uint64_t maxcount = kFCNWorkerMaxPayload);
+
+//! Connect to a master listening at "host:port", retrying for up to timeout
+//! seconds while it starts up, and introduce this worker with key.
+int ConnectToMaster(std::string const &hostport, int timeout, uint64_t key);
+
+//! FNV-1a hash of a string.
+uint64_t Hash(std::string const &text);
+
+//! Give a forked process its own file offsets for every ROOT file opened
+//! for reading, so it does not move the parent's position under it.
+void ReopenROOTFiles();
+
+//! Close the connection to the master, flush all output and leave the
+//! process, skipping the atexit handlers and static destructors that belong
+//! to the master.
+void Exit(int fd);
+
+} // namespace FCNWorkers
+
+/*! @} */
+#endif
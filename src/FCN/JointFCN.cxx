@@ -1,6 +1,63 @@
 #include "JointFCN.h"
+#include "FCNWorkers.h"
 #include "FitUtils.h"
+#include "InputUtils.h"
+#include "MemoryUtils.h"
+#include "SplineReader.h"
+#include "TFile.h"
+#include "TimingUtils.h"
+#include "TArray.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
 #include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifndef NUISANCE_BUILD_VERSION
+#define NUISANCE_BUILD_VERSION "unknown"
+#endif
+
+namespace {
+// Bump kSignalCacheFormat whenever the signal cache layout changes
+const char kSignalCacheMagic[8] = {'N', 'U', 'I', 'S', 'S', 'I', 'G', 'C'};
+const int kSignalCacheFormat = 2;
+
+// Global settings that change which events are read, how they are built,
+// the signal definitions or the event weights, so a cache made with
+// different values can not be reused.
+const char *const kSignalCacheConfig[] = {
+    "MAXEVENTS",
+    "NSKIPEVENTS",
+    "RemoveFSIParticles",
+    "RemoveNuclearParticles",
+    "RemoveUndefParticles",
+    "Modes_split_PN_NN",
+    "NEUT_CARD",
+    "GENIEWeightEngine_CCQEMode",
+    "GENIEWeightEngine_CCRESMode",
+    "GENIEXSecModelCCQE",
+    "GENIEXSecModelCCRES",
+    "GENIEXSecModelCOH",
+    "FitWeight_fGenieRW_veto",
+    "FitWeight_fNeutRW_veto",
+    "FitWeight_fNIWGRW_veto",
+    "Gaussian_Enhancement",
+    "SciBooNEScale",
+    "SciBarRecoDist",
+    "SciBarDensity",
+    "PenetratingMuonEnergy",
+    "NumRangeSteps",
+    "UseProton",
+    "UseZackEff",
+    "FlatEfficiency",
+    "MINERvARecoDist",
+    "MINERvADensity",
+    "MINERvA_CCinc_XSec_2DEavq3_nu_hadron_cut",
+    "MINERvA_CCinc_XSec_2DEavq3_nu_useq3true",
+};
+} // namespace
 
 //***************************************************
 JointFCN::JointFCN(TFile *outfile) {
@@ -24,7 +81,23 @@ JointFCN::JointFCN(TFile *outfile) {
   fNDials = 0;
 
   fUsingEventManager = FitPar::Config().GetParB("EventManager");
+  fSignalEntriesDisabled = false;
+  fSignalCacheDisabled = false;
+  fEventStoreDisabled = false;
+  fEventWeightsValid = false;
+  fEvalCacheSize = std::max(0, FitPar::Config().GetParI("EvalCacheSize"));
+  fEvalCacheHits = 0;
+  fEvalCacheMisses = 0;
+  fEvalCacheRWCount = 0;
+  fSignalCacheStored = false;
+  fWorkers = NULL;
+  fWorkersStarted = false;
+  fCheckWorkers = FitPar::Config().GetParB("DistributedCheck");
+  fSlice = 0;
+  fNSlices = 1;
   fOutputDir->cd();
+
+  ReportMemory("sample setup");
 }
 
 //***************************************************
@@ -47,7 +120,23 @@ JointFCN::JointFCN(std::vector<nuiskey> samplekeys, TFile *outfile) {
   fNDials = 0;
 
   fUsingEventManager = FitPar::Config().GetParB("EventManager");
+  fSignalEntriesDisabled = false;
+  fSignalCacheDisabled = false;
+  fEventStoreDisabled = false;
+  fEventWeightsValid = false;
+  fEvalCacheSize = std::max(0, FitPar::Config().GetParI("EvalCacheSize"));
+  fEvalCacheHits = 0;
+  fEvalCacheMisses = 0;
+  fEvalCacheRWCount = 0;
+  fSignalCacheStored = false;
+  fWorkers = NULL;
+  fWorkersStarted = false;
+  fCheckWorkers = FitPar::Config().GetParB("DistributedCheck");
+  fSlice = 0;
+  fNSlices = 1;
   fOutputDir->cd();
+
+  ReportMemory("sample setup");
 }
 
 //***************************************************
@@ -66,6 +155,10 @@ JointFCN::~JointFCN() {
     delete pull;
   }
 
+  // Stop workers
+  if (fWorkers)
+    delete fWorkers;
+
   // Sort Tree
   if (fIterationTree)
     DestroyIterationTree();
@@ -199,8 +292,10 @@ void JointFCN::FillIterationTree(FitWeight *rw) {
   fCurrentValues[count++] = fLikelihood;
   fCurrentValues[count++] = double(fNDOF);
 
-  // Loop Over Parameter Counts
-  rw->GetAllDials(fDialVals, fNDials);
+  // Loop Over Parameter Counts, cached evaluations have already set fDialVals
+  if (rw) {
+    rw->GetAllDials(fDialVals, fNDials);
+  }
   for (int i = 0; i < fNDials; i++) {
     fCurrentValues[count++] = double(fDialVals[i]);
   }
@@ -211,33 +306,209 @@ void JointFCN::FillIterationTree(FitWeight *rw) {
 }
 
 //***************************************************
-double JointFCN::DoEval(const double *x) {
+double JointFCN::GetParValue(const double *x, int i, bool *mirrored) {
   //***************************************************
 
-  double *par_vals = new double[fNPars];
+  if (mirrored) {
+    *mirrored = false;
+  }
+  if (!fMirroredParams.count(i)) {
+    return x[i];
+  }
 
-  for (int i = 0; i < fNPars; ++i) {
-    if (fMirroredParams.count(i)) {
-      if (!fMirroredParams[i].mirror_above &&
-          (x[i] < fMirroredParams[i].mirror_value)) {
-        double xabove = fMirroredParams[i].mirror_value - x[i];
-        par_vals[i] = fMirroredParams[i].mirror_value + xabove;
-        std::cout << "\t--Parameter " << i << " mirrored from " << x[i]
-                  << " -> " << par_vals[i] << std::endl;
-      } else if (fMirroredParams[i].mirror_above &&
-                 (x[i] >= fMirroredParams[i].mirror_value)) {
-        double xabove = x[i] - fMirroredParams[i].mirror_value;
-        par_vals[i] = fMirroredParams[i].mirror_value - xabove;
-        std::cout << "\t--Parameter " << i << " mirrored from " << x[i]
-                  << " -> " << par_vals[i] << std::endl;
+  double par_val = x[i];
+  if (!fMirroredParams[i].mirror_above &&
+      (x[i] < fMirroredParams[i].mirror_value)) {
+    double xabove = fMirroredParams[i].mirror_value - x[i];
+    par_val = fMirroredParams[i].mirror_value + xabove;
+  } else if (fMirroredParams[i].mirror_above &&
+             (x[i] >= fMirroredParams[i].mirror_value)) {
+    double xabove = x[i] - fMirroredParams[i].mirror_value;
+    par_val = fMirroredParams[i].mirror_value - xabove;
+  } else {
+    return par_val;
+  }
+
+  if (mirrored) {
+    *mirrored = true;
+  } else {
+    std::cout << "\t--Parameter " << i << " mirrored from " << x[i] << " -> "
+              << par_val << std::endl;
+  }
+  return par_val;
+}
+
+//***************************************************
+double JointFCN::DoEval(const double *x) {
+  //***************************************************
+
+  // Minimizers regularly come back to points they have already evaluated
+  std::string key;
+  if (fEvalCacheSize) {
+    // Anything but Evaluate touching the dials or engines, e.g. fixing a dial
+    // or setting an engine directly, changes the likelihood at every x.
+    if (FitBase::GetRW()->GetChangeCount() != fEvalCacheRWCount) {
+      ClearEvalCache();
+    }
+    key.assign((const char *)x, fNPars * sizeof(double));
+
+    std::map<std::string, EvalCacheList::iterator>::iterator it =
+        fEvalCacheIndex.find(key);
+    if (it != fEvalCacheIndex.end() &&
+        (!fIterationTree ||
+         it->second->second.Dials.size() == (UInt_t)fNDials)) {
+      fEvalCache.splice(fEvalCache.begin(), fEvalCache, it->second);
+      EvalCacheEntry const &entry = fEvalCache.front().second;
+      fEvalCacheHits++;
+
+      fLikelihood = entry.Likelihood;
+      fNDOF = entry.NDOF;
+      fCurrentLikes = entry.Likes;
+      fCurrentNDOFs = entry.NDOFs;
+      if (fLastEvalX.size() != (UInt_t)fNPars ||
+          !std::equal(fLastEvalX.begin(), fLastEvalX.end(), x)) {
+        fPendingX.assign(x, x + fNPars);
+        fPendingDials.resize(FitBase::GetRW()->GetDialEnums().size());
+        if (!fPendingDials.empty()) {
+          FitBase::GetRW()->GetAllDials(&fPendingDials[0],
+                                        fPendingDials.size());
+        }
       } else {
-        par_vals[i] = x[i];
+        fPendingX.clear();
       }
-    } else {
-      par_vals[i] = x[i];
+
+      NUIS_LOG(FIT, "Current Stat (iter. " << this->fCurIter
+                                           << ", cached) = " << fLikelihood);
+
+      if (fIterationTree) {
+        for (int i = 0; i < fSampleN && i < (int)entry.Likes.size(); i++) {
+          fSampleLikes[i] = entry.Likes[i];
+          fSampleNDOF[i] = entry.NDOFs[i];
+        }
+        std::copy(entry.Dials.begin(), entry.Dials.end(), fDialVals);
+        FillIterationTree(NULL);
+      }
+      return fLikelihood;
+    }
+    fEvalCacheMisses++;
+  }
+
+  Evaluate(x);
+
+  // UPDATE TREE
+  if (fIterationTree)
+    FillIterationTree(FitBase::GetRW());
+
+  if (fEvalCacheSize) {
+    if (fEvalCacheIndex.count(key)) {
+      fEvalCache.erase(fEvalCacheIndex[key]);
+      fEvalCacheIndex.erase(key);
+    }
+
+    fEvalCache.push_front(std::make_pair(key, EvalCacheEntry()));
+    EvalCacheEntry &entry = fEvalCache.front().second;
+    entry.Likelihood = fLikelihood;
+    entry.NDOF = fNDOF;
+    entry.Likes = fCurrentLikes;
+    entry.NDOFs = fCurrentNDOFs;
+    if (fIterationTree) {
+      entry.Dials.assign(fDialVals, fDialVals + fNDials);
+    }
+    fEvalCacheIndex[key] = fEvalCache.begin();
+
+    if (fEvalCache.size() > fEvalCacheSize) {
+      fEvalCacheIndex.erase(fEvalCache.back().first);
+      fEvalCache.pop_back();
+    }
+  }
+
+  return fLikelihood;
+}
+
+//***************************************************
+void JointFCN::DoEvalPoints(std::vector<double> const &x,
+                            std::vector<double> &likes) {
+  //***************************************************
+
+  int npoints = x.size() / fNPars;
+  likes.assign(npoints, 0.0);
+  if (!npoints) {
+    return;
+  }
+
+  // The first point also fills the caches the workers share
+  likes[0] = DoEval(&x[0]);
+
+  int nworkers = std::min(FitPar::Config().GetParI("ScanWorkers"), npoints - 2);
+  if (nworkers <= 1 || UseWorkers()) {
+    for (int p = 1; p < npoints; p++) {
+      likes[p] = DoEval(&x[p * fNPars]);
+    }
+    return;
+  }
+
+  NUIS_LOG(FIT, "Evaluating " << npoints << " scan points in " << nworkers
+                              << " processes.");
+  FCNWorkerPool pool;
+  int slice = 0;
+  int fd = pool.ForkLocal(nworkers, slice);
+  if (fd >= 0) {
+    ReopenInputs();
+    SETVERBOSITY(QUIET);
+
+    // Each point is index, likelihood, reconfigures and its iteration row
+    std::vector<double> results;
+    for (int p = 1 + slice; p < npoints - 1; p += nworkers) {
+      int iter = fCurIter;
+      results.push_back(p);
+      results.push_back(DoEval(&x[p * fNPars]));
+      results.push_back(fCurIter - iter);
+      if (fIterationTree) {
+        results.insert(results.end(), fIterationValues.back().begin(),
+                       fIterationValues.back().end());
+      }
+    }
+    FCNWorkers::Send(fd, kFCNWorkerScanPoints, results);
+    FCNWorkers::Exit(fd);
+  }
+
+  std::vector<std::vector<double> > results;
+  pool.Gather(kFCNWorkerScanPoints, results);
+  pool.Stop();
+
+  size_t width = 3 + (fIterationTree ? fCurrentValues.size() : 0);
+  std::vector<double const *> rows(npoints, (double const *)NULL);
+  for (size_t w = 0; w < results.size(); w++) {
+    for (size_t r = 0; r + width <= results[w].size(); r += width) {
+      rows[int(results[w][r])] = &results[w][r];
+    }
+  }
+
+  for (int p = 1; p < npoints - 1; p++) {
+    likes[p] = rows[p][1];
+    fCurIter += int(rows[p][2]);
+    if (fIterationTree) {
+      fIterationCount.push_back(fCurIter);
+      fIterationValues.push_back(
+          std::vector<double>(rows[p] + 3, rows[p] + width));
     }
   }
 
+  // Leave the samples at the last point
+  likes[npoints - 1] = DoEval(&x[(npoints - 1) * fNPars]);
+}
+
+//***************************************************
+double JointFCN::Evaluate(const double *x) {
+  //***************************************************
+
+  fPendingX.clear();
+  double *par_vals = new double[fNPars];
+
+  for (int i = 0; i < fNPars; ++i) {
+    par_vals[i] = GetParValue(x, i);
+  }
+
   // WEIGHT ENGINE
   fDialChanged = FitBase::GetRW()->HasRWDialChanged(par_vals);
   FitBase::GetRW()->UpdateWeightEngine(par_vals);
@@ -251,30 +522,432 @@ double JointFCN::DoEval(const double *x) {
 
   // SORT SAMPLES
   ReconfigureSamples();
+  fLastEvalX.assign(x, x + fNPars);
 
   // GET TEST STAT
   fLikelihood = GetLikelihood();
   fNDOF = GetNDOF();
+  fEvalCacheRWCount = FitBase::GetRW()->GetChangeCount();
 
   // PRINT PROGRESS
   NUIS_LOG(FIT,
            "Current Stat (iter. " << this->fCurIter << ") = " << fLikelihood);
 
-  // UPDATE TREE
-  if (fIterationTree)
-    FillIterationTree(FitBase::GetRW());
-
   delete[] par_vals;
 
   return fLikelihood;
 }
 
+//***************************************************
+void JointFCN::SyncSamples() {
+  //***************************************************
+
+  if (fPendingX.empty()) {
+    return;
+  }
+
+  std::vector<double> x;
+  x.swap(fPendingX);
+  Evaluate(&x[0]);
+}
+
+//***************************************************
+void JointFCN::ClearEvalCache() {
+  //***************************************************
+
+  fEvalCache.clear();
+  fEvalCacheIndex.clear();
+}
+
+//***************************************************
+void JointFCN::PrintEvalCacheStats() {
+  //***************************************************
+
+  long ncalls = fEvalCacheHits + fEvalCacheMisses;
+  if (!ncalls) {
+    return;
+  }
+  NUIS_LOG(FIT, "FCN evaluation cache: " << fEvalCacheHits << " hits from "
+                                         << ncalls << " calls ("
+                                         << 100.0 * fEvalCacheHits / ncalls
+                                         << "%), " << fEvalCache.size()
+                                         << " points held.");
+}
+
+//***************************************************
+bool JointFCN::HasAnalyticGradient() {
+  //***************************************************
+
+  // Distributed masters hold no signal cache
+  if (!fUsingEventManager || fSignalCacheDisabled ||
+      !FitPar::Config().GetParB("SignalReconfigures") || UseWorkers()) {
+    return false;
+  }
+
+  if (fInputList.empty()) {
+    fInputList = GetInputList();
+    fSubSampleList = GetSubSampleList();
+  }
+  return fIsAllSplines;
+}
+
+//***************************************************
+double JointFCN::FiniteDifference(const double *x, int i, double step) {
+  //***************************************************
+
+  std::vector<double> xstep(x, x + fNPars);
+
+  xstep[i] = x[i] - step;
+  double likelow = DoEval(&xstep[0]);
+
+  xstep[i] = x[i] + step;
+  double likehigh = DoEval(&xstep[0]);
+
+  return (likehigh - likelow) / (2.0 * step);
+}
+
+//***************************************************
+double JointFCN::DoDerivative(const double *x, unsigned int icoord) {
+  //***************************************************
+
+  if (fGradientX.size() != (UInt_t)fNPars ||
+      !std::equal(fGradientX.begin(), fGradientX.end(), x)) {
+    fGradient.resize(fNPars);
+    Gradient(x, &fGradient[0]);
+  }
+  return fGradient[icoord];
+}
+
+//***************************************************
+void JointFCN::Gradient(const double *x, double *grad) {
+  //***************************************************
+
+  double step = FitPar::Config().GetParD("AnalyticGradientStep");
+
+  // Make sure the samples and signal event weights are at x
+  if (fLastEvalX.size() != (UInt_t)fNPars ||
+      !std::equal(fLastEvalX.begin(), fLastEvalX.end(), x)) {
+    Evaluate(x);
+  }
+
+  bool analytic = HasAnalyticGradient() && fEventWeightsValid &&
+                  !fSignalSplines.empty();
+
+  FitWeight *rw = FitBase::GetRW();
+  std::vector<int> dialenums = rw->GetDialEnums();
+  std::vector<std::string> dialnames = rw->GetDialNames();
+
+  // Spline dials take their derivatives from the spline coefficients,
+  // everything else (e.g. normalisations) is finite differenced.
+  std::vector<bool> isspline(fNPars, false);
+  std::map<std::string, std::vector<int> > splinepars;
+  for (int i = 0; i < fNPars && i < (int)dialenums.size(); i++) {
+    if (!analytic ||
+        Reweight::GetDialType(dialenums[i]) != kSPLINEPARAMETER) {
+      continue;
+    }
+    isspline[i] = true;
+    std::vector<std::string> singlenames =
+        GeneralUtils::ParseToStr(dialnames[i], ",");
+    for (size_t j = 0; j < singlenames.size(); j++) {
+      splinepars[singlenames[j]].push_back(i);
+    }
+  }
+
+  for (int i = 0; i < fNPars; i++) {
+    grad[i] = 0.0;
+  }
+
+  if (!splinepars.empty()) {
+    // Sparse d(weight)/d(par) for every signal event, from one pass over the
+    // cached spline coefficients.
+    std::vector<std::vector<UInt_t> > gradevents(fNPars);
+    std::vector<std::vector<double> > gradvalues(fNPars);
+
+    std::vector<double> perpar(fNPars, 0.0);
+    std::vector<int> touched;
+    size_t sigcount = 0;
+    size_t splinecount = 0;
+
+    for (size_t iinput = 0; iinput < fInputList.size(); iinput++) {
+      InputHandlerBase *curinput = fInputList[iinput];
+      SplineReader *reader = curinput->FirstBaseEvent()->fSplineRead;
+      int nevents = curinput->GetNEvents();
+
+      if (!reader) {
+        for (int i = 0; i < nevents; i++) {
+          if (fSignalEventFlags[sigcount++]) {
+            splinecount++;
+          }
+        }
+        continue;
+      }
+
+      // Which parameters each spline dimension responds to
+      std::vector<std::string> dimnames = reader->GetDimNames();
+      std::vector<std::vector<int> > dimpars(dimnames.size());
+      for (size_t d = 0; d < dimnames.size(); d++) {
+        if (splinepars.count(dimnames[d])) {
+          dimpars[d] = splinepars[dimnames[d]];
+        }
+      }
+      std::vector<double> dwdx(dimnames.size() + 1);
+      std::vector<float> coeffs(reader->GetNPar());
+
+      for (int i = 0; i < nevents; i++) {
+        if (!fSignalEventFlags[sigcount++]) {
+          continue;
+        }
+
+        reader->UnpackCoefficients(fSignalSplines.GetMask(splinecount),
+                                   fSignalSplines.GetCoeffs(splinecount),
+                                   &coeffs[0]);
+        double splweight = reader->CalcWeightGradient(&coeffs[0], &dwdx[0]);
+
+        // The other factors of the event weight can only be recovered by
+        // dividing out the spline weight. Where that is zero the spline is
+        // clamped at its floor, so the event does not move with the dials.
+        if (splweight == 0.0) {
+          splinecount++;
+          continue;
+        }
+
+        // Every other factor in the event weight is constant
+        double scale = fEventWeights[splinecount] / splweight;
+
+        for (size_t d = 0; d < dimpars.size(); d++) {
+          if (dwdx[d] == 0.0) {
+            continue;
+          }
+          for (size_t k = 0; k < dimpars[d].size(); k++) {
+            int ipar = dimpars[d][k];
+            if (perpar[ipar] == 0.0) {
+              touched.push_back(ipar);
+            }
+            perpar[ipar] += scale * dwdx[d];
+          }
+        }
+
+        for (size_t k = 0; k < touched.size(); k++) {
+          int ipar = touched[k];
+          if (perpar[ipar] != 0.0) {
+            gradevents[ipar].push_back(splinecount);
+            gradvalues[ipar].push_back(perpar[ipar]);
+          }
+          perpar[ipar] = 0.0;
+        }
+        touched.clear();
+
+        splinecount++;
+      }
+    }
+
+    // The sub samples making up each sample
+    std::vector<std::vector<size_t> > samplesubs;
+    std::vector<MeasurementBase *> samples;
+    size_t isub = 0;
+    for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
+         iter++) {
+      samples.push_back(*iter);
+      samplesubs.push_back(std::vector<size_t>());
+      size_t nsubs = (*iter)->GetSubSamples().size();
+      for (size_t j = 0; j < nsubs; j++) {
+        samplesubs.back().push_back(isub++);
+      }
+    }
+
+    // Each sample likelihood only depends on the weights of its own signal
+    // events, so only samples containing an event that responds to a dial
+    // are refilled, with the weights stepped along that dial's derivative.
+    //
+    // Where a sample gives dlike/dMC at x, the gradient is that contracted
+    // with dMC/dpar from a single refill, one pass per dial. Other samples
+    // take a central difference of their likelihood, two passes per dial,
+    // which is only exact when the likelihood is quadratic in the MC.
+    std::vector<double> weights(fEventWeights);
+    std::vector<bool> dirty(samples.size(), false);
+    std::vector<bool> subaffected(fSubSampleList.size());
+
+    std::vector<bool> contract(samples.size(), false);
+    std::vector<std::vector<double> > samplemc(samples.size());
+    std::vector<std::vector<double> > sampledlike(samples.size());
+    for (size_t isam = 0; isam < samples.size(); isam++) {
+      contract[isam] = samples[isam]->GetLikelihoodMCGradient(
+          samplemc[isam], sampledlike[isam]);
+    }
+    std::vector<double> mcstep;
+    int ncontracted = 0;
+    int nstepped = 0;
+
+    for (int ipar = 0; ipar < fNPars; ipar++) {
+      std::vector<UInt_t> const &events = gradevents[ipar];
+      std::vector<double> const &values = gradvalues[ipar];
+      if (events.empty()) {
+        continue;
+      }
+
+      subaffected.assign(fSubSampleList.size(), false);
+      for (size_t e = 0; e < events.size(); e++) {
+        for (size_t j = 0; j < fSubSampleList.size(); j++) {
+          if (fSignalCache.IsSignal(events[e], j)) {
+            subaffected[j] = true;
+          }
+        }
+      }
+
+      for (size_t isam = 0; isam < samples.size(); isam++) {
+        bool affected = false;
+        for (size_t j = 0; j < samplesubs[isam].size(); j++) {
+          affected = affected || subaffected[samplesubs[isam][j]];
+        }
+        if (!affected) {
+          continue;
+        }
+
+        MeasurementBase *exp = samples[isam];
+        dirty[isam] = true;
+
+        if (contract[isam]) {
+          for (size_t e = 0; e < events.size(); e++) {
+            weights[events[e]] = fEventWeights[events[e]] + step * values[e];
+          }
+
+          exp->ResetAll();
+          for (size_t j = 0; j < samplesubs[isam].size(); j++) {
+            size_t sub = samplesubs[isam][j];
+            fSignalCache.Replay(sub, fSubSampleList[sub], &weights[0]);
+          }
+          exp->ConvertEventRates();
+          exp->GetMCBinContents(mcstep);
+
+          for (size_t e = 0; e < events.size(); e++) {
+            weights[events[e]] = fEventWeights[events[e]];
+          }
+
+          // Exact when ConvertEventRates is linear in the weights, as the
+          // Measurement1D scalings are, and a forward difference otherwise
+          std::vector<double> const &mc = samplemc[isam];
+          std::vector<double> const &dlike = sampledlike[isam];
+          for (size_t ibin = 0; ibin < mc.size() && ibin < mcstep.size();
+               ibin++) {
+            grad[ipar] += dlike[ibin] * (mcstep[ibin] - mc[ibin]) / step;
+          }
+          ncontracted++;
+          continue;
+        }
+
+        double like[2];
+        for (int side = 0; side < 2; side++) {
+          double sign = side ? -1.0 : 1.0;
+          for (size_t e = 0; e < events.size(); e++) {
+            weights[events[e]] = fEventWeights[events[e]] + sign * step * values[e];
+          }
+
+          exp->ResetAll();
+          for (size_t j = 0; j < samplesubs[isam].size(); j++) {
+            size_t sub = samplesubs[isam][j];
+            fSignalCache.Replay(sub, fSubSampleList[sub], &weights[0]);
+          }
+          exp->ConvertEventRates();
+          like[side] = exp->GetLikelihood();
+        }
+
+        for (size_t e = 0; e < events.size(); e++) {
+          weights[events[e]] = fEventWeights[events[e]];
+        }
+
+        grad[ipar] += (like[0] - like[1]) / (2.0 * step);
+        nstepped++;
+      }
+    }
+
+    NUIS_LOG(MIN, "Spline gradient from " << ncontracted
+                  << " dMC/dpar contractions (one refill each) and "
+                  << nstepped
+                  << " likelihood central differences (two refills each).");
+
+    // Put the stepped samples back at x
+    for (size_t isam = 0; isam < samples.size(); isam++) {
+      if (!dirty[isam]) {
+        continue;
+      }
+      MeasurementBase *exp = samples[isam];
+      exp->ResetAll();
+      for (size_t j = 0; j < samplesubs[isam].size(); j++) {
+        size_t sub = samplesubs[isam][j];
+        fSignalCache.Replay(sub, fSubSampleList[sub], &fEventWeights[0]);
+      }
+      exp->ConvertEventRates();
+    }
+
+    // Pull terms only need the dial values
+    if (!fPulls.empty()) {
+      for (int ipar = 0; ipar < fNPars; ipar++) {
+        if (!isspline[ipar]) {
+          continue;
+        }
+
+        double nominal = rw->GetDialValue(dialenums[ipar]);
+        double like[2];
+        for (int side = 0; side < 2; side++) {
+          rw->SetDialValue(dialenums[ipar],
+                           nominal + (side ? -step : step));
+          like[side] = 0.0;
+          for (PullListConstIter iter = fPulls.begin(); iter != fPulls.end();
+               iter++) {
+            (*iter)->Reconfigure();
+            like[side] += (*iter)->GetLikelihood();
+          }
+        }
+        rw->SetDialValue(dialenums[ipar], nominal);
+        for (PullListConstIter iter = fPulls.begin(); iter != fPulls.end();
+             iter++) {
+          (*iter)->Reconfigure();
+        }
+
+        grad[ipar] += (like[0] - like[1]) / (2.0 * step);
+      }
+    }
+
+    // Spline derivatives are with respect to the mirrored dial value
+    for (int ipar = 0; ipar < fNPars; ipar++) {
+      bool mirrored = false;
+      GetParValue(x, ipar, &mirrored);
+      if (isspline[ipar] && mirrored) {
+        grad[ipar] = -grad[ipar];
+      }
+    }
+  }
+
+  // Anything else has to reconfigure the samples for each step
+  int nfinitediff = 0;
+  for (int ipar = 0; ipar < fNPars; ipar++) {
+    if (!isspline[ipar]) {
+      grad[ipar] = FiniteDifference(x, ipar, step);
+      nfinitediff++;
+    }
+  }
+  if (nfinitediff) {
+    Evaluate(x);
+  }
+
+  NUIS_LOG(MIN, "Gradient from " << (fNPars - nfinitediff)
+                                 << " spline derivatives and " << nfinitediff
+                                 << " finite differences.");
+
+  fGradientX.assign(x, x + fNPars);
+  if (fGradient.size() != (UInt_t)fNPars || grad != &fGradient[0]) {
+    fGradient.assign(grad, grad + fNPars);
+  }
+}
+
 //***************************************************
 int JointFCN::GetNDOF() {
   //***************************************************
 
   int totaldof = 0;
   int count = 0;
+  fCurrentNDOFs.clear();
 
   // Total number of Free bins in each MC prediction
   for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
@@ -283,6 +956,7 @@ int JointFCN::GetNDOF() {
     int dof = exp->GetNDOF();
 
     // Save Separate DOF
+    fCurrentNDOFs.push_back(dof);
     if (fIterationTree) {
       fSampleNDOF[count] = dof;
     }
@@ -298,6 +972,7 @@ int JointFCN::GetNDOF() {
     double dof = pull->GetLikelihood();
 
     // Save separate DOF
+    fCurrentNDOFs.push_back(dof);
     if (fIterationTree) {
       fSampleNDOF[count] = dof;
     }
@@ -318,6 +993,9 @@ int JointFCN::GetNDOF() {
 double JointFCN::GetLikelihood() {
   //***************************************************
 
+  SyncSamples();
+  fCurrentLikes.clear();
+
   NUIS_LOG(MIN, std::left << std::setw(53) << "Getting likelihoods..."
                           << " : "
                           << "-2logL");
@@ -328,9 +1006,15 @@ double JointFCN::GetLikelihood() {
   for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
        iter++) {
     MeasurementBase *exp = *iter;
-    double newlike = exp->GetLikelihood();
+    double newlike;
+    {
+      TimingUtils::ScopedTimer timer(exp->GetTimingID(),
+                                     TimingUtils::kGetLikelihood);
+      newlike = exp->GetLikelihood();
+    }
     int ndof = exp->GetNDOF();
     // Save separate likelihoods
+    fCurrentLikes.push_back(newlike);
     if (fIterationTree) {
       fSampleLikes[count] = newlike;
     }
@@ -352,6 +1036,7 @@ double JointFCN::GetLikelihood() {
     double newlike = pull->GetLikelihood();
 
     // Save separate likelihoods
+    fCurrentLikes.push_back(newlike);
     if (fIterationTree) {
       fSampleLikes[count] = newlike;
     }
@@ -383,6 +1068,13 @@ void JointFCN::LoadSamples(std::vector<nuiskey> samplekeys) {
 
     NUIS_LOG(MIN, "Loading Sample : " << samplename);
 
+    fSampleKeyText += key.GetElementName();
+    std::vector<std::string> attrs = key.GetAllKeys();
+    for (size_t a = 0; a < attrs.size(); a++) {
+      fSampleKeyText += " " + attrs[a] + "=" + key.GetS(attrs[a]);
+    }
+    fSampleKeyText += "\n";
+
     fOutputDir->cd();
     MeasurementBase *NewLoadedSample = SampleUtils::CreateSample(key);
 
@@ -392,6 +1084,7 @@ void JointFCN::LoadSamples(std::vector<nuiskey> samplekeys) {
       throw;
     } else {
       fSamples.push_back(NewLoadedSample);
+      fSampleOutputs.push_back(key.Has("output") ? key.GetS("output") : "");
     }
   }
 }
@@ -418,10 +1111,15 @@ void JointFCN::ReconfigureSamples(bool fullconfig) {
   int starttime = time(NULL);
   NUIS_LOG(REC, "------------");
   NUIS_LOG(REC, "Starting Reconfigure iter. " << this->fCurIter);
+  fLastEvalX.clear();
   // std::cout << fUsingEventManager << " " << fullconfig << " " << fMCFilled
   // << std::endl; Event Manager Reconf
   if (fUsingEventManager) {
-    if (!fullconfig && fMCFilled)
+    if (UseWorkers())
+      ReconfigureUsingWorkers(fullconfig || !fMCFilled);
+    else if (!fMCFilled && LoadSignalCache())
+      ReconfigureFastUsingManager();
+    else if (!fullconfig && fMCFilled)
       ReconfigureFastUsingManager();
     else
       ReconfigureUsingManager();
@@ -468,6 +1166,24 @@ void JointFCN::ReconfigureSignal() {
 //***************************************************
 void JointFCN::ReconfigureAllEvents() {
   //***************************************************
+
+  // After a cached DoEval the weight engine is still at the last evaluated
+  // point. Move it to the cached one unless the caller has set the dials.
+  if (!fPendingX.empty()) {
+    std::vector<double> dials(fPendingDials.size());
+    if (!dials.empty()) {
+      FitBase::GetRW()->GetAllDials(&dials[0], dials.size());
+    }
+    if (dials == fPendingDials) {
+      std::vector<double> par_vals(fNPars);
+      for (int i = 0; i < fNPars; ++i) {
+        par_vals[i] = GetParValue(&fPendingX[0], i);
+      }
+      FitBase::GetRW()->UpdateWeightEngine(&par_vals[0]);
+    }
+    fPendingX.clear();
+  }
+
   FitBase::GetRW()->Reconfigure();
   FitBase::EvtManager().ResetWeightFlags();
   ReconfigureSamples(true);
@@ -519,6 +1235,7 @@ void JointFCN::ReconfigureUsingManager() {
 
   // 'Slow' Event Manager Reconfigure
   NUIS_LOG(REC, "Event Manager Reconfigure");
+  fEventWeightsValid = false;
   // int timestart = time(NULL);
 
   // Reset all samples
@@ -529,14 +1246,13 @@ void JointFCN::ReconfigureUsingManager() {
   }
 
   // If we are saving signal, reset all containers.
-  bool savesignal = (FitPar::Config().GetParB("SignalReconfigures"));
+  bool savesignal = (FitPar::Config().GetParB("SignalReconfigures")) &&
+                    !fSignalCacheDisabled;
 
   if (savesignal) {
     // Reset all of our event signal vectors
-    fSignalEventBoxes.clear();
     fSignalEventFlags.clear();
-    fSampleSignalFlags.clear();
-    fSignalEventSplines.clear();
+    fSignalSplines.Clear();
   }
 
   // Make sure we have a list of inputs
@@ -545,6 +1261,25 @@ void JointFCN::ReconfigureUsingManager() {
     fSubSampleList = GetSubSampleList();
   }
 
+  // The store is filled from entry 0, so workers reading a slice go without.
+  bool useeventstore = FitPar::Config().GetParB("EventStore") &&
+                       !fEventStoreDisabled && (fNSlices == 1);
+
+  if (savesignal) {
+    fSignalCache.Reset(fSubSampleList.size());
+  }
+
+  // Without signal reconfigures, full reconfigures after the first can
+  // still skip every entry that was never signal for any sample.
+  bool signalentries = !savesignal && !fSignalEntriesDisabled &&
+                       FitPar::Config().GetParB("SignalOnlyFullReconfigures");
+  bool usesignalentries =
+      signalentries && (fInputSignalEntries.size() == fInputList.size());
+  bool buildsignalentries = signalentries && !usesignalentries;
+  if (buildsignalentries) {
+    fInputSignalEntries.assign(fInputList.size(), std::vector<int>());
+  }
+
   // If all inputs are splines make sure the readers are told
   // they need to be reconfigured.
   std::vector<InputHandlerBase *>::iterator inp_iter = fInputList.begin();
@@ -572,12 +1307,38 @@ void JointFCN::ReconfigureUsingManager() {
   for (; inp_iter != fInputList.end(); inp_iter++) {
     InputHandlerBase *curinput = (*inp_iter);
 
+    // Entries to read if using the signal skip list
+    std::vector<int> const *sigentries =
+        usesignalentries ? &fInputSignalEntries[inputcount] : NULL;
+    size_t isigentry = 0;
+
+    // Entries this process fills
+    int firstentry, lastentry;
+    GetEntryRange(curinput, firstentry, lastentry);
+
     // Get event information
-    FitEvent *curevent = curinput->FirstNuisanceEvent();
+    FitEvent *curevent = NULL;
+    if (sigentries) {
+      if (!sigentries->empty()) {
+        TimingUtils::ScopedTimer timer(curinput->GetTimingID(),
+                                       TimingUtils::kReadEvent);
+        curevent = curinput->GetNuisanceEvent(sigentries->front());
+      }
+    } else if (fNSlices > 1) {
+      if (firstentry < lastentry) {
+        TimingUtils::ScopedTimer timer(curinput->GetTimingID(),
+                                       TimingUtils::kReadEvent);
+        curevent = curinput->GetNuisanceEvent(firstentry);
+      }
+    } else {
+      curinput->EnableEventStore(useeventstore &&
+                                 !NeedsGeneratorEvent(curinput));
+      curevent = curinput->FirstNuisanceEvent();
+    }
     curinput->CreateCache();
 
-    int i = 0;
-    int nevents = curinput->GetNEvents();
+    int i = sigentries ? 0 : firstentry;
+    int nevents = sigentries ? sigentries->size() : lastentry - firstentry;
     int countwidth = nevents / 10;
     uint textwidth = strlen(Form("%i", nevents));
 
@@ -590,25 +1351,43 @@ void JointFCN::ReconfigureUsingManager() {
       curevent->Weight =
           curevent->RWWeight * curevent->InputWeight * curevent->CustomWeight;
 
-      if (LOGGING(REC)) {
-        if (countwidth && (i % countwidth == 0)) {
-          NUIS_LOG(REC, std::left << std::setw(52) << curinput->GetName()
-		   << ": Processed " << std::right << std::setw(textwidth) << i
-		   << " events. [M, W] = [" << std::setw(3)
-		   << curevent->Mode << ", " << std::setw(5)
-		   << Form("%.3lf", curevent->Weight) << "]");
+      if (LOG_LEVEL(REC) && countwidth && (i % countwidth == 0)) {
+        NUIS_LOG(REC, std::left << std::setw(52) << curinput->GetName()
+		 << ": Processed " << std::right << std::setw(textwidth) << i
+		 << " events. [M, W] = [" << std::setw(3)
+		 << curevent->Mode << ", " << std::setw(5)
+		 << Form("%.3lf", curevent->Weight) << "]");
+      }
+
+      // Fall back to uncached reconfigures rather than exceed the budget
+      if ((savesignal || useeventstore) && !(i % 16384) &&
+          MemoryUtils::OverBudget()) {
+        NUIS_ERR(WRN, "RSS of " << MemoryUtils::ToMB(
+                                       MemoryUtils::GetCurrentRSS())
+                                << " is over MemoryBudgetMB = "
+                                << MemoryUtils::GetBudgetMB()
+                                << ", dropping event caches.");
+        if (savesignal) {
+          NUIS_ERR(WRN, "Disabling SignalReconfigures.");
+          savesignal = false;
+          fSignalCacheDisabled = true;
+          fSignalCache.Release();
+          std::vector<bool>().swap(fSignalEventFlags);
+          fSignalSplines.Release();
+        }
+        if (useeventstore) {
+          NUIS_ERR(WRN, "Disabling EventStore.");
+          useeventstore = false;
+          fEventStoreDisabled = true;
+          for (size_t j = 0; j < fInputList.size(); j++) {
+            fInputList[j]->ClearEventStore();
+          }
         }
       }
 
       // Setup flag for if signal found in at least one sample
       bool foundsignal = false;
 
-      // Create a new signal bitset for this event
-      std::vector<bool> signalbitset(fSubSampleList.size());
-
-      // Create a new signal box vector for this event
-      std::vector<MeasurementVariableBox *> signalboxes;
-
       // Start measurement iterator
       size_t measitercount = 0;
       std::vector<MeasurementBase *>::iterator meas_iter =
@@ -621,11 +1400,6 @@ void JointFCN::ReconfigureUsingManager() {
         // Compare input pointers, to current input, skip if not.
         // Pointer tells us if it matches without doing ID checks.
         if (curinput != curmeas->GetInput()) {
-          if (savesignal) {
-            // Set bit to 0 as definitely not signal
-            signalbitset[measitercount] = 0;
-          }
-
           // Count up what measurement we are on.
           measitercount++;
 
@@ -640,20 +1414,19 @@ void JointFCN::ReconfigureUsingManager() {
         curmeas->SetSignal(signal);
         curmeas->FillHistograms(curevent->Weight);
 
-        // If its Signal tally up fills
-        if (signal) {
-          fillcount++;
-        }
-
-        // If we are saving signal/splines fill the bitset
-        if (savesignal) {
-          signalbitset[measitercount] = signal;
+        // If signal save the event box for use later, the first signal
+        // sample starts a new cached event.
+        if (savesignal and signal) {
+          if (!foundsignal) {
+            fSignalCache.AddEvent();
+          }
+          fSignalCache.AddBox(measitercount, box);
         }
 
-        // If signal save a clone of the event box for use later.
-        if (savesignal and signal) {
+        // If its Signal tally up fills
+        if (signal) {
           foundsignal = true;
-          signalboxes.push_back(box->CloneSignalBox());
+          fillcount++;
         }
 
         // Keep track of Measurement we are on.
@@ -666,43 +1439,35 @@ void JointFCN::ReconfigureUsingManager() {
         fSignalEventFlags.push_back(foundsignal);
       }
 
-      // Save the vector of signal boxes for this event
-      if (savesignal && foundsignal) {
-        fSignalEventBoxes.push_back(signalboxes);
-        fSampleSignalFlags.push_back(signalbitset);
+      // Entries are visited in order so the skip list comes out sorted
+      if (buildsignalentries && foundsignal) {
+        fInputSignalEntries[inputcount].push_back(i);
       }
 
       // If all inputs are splines we can save the spline coefficients
       // for fast in memory reconfigures later.
       if (fIsAllSplines && savesignal && foundsignal) {
-        // Make temp vector to push back with
-        std::vector<float> coeff;
-        for (size_t l = 0; l < (UInt_t)curevent->fSplineRead->GetNPar(); l++) {
-          coeff.push_back(curevent->fSplineCoeff[l]);
-        }
-
-        // Push back to signal event splines. Kept in sync with
-        // fSignalEventBoxes size.
-        // int splinecount = fSignalEventSplines.size();
-        fSignalEventSplines.push_back(coeff);
-
-        // if (splinecount % 1000 == 0) {
-        // std::cout << "Pushed Back Coeff " << splinecount << " : ";
-        // for (size_t l = 0; l < fSignalEventSplines[splinecount].size();
-        // l++)
-        // {
-        // std::cout << " " << fSignalEventSplines[splinecount][l];
-        // }
-        // std::cout << std::endl;
-        // }
+        // Only splines with a response are kept. Kept in sync with
+        // the signal event numbers in fSignalCache.
+        fSignalSplines.Add(curevent->fSplineRead, curevent->fSplineCoeff);
       }
 
-      // Clean up vectors once done with this event
-      signalboxes.clear();
-      signalbitset.clear();
-
       // Iterate to the next event.
-      curevent = curinput->NextNuisanceEvent();
+      if (sigentries) {
+        TimingUtils::ScopedTimer timer(curinput->GetTimingID(),
+                                       TimingUtils::kReadEvent);
+        isigentry++;
+        curevent = (isigentry < sigentries->size())
+                       ? curinput->GetNuisanceEvent((*sigentries)[isigentry])
+                       : NULL;
+      } else if (fNSlices > 1) {
+        TimingUtils::ScopedTimer timer(curinput->GetTimingID(),
+                                       TimingUtils::kReadEvent);
+        curevent =
+            (i + 1 < lastentry) ? curinput->GetNuisanceEvent(i + 1) : NULL;
+      } else {
+        curevent = curinput->NextNuisanceEvent();
+      }
       i++;
     }
 
@@ -714,32 +1479,31 @@ void JointFCN::ReconfigureUsingManager() {
 
   // End of Event Loop ===============================
 
+  // Workers hand the raw fills back before they are converted
+  if (fNSlices > 1) {
+    PackFilledHistograms(fWorkerFills);
+  }
+
   // Now event loop is finished loop over all Measurements
   // Converting Binned events to XSec Distributions
   iterSam = fSamples.begin();
   for (; iterSam != fSamples.end(); iterSam++) {
     MeasurementBase *exp = (*iterSam);
+    TimingUtils::ScopedTimer timer(exp->GetTimingID(),
+                                   TimingUtils::kConvertEventRates);
     exp->ConvertEventRates();
   }
 
-  // Print out statements on approximate memory usage for profiling.
   NUIS_LOG(REC, "Filled " << fillcount << " signal events.");
   if (savesignal) {
-    int mem = ( // sizeof(fSignalEventBoxes) +
-                // fSignalEventBoxes.size() * sizeof(fSignalEventBoxes.at(0)) +
-                  sizeof(MeasurementVariableBox1D) * fillcount) *
-              1E-6;
     NUIS_LOG(REC, " -> Saved " << fillcount
-                               << " signal boxes for faster access. (~" << mem
-                               << " MB)");
-    if (fIsAllSplines and !fSignalEventSplines.empty()) {
-      int splmem = sizeof(float) * fSignalEventSplines.size() *
-                   fSignalEventSplines[0].size() * 1E-6;
-      NUIS_LOG(REC, " -> Saved "
-                        << fillcount << " " << fSignalEventSplines.size()
-                        << " spline sets into memory. (~" << splmem << " MB)");
+                               << " signal boxes for faster access.");
+    if (fIsAllSplines and !fSignalSplines.empty()) {
+      NUIS_LOG(REC, " -> Saved " << fSignalSplines.size()
+                                 << " spline sets into memory.");
     }
   }
+  ReportMemory("full reconfigure");
 
   // Check SignalReconfigures works for all samples
   if (savesignal) {
@@ -758,6 +1522,37 @@ void JointFCN::ReconfigureUsingManager() {
     } else {
       NUIS_LOG(FIT,
                "Likelihoods for FULL and FAST match. Will use FAST next time.");
+      SaveSignalCache(likefull);
+    }
+  }
+
+  // Check the signal skip list gives the same answer, otherwise some sample
+  // uses non-signal events and every entry has to be read.
+  if (buildsignalentries) {
+    size_t nsig = 0;
+    size_t ntot = 0;
+    for (size_t j = 0; j < fInputList.size(); j++) {
+      nsig += fInputSignalEntries[j].size();
+      ntot += fInputList[j]->GetNEvents();
+    }
+    NUIS_LOG(REC, "Signal skip list keeps " << nsig << " of " << ntot
+                                            << " entries.");
+
+    double likefull = GetLikelihood();
+    ReconfigureUsingManager();
+    double likeskip = GetLikelihood();
+
+    if (fabs(likefull - likeskip) > 0.0001) {
+      NUIS_ERR(WRN, "Full and signal-only likelihoods DIFFER! : "
+                        << likefull << " : " << likeskip);
+      NUIS_ERR(WRN, "Some samples use non-signal events, disabling "
+                    "SignalOnlyFullReconfigures.");
+      fInputSignalEntries.clear();
+      fSignalEntriesDisabled = true;
+      ReconfigureUsingManager();
+    } else {
+      NUIS_LOG(FIT, "Likelihoods for FULL and SIGNAL-ONLY match. Will only "
+                    "read signal entries next time.");
     }
   }
 };
@@ -789,12 +1584,6 @@ void JointFCN::ReconfigureFastUsingManager() {
 
   // Setup fast vector iterators.
   std::vector<bool>::iterator inpsig_iter = fSignalEventFlags.begin();
-  std::vector<std::vector<MeasurementVariableBox *> >::iterator box_iter =
-      fSignalEventBoxes.begin();
-  std::vector<std::vector<float> >::iterator spline_iter =
-      fSignalEventSplines.begin();
-  std::vector<std::vector<bool> >::iterator samsig_iter =
-      fSampleSignalFlags.begin();
   int splinecount = 0;
 
   // Setup stuff for logging
@@ -802,7 +1591,7 @@ void JointFCN::ReconfigureFastUsingManager() {
   // This is just the total number of events
   // int nevents = fSignalEventFlags.size();
   // This is the number of events that are signal
-  int nevents = fSignalEventBoxes.size();
+  int nevents = fSignalCache.GetNEvents();
   int countwidth = nevents / 10;
 
   // If All Splines tell splines they need a reconfigure.
@@ -820,12 +1609,12 @@ void JointFCN::ReconfigureFastUsingManager() {
   }
 
   // Loop over all possible spline inputs
-  double *coreeventweights = new double[fSignalEventBoxes.size()];
+  fEventWeights.resize(fSignalCache.GetNEvents());
+  double *coreeventweights = fEventWeights.empty() ? NULL : &fEventWeights[0];
   splinecount = 0;
 
   inp_iter = fInputList.begin();
   inpsig_iter = fSignalEventFlags.begin();
-  spline_iter = fSignalEventSplines.begin();
 
   // Loop over all signal flags
   // For each valid signal flag add one to splinecount
@@ -839,20 +1628,25 @@ void JointFCN::ReconfigureFastUsingManager() {
     BaseFitEvt *curevent = curinput->FirstBaseEvent();
 
     // Loop over the events in each input
-    for (int i = 0; i < curinput->GetNEvents(); i++) {
+    int firstentry, lastentry;
+    GetEntryRange(curinput, firstentry, lastentry);
+    for (int i = firstentry; i < lastentry; i++) {
       double rwweight = 0.0;
 
       // If the event is a signal event
       if (fSignalEventFlags[sigcount]) {
         // Get Event Info
         if (!fIsAllSplines) {
+          TimingUtils::ScopedTimer timer(curinput->GetTimingID(),
+                                         TimingUtils::kReadEvent);
           if (fFillNuisanceEvent) {
             curevent = curinput->GetNuisanceEvent(i);
           } else {
             curevent = curinput->GetBaseEvent(i);
           }
         } else {
-          curevent->fSplineCoeff = &fSignalEventSplines[splinecount][0];
+          curevent->fSplineMask = fSignalSplines.GetMask(splinecount);
+          curevent->fSplineCoeff = fSignalSplines.GetCoeffs(splinecount);
         }
 
         curevent->RWWeight = FitBase::GetRW()->CalcWeight(curevent);
@@ -880,83 +1674,730 @@ void JointFCN::ReconfigureFastUsingManager() {
 
   // #pragma omp barrier
 
-  // Reset Iterators
-  inpsig_iter = fSignalEventFlags.begin();
-  spline_iter = fSignalEventSplines.begin();
-  box_iter = fSignalEventBoxes.begin();
-  samsig_iter = fSampleSignalFlags.begin();
-  int nsplineweights = splinecount;
-  splinecount = 0;
-
   // Start of Fast Event Loop ============================
 
-  // Start input iterators
-  // Loop over number of inputs
-  for (int ispline = 0; ispline < nsplineweights; ispline++) {
-    double rwweight = coreeventweights[ispline];
-
-    // Get iterators for this event
-    std::vector<bool>::iterator subsamsig_iter = (*samsig_iter).begin();
-    std::vector<MeasurementVariableBox *>::iterator subbox_iter =
-        (*box_iter).begin();
-
-    // Loop over all sub measurements.
-    std::vector<MeasurementBase *>::iterator meas_iter = fSubSampleList.begin();
-    for (; meas_iter != fSubSampleList.end(); meas_iter++, subsamsig_iter++) {
-      MeasurementBase *curmeas = (*meas_iter);
-
-      // If event flagged as signal for this sample fill from the box.
-      if (*subsamsig_iter) {
-        curmeas->SetSignal(true);
-        curmeas->FillHistogramsFromBox((*subbox_iter), rwweight);
-
-        // Move onto next box if there is one.
-        subbox_iter++;
-        fillcount++;
-      }
-    }
-
-    if (ispline % countwidth == 0) {
-      NUIS_LOG(REC, "Filled " << ispline << " sample weights.");
-    }
-
-    // Iterate over the main signal event containers.
-    samsig_iter++;
-    box_iter++;
-    spline_iter++;
-    splinecount++;
+  // Each sample replays its own cached boxes, weighting each by its
+  // signal event weight.
+  for (size_t isample = 0; isample < fSubSampleList.size(); isample++) {
+    fSignalCache.Replay(isample, fSubSampleList[isample], coreeventweights);
+    fillcount += fSignalCache.GetNBoxes(isample);
   }
   // End of Fast Event Loop ===================
 
   NUIS_LOG(SAM, "Filled sample distributions.");
 
+  if (fNSlices > 1) {
+    PackFilledHistograms(fWorkerFills);
+  }
+
   // Now loop over all Measurements
   // Convert Binned events
   iterSam = fSamples.begin();
   for (; iterSam != fSamples.end(); iterSam++) {
     MeasurementBase *exp = (*iterSam);
+    TimingUtils::ScopedTimer timer(exp->GetTimingID(),
+                                   TimingUtils::kConvertEventRates);
     exp->ConvertEventRates();
   }
 
-  // Cleanup coreeventweights
-  delete coreeventweights;
+  // Kept for Gradient
+  fEventWeightsValid = fIsAllSplines;
 
   // Print some reconfigure profiling.
   NUIS_LOG(REC, "Filled " << fillcount << " signal events.");
+  ReportMemory("fast reconfigure");
+}
+
+//***************************************************
+std::string JointFCN::GetSignalCacheKey() {
+  //***************************************************
+
+  std::ostringstream key;
+  key << "NUISANCE " << NUISANCE_BUILD_VERSION << " signal cache "
+      << kSignalCacheFormat << "\n"
+      << fSampleKeyText;
+
+  for (size_t i = 0; i < fSubSampleList.size(); i++) {
+    MeasurementBase *sample = fSubSampleList[i];
+    key << sample->GetName() << " " << sample->GetInput()->GetNEvents()
+        << "\n";
+
+    std::vector<std::string> files = InputUtils::ParseInputFileList(
+        InputUtils::ExpandInputDirectories(sample->GetInputFileName()));
+    for (size_t j = 0; j < files.size(); j++) {
+      struct stat info;
+      key << " " << files[j];
+      if (stat(files[j].c_str(), &info) == 0) {
+        key << " " << info.st_size << " " << info.st_mtime;
+      }
+      key << "\n";
+    }
+  }
+  key << "splines " << fIsAllSplines << "\n";
+
+  for (size_t i = 0;
+       i < sizeof(kSignalCacheConfig) / sizeof(kSignalCacheConfig[0]); i++) {
+    key << "config " << kSignalCacheConfig[i] << "="
+        << FitPar::Config().GetParS(kSignalCacheConfig[i]) << "\n";
+  }
+  return key.str();
+}
+
+//***************************************************
+std::string JointFCN::GetWorkerKey() {
+  //***************************************************
+
+  // Input paths and times can differ between nodes, their contents can not
+  std::ostringstream key;
+  key << "NUISANCE " << NUISANCE_BUILD_VERSION << " FCN worker\n"
+      << fSampleKeyText;
+
+  for (size_t i = 0; i < fSubSampleList.size(); i++) {
+    MeasurementBase *sample = fSubSampleList[i];
+    key << sample->GetName() << " " << sample->GetInput()->GetNEvents()
+        << "\n";
+
+    std::vector<std::string> files = InputUtils::ParseInputFileList(
+        InputUtils::ExpandInputDirectories(sample->GetInputFileName()));
+    for (size_t j = 0; j < files.size(); j++) {
+      struct stat info;
+      if (stat(files[j].c_str(), &info) == 0) {
+        key << " " << info.st_size << "\n";
+      }
+    }
+  }
+
+  // Reconfigure requests are dial values in this order
+  std::vector<std::string> dials = FitBase::GetRW()->GetDialNames();
+  for (size_t i = 0; i < dials.size(); i++) {
+    key << "dial " << dials[i] << "\n";
+  }
+  return key.str();
+}
+
+//***************************************************
+std::string JointFCN::GetSignalCacheFile() {
+  //***************************************************
+
+  std::string dir = FitPar::Config().GetParS("SignalCacheDir");
+  if (dir.empty()) {
+    return "";
+  }
+
+  // Only used to name the file, the key itself is checked on load
+  uint64_t hash = FCNWorkers::Hash(GetSignalCacheKey());
+  return dir + Form("/nuisance_signal_%016llx.cache", (unsigned long long)hash);
+}
+
+//***************************************************
+void JointFCN::SaveSignalCache(double likelihood) {
+  //***************************************************
+
+  if (fSignalCacheStored || fNSlices > 1) {
+    return;
+  }
+  std::string path = GetSignalCacheFile();
+  if (path.empty()) {
+    return;
+  }
+  fSignalCacheStored = true;
+
+  if (fSignalCache.HasCustomBoxes()) {
+    NUIS_ERR(WRN, "Some samples use custom signal boxes, not saving the "
+                  "signal cache to "
+                      << path);
+    return;
+  }
+
+  size_t ndials = FitBase::GetRW()->GetDialEnums().size();
+  std::vector<double> dials(ndials);
+  if (ndials) {
+    FitBase::GetRW()->GetAllDials(&dials[0], ndials);
+  }
+  std::vector<char> flags(fSignalEventFlags.begin(), fSignalEventFlags.end());
+  std::string key = GetSignalCacheKey();
+  std::vector<char> keychars(key.begin(), key.end());
+
+  // Written next to the final file and renamed into place, so concurrent
+  // jobs never read a partial cache.
+  std::vector<char> tmpname(path.begin(), path.end());
+  std::string suffix = ".XXXXXX";
+  tmpname.insert(tmpname.end(), suffix.begin(), suffix.end());
+  tmpname.push_back('\0');
+  int fd = mkstemp(&tmpname[0]);
+  FILE *f = (fd < 0) ? NULL : fdopen(fd, "wb");
+  if (!f) {
+    if (fd >= 0) {
+      close(fd);
+      unlink(&tmpname[0]);
+    }
+    NUIS_ERR(WRN, "Could not write signal cache " << path);
+    return;
+  }
+
+  bool ok = (fwrite(kSignalCacheMagic, 1, 8, f) == 8) &&
+            SignalCacheIO::WriteColumn(f, keychars) &&
+            (fwrite(&likelihood, sizeof(double), 1, f) == 1) &&
+            SignalCacheIO::WriteColumn(f, dials) &&
+            SignalCacheIO::WriteColumn(f, flags);
+  ok = ok && SignalCacheIO::WriteColumn(f, fSignalSplines.fMasks) &&
+       SignalCacheIO::WriteColumn(f, fSignalSplines.fMaskStart) &&
+       SignalCacheIO::WriteColumn(f, fSignalSplines.fCoeffs) &&
+       SignalCacheIO::WriteColumn(f, fSignalSplines.fCoeffStart);
+  ok = ok && fSignalCache.Write(f);
+  ok = (fclose(f) == 0) && ok;
+
+  if (!ok || rename(&tmpname[0], path.c_str()) != 0) {
+    unlink(&tmpname[0]);
+    NUIS_ERR(WRN, "Could not write signal cache " << path);
+    return;
+  }
+  NUIS_LOG(FIT, "Saved signal cache to " << path);
+}
+
+//***************************************************
+bool JointFCN::LoadSignalCache() {
+  //***************************************************
+
+  if (fSignalCacheStored || fSignalCacheDisabled ||
+      !FitPar::Config().GetParB("SignalReconfigures")) {
+    return false;
+  }
+
+  if (fInputList.empty()) {
+    fInputList = GetInputList();
+    fSubSampleList = GetSubSampleList();
+  }
+  std::string path = GetSignalCacheFile();
+  if (path.empty()) {
+    return false;
+  }
+
+  FILE *f = fopen(path.c_str(), "rb");
+  if (!f) {
+    NUIS_LOG(FIT, "No signal cache at " << path
+                                        << ", one will be saved after the "
+                                           "first full reconfigure.");
+    return false;
+  }
+
+  std::string key = GetSignalCacheKey();
+  char magic[8];
+  std::vector<char> keychars;
+  double likelihood = 0.0;
+  std::vector<double> dials;
+  std::vector<char> flags;
+
+  bool ok = (fread(magic, 1, 8, f) == 8) &&
+            !memcmp(magic, kSignalCacheMagic, 8) &&
+            SignalCacheIO::ReadColumn(f, keychars) &&
+            (std::string(keychars.begin(), keychars.end()) == key) &&
+            (fread(&likelihood, sizeof(double), 1, f) == 1) &&
+            SignalCacheIO::ReadColumn(f, dials) &&
+            SignalCacheIO::ReadColumn(f, flags) &&
+            SignalCacheIO::ReadColumn(f, fSignalSplines.fMasks) &&
+            SignalCacheIO::ReadColumn(f, fSignalSplines.fMaskStart) &&
+            SignalCacheIO::ReadColumn(f, fSignalSplines.fCoeffs) &&
+            SignalCacheIO::ReadColumn(f, fSignalSplines.fCoeffStart) &&
+            fSignalCache.Read(f);
+  fclose(f);
+
+  // Everything has to line up with the inputs and samples of this job
+  size_t nentries = 0;
+  for (size_t i = 0; i < fInputList.size(); i++) {
+    nentries += fInputList[i]->GetNEvents();
+  }
+  size_t nsignal = std::count(flags.begin(), flags.end(), 1);
+  ok = ok && (flags.size() == nentries) &&
+       (fSignalCache.GetNEvents() == nsignal) &&
+       (fSignalCache.GetNSamples() == fSubSampleList.size()) &&
+       (fSignalSplines.size() == (fIsAllSplines ? nsignal : 0)) &&
+       (fSignalSplines.fCoeffStart.size() == fSignalSplines.size());
+  for (size_t i = 0; ok && i < fSignalSplines.size(); i++) {
+    ok = (fSignalSplines.fMaskStart[i] < fSignalSplines.fMasks.size()) &&
+         (fSignalSplines.fCoeffStart[i] <= fSignalSplines.fCoeffs.size());
+  }
+
+  size_t ndials = FitBase::GetRW()->GetDialEnums().size();
+  if (ok && dials.size() != ndials) {
+    NUIS_ERR(WRN, "Signal cache " << path << " was saved with "
+                                  << dials.size() << " dials, not " << ndials
+                                  << ", it cannot be checked.");
+    ok = false;
+  }
+  if (!ok) {
+    NUIS_ERR(WRN, "Ignoring stale or unreadable signal cache " << path);
+    fSignalCache.Release();
+    fSignalSplines.Release();
+    return false;
+  }
+  fSignalEventFlags.assign(flags.begin(), flags.end());
+
+  // Check the cache against the likelihood it was saved with, then put the
+  // dials back.
+  std::vector<double> current(ndials);
+  if (ndials) {
+    FitBase::GetRW()->GetAllDials(&current[0], ndials);
+    FitBase::GetRW()->SetAllDials(&dials[0], ndials);
+    FitBase::EvtManager().ResetWeightFlags();
+  }
+  ReconfigureFastUsingManager();
+  double likecache = GetLikelihood();
+  if (ndials) {
+    FitBase::GetRW()->SetAllDials(&current[0], ndials);
+    FitBase::EvtManager().ResetWeightFlags();
+  }
+
+  if (fabs(likecache - likelihood) > 0.0001) {
+    NUIS_ERR(WRN, "Signal cache " << path << " gives likelihood " << likecache
+                                  << ", it was saved with " << likelihood
+                                  << ". Ignoring it.");
+    fSignalCache.Release();
+    std::vector<bool>().swap(fSignalEventFlags);
+    fSignalSplines.Release();
+    return false;
+  }
+
+  fSignalCacheStored = true;
+  NUIS_LOG(FIT, "Loaded " << nsignal << " signal events from signal cache "
+                          << path << ", skipping the first full reconfigure.");
+  return true;
+}
+
+//***************************************************
+bool JointFCN::NeedsGeneratorEvent(InputHandlerBase *input) {
+//***************************************************
+  // Converted events can only be replayed if neither a weight engine for
+  // this generator nor a sample reading the input needs the generator-level
+  // event, which the store doesn't keep.
+  if (FitBase::GetRW()->NeedsGeneratorEvent(input->GetType())) {
+    return true;
+  }
+  for (size_t i = 0; i < fSubSampleList.size(); i++) {
+    if ((fSubSampleList[i]->GetInput() == input) &&
+        fSubSampleList[i]->NeedsGeneratorEvent()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//***************************************************
+void JointFCN::ReopenInputs() {
+//***************************************************
+  // ROOT files were already reopened by FCNWorkerPool::ForkLocal
+  if (fInputList.empty()) {
+    fInputList = GetInputList();
+  }
+  for (size_t i = 0; i < fInputList.size(); i++) {
+    fInputList[i]->ReopenFiles();
+  }
+}
+
+//***************************************************
+bool JointFCN::UseWorkers() {
+  //***************************************************
+
+  if (fWorkersStarted) {
+    return fWorkers != NULL;
+  }
+  fWorkersStarted = true;
+  if (!fUsingEventManager) {
+    return false;
+  }
+
+  int timeout = FitPar::Config().GetParI("DistributedTimeout");
+
+  if (fInputList.empty()) {
+    fInputList = GetInputList();
+    fSubSampleList = GetSubSampleList();
+  }
+
+  // This process only fills a slice for a master somewhere else
+  std::string master = FitPar::Config().GetParS("DistributedMaster");
+  if (!master.empty()) {
+    int fd = FCNWorkers::ConnectToMaster(
+        master, timeout, FCNWorkers::Hash(GetWorkerKey()));
+    int type = 0;
+    std::vector<double> assign;
+    if (!FCNWorkers::Receive(fd, type, assign) || type != kFCNWorkerAssign ||
+        assign.size() != 2) {
+      NUIS_ABORT("Did not get a slice from the FCN master at " << master);
+    }
+    ServeMaster(fd, assign[0], assign[1]);
+  }
+
+  int nlocal = std::max(0, FitPar::Config().GetParI("DistributedNWorkers"));
+  int nremote = std::max(0, FitPar::Config().GetParI("DistributedNRemote"));
+  int nslices = nlocal + nremote;
+  if (!nremote && nlocal <= 1) {
+    return false;
+  }
+
+  fWorkers = new FCNWorkerPool();
+  int slice = 0;
+  int fd = fWorkers->ForkLocal(nlocal, slice);
+  if (fd >= 0) {
+    ReopenInputs();
+    delete fWorkers;
+    fWorkers = NULL;
+    ServeMaster(fd, slice, nslices);
+  }
+  fWorkers->AcceptRemote(FitPar::Config().GetParS("DistributedBindAddress"),
+                         FitPar::Config().GetParI("DistributedPort"), nremote,
+                         nlocal, nslices, timeout,
+                         FCNWorkers::Hash(GetWorkerKey()));
+
+  NUIS_LOG(FIT, "Splitting each input into " << nslices
+                                             << " slices across workers.");
+  return true;
+}
+
+//***************************************************
+void JointFCN::ReconfigureUsingWorkers(bool full) {
+  //***************************************************
+
+  // The first time round also fill everything here and make sure the
+  // workers' summed fills give the same likelihood.
+  double likelocal = 0.0;
+  bool check = fCheckWorkers;
+  if (check) {
+    fCheckWorkers = false;
+    ReconfigureUsingManager();
+    likelocal = GetLikelihood();
+
+    // The master keeps no event caches of its own
+    fSignalCache.Release();
+    std::vector<bool>().swap(fSignalEventFlags);
+    fSignalSplines.Release();
+    fInputSignalEntries.clear();
+    for (size_t j = 0; j < fInputList.size(); j++) {
+      fInputList[j]->ClearEventStore();
+    }
+  }
+
+  NUIS_LOG(REC, "Reconfiguring " << (full ? "FULL" : "FAST") << " using "
+                                 << fWorkers->GetNWorkers() << " workers");
+  fEventWeightsValid = false;
+
+  MeasListConstIter iterSam = fSamples.begin();
+  for (; iterSam != fSamples.end(); iterSam++) {
+    (*iterSam)->ResetAll();
+  }
+
+  size_t ndials = FitBase::GetRW()->GetDialEnums().size();
+  std::vector<double> request(1 + ndials);
+  request[0] = full;
+  if (ndials) {
+    FitBase::GetRW()->GetAllDials(&request[1], ndials);
+  }
+  fWorkers->Broadcast(kFCNWorkerReconfigure, request);
+
+  std::vector<std::vector<double> > fills;
+  fWorkers->Gather(kFCNWorkerFills, fills);
+  UnpackFilledHistograms(fills);
+
+  iterSam = fSamples.begin();
+  for (; iterSam != fSamples.end(); iterSam++) {
+    MeasurementBase *exp = (*iterSam);
+    TimingUtils::ScopedTimer timer(exp->GetTimingID(),
+                                   TimingUtils::kConvertEventRates);
+    exp->ConvertEventRates();
+  }
+
+  if (check) {
+    double likeworkers = GetLikelihood();
+    if (fabs(likelocal - likeworkers) > 0.0001) {
+      NUIS_ERR(FTL, "Local and distributed likelihoods DIFFER! : "
+                        << likelocal << " : " << likeworkers);
+      NUIS_ABORT("Some samples fill state the workers do not send back, "
+                 "run without DistributedNWorkers/DistributedNRemote.");
+    }
+    NUIS_LOG(FIT, "Likelihoods for LOCAL and DISTRIBUTED match.");
+  }
+}
+
+//***************************************************
+void JointFCN::ServeMaster(int fd, int slice, int nslices) {
+  //***************************************************
+
+  fSlice = slice;
+  fNSlices = nslices;
+  NUIS_LOG(FIT, "FCN worker filling slice " << slice + 1 << " of " << nslices);
+
+  // Anything cached so far covers every entry, not just this slice
+  fSignalCache.Release();
+  std::vector<bool>().swap(fSignalEventFlags);
+  fSignalSplines.Release();
+  fInputSignalEntries.clear();
+  if (fInputList.empty()) {
+    fInputList = GetInputList();
+    fSubSampleList = GetSubSampleList();
+  }
+
+  // The master reports progress, workers only report problems
+  SETVERBOSITY(QUIET);
+
+  int type = 0;
+  std::vector<double> request;
+  while (FCNWorkers::Receive(fd, type, request) && type != kFCNWorkerStop) {
+    if (type != kFCNWorkerReconfigure || request.empty()) {
+      NUIS_ABORT("Unexpected message " << type << " from the FCN master.");
+    }
+
+    if (request.size() > 1) {
+      FitBase::GetRW()->SetAllDials(&request[1], request.size() - 1);
+    }
+    FitBase::EvtManager().ResetWeightFlags();
+
+    fWorkerFills.clear();
+    if (request[0]) {
+      ReconfigureUsingManager();
+    } else {
+      ReconfigureFastUsingManager();
+    }
+
+    if (!FCNWorkers::Send(fd, kFCNWorkerFills, fWorkerFills)) {
+      break;
+    }
+  }
+
+  FCNWorkers::Exit(fd);
+}
+
+//***************************************************
+void JointFCN::GetEntryRange(InputHandlerBase *input, int &first, int &last) {
+  //***************************************************
+
+  Long64_t nevents = input->GetNEvents();
+  first = (nevents * fSlice) / fNSlices;
+  last = (nevents * (fSlice + 1)) / fNSlices;
+}
+
+//***************************************************
+std::vector<TH1 *> const &JointFCN::GetFilledHistograms() {
+  //***************************************************
+
+  if (!fFilledHists.empty()) {
+    return fFilledHists;
+  }
+
+  std::set<TH1 *> seen;
+  for (size_t i = 0; i < fSubSampleList.size(); i++) {
+    std::vector<TH1 *> hists = fSubSampleList[i]->GetFilledHistograms();
+    for (size_t j = 0; j < hists.size(); j++) {
+      if (!hists[j] || !seen.insert(hists[j]).second) {
+        continue;
+      }
+      if (!dynamic_cast<TArray *>(hists[j])) {
+        NUIS_ABORT("Distributed reconfigures cannot sum histogram "
+                   << hists[j]->GetName() << " of "
+                   << fSubSampleList[i]->GetName());
+      }
+      fFilledHists.push_back(hists[j]);
+    }
+  }
+  return fFilledHists;
+}
+
+//***************************************************
+void JointFCN::PackFilledHistograms(std::vector<double> &buf) {
+  //***************************************************
+
+  // Per histogram: N, N contents, N sum of squared weights, entries
+  std::vector<TH1 *> const &hists = GetFilledHistograms();
+  buf.clear();
+  for (size_t i = 0; i < hists.size(); i++) {
+    TArray *bins = dynamic_cast<TArray *>(hists[i]);
+    TArrayD const *sumw2 = hists[i]->GetSumw2();
+    int n = bins->GetSize();
+
+    buf.push_back(n);
+    for (int b = 0; b < n; b++) {
+      buf.push_back(bins->GetAt(b));
+    }
+    // Without Sumw2 every fill had unit weight
+    for (int b = 0; b < n; b++) {
+      buf.push_back(sumw2->GetSize() == n ? sumw2->GetAt(b) : bins->GetAt(b));
+    }
+    buf.push_back(hists[i]->GetEntries());
+  }
+}
+
+//***************************************************
+void JointFCN::UnpackFilledHistograms(
+    std::vector<std::vector<double> > const &fills) {
+  //***************************************************
+
+  std::vector<TH1 *> const &hists = GetFilledHistograms();
+
+  std::vector<double> total;
+  PackFilledHistograms(total);
+  std::fill(total.begin(), total.end(), 0.0);
+  for (size_t w = 0; w < fills.size(); w++) {
+    if (fills[w].size() != total.size()) {
+      NUIS_ABORT("FCN worker " << w << " sent " << fills[w].size()
+                               << " values, expected " << total.size()
+                               << ". Are all workers using the same card?");
+    }
+    for (size_t k = 0; k < total.size(); k++) {
+      total[k] += fills[w][k];
+    }
+  }
+
+  size_t k = 0;
+  for (size_t i = 0; i < hists.size(); i++) {
+    TArray *bins = dynamic_cast<TArray *>(hists[i]);
+    int n = bins->GetSize();
+    k++;
+
+    if (hists[i]->GetSumw2N() != n) {
+      hists[i]->Sumw2();
+    }
+    TArrayD *sumw2 = hists[i]->GetSumw2();
+    for (int b = 0; b < n; b++) {
+      bins->SetAt(total[k + b], b);
+      sumw2->SetAt(total[k + n + b], b);
+    }
+    k += 2 * n;
+    hists[i]->SetEntries(total[k++]);
+  }
+}
+
+//***************************************************
+void JointFCN::ReportMemory(std::string const &phase) {
+  //***************************************************
+
+  if (!LOGGING(REC)) {
+    return;
+  }
+
+  MemoryUtils::ByteTally hists;
+  MemoryUtils::ByteTally covars;
+  for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
+       iter++) {
+    (*iter)->TallyHistogramMemory(hists);
+    (*iter)->TallyCovarianceMemory(covars);
+  }
+  std::vector<MeasurementBase *> subsamples =
+      fSubSampleList.empty() ? GetSubSampleList() : fSubSampleList;
+  for (size_t i = 0; i < subsamples.size(); i++) {
+    subsamples[i]->TallyHistogramMemory(hists);
+    subsamples[i]->TallyCovarianceMemory(covars);
+  }
+
+  size_t splinebytes = fSignalSplines.GetMemoryBytes();
+
+  size_t inputbytes = 0;
+  std::vector<InputHandlerBase *> inputs =
+      fInputList.empty() ? GetInputList() : fInputList;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    inputbytes += inputs[i]->GetCacheBytes();
+  }
+
+  NUIS_LOG(REC, "Memory held after " << phase << ":");
+  NUIS_LOG(REC, " -> Signal boxes       : "
+                    << MemoryUtils::ToMB(fSignalCache.GetMemoryBytes() +
+                                         fSignalEventFlags.capacity() / 8));
+  NUIS_LOG(REC, " -> Spline coefficients: " << MemoryUtils::ToMB(splinebytes));
+  NUIS_LOG(REC, " -> Input caches       : " << MemoryUtils::ToMB(inputbytes));
+  NUIS_LOG(REC,
+           " -> Sample histograms  : " << MemoryUtils::ToMB(hists.GetBytes()));
+  NUIS_LOG(REC,
+           " -> Covariances        : " << MemoryUtils::ToMB(covars.GetBytes()));
+  size_t evalbytes = 0;
+  for (EvalCacheList::const_iterator it = fEvalCache.begin();
+       it != fEvalCache.end(); it++) {
+    evalbytes += it->first.capacity() + sizeof(EvalCacheEntry) +
+                 it->second.Likes.capacity() * sizeof(double) +
+                 it->second.NDOFs.capacity() * sizeof(int) +
+                 it->second.Dials.capacity() * sizeof(double);
+  }
+  NUIS_LOG(REC, " -> FCN eval cache     : " << MemoryUtils::ToMB(evalbytes));
+  MemoryUtils::LogPhase(phase);
 }
 
 //***************************************************
 void JointFCN::Write() {
   //***************************************************
 
+  SyncSamples();
+
+  // Hot path timings go with the main output
+  if (TimingUtils::IsEnabled()) {
+    TimingUtils::PrintSummary();
+    TimingUtils::Write(gDirectory);
+  }
+
+  std::vector<MeasurementBase *> mainsamples;
+  std::map<std::string, std::vector<MeasurementBase *> > splitsamples;
+  size_t isample = 0;
+  for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
+       iter++, isample++) {
+    if (fSampleOutputs[isample].empty()) {
+      mainsamples.push_back(*iter);
+    } else {
+      splitsamples[fSampleOutputs[isample]].push_back(*iter);
+    }
+  }
+
+  WriteSamples(mainsamples, true, splitsamples.empty());
+  if (splitsamples.empty()) {
+    return;
+  }
+
+  // Mirror the current subdirectory, e.g. nominal, in each separate file
+  TDirectory *curdir = gDirectory;
+  std::string subdir = curdir->GetPath();
+  subdir = (subdir.find(":/") != std::string::npos)
+               ? subdir.substr(subdir.find(":/") + 2)
+               : "";
+
+  std::map<std::string, std::vector<MeasurementBase *> >::iterator iterOut;
+  for (iterOut = splitsamples.begin(); iterOut != splitsamples.end();
+       iterOut++) {
+    std::string const &outname = iterOut->first;
+    NUIS_LOG(MIN, "Writing " << iterOut->second.size() << " samples to "
+                             << outname);
+
+    bool recreate = !fCreatedOutputs.count(outname);
+    TFile *outfile =
+        new TFile(outname.c_str(), recreate ? "RECREATE" : "UPDATE");
+    if (!outfile || outfile->IsZombie()) {
+      NUIS_ABORT("Cannot open sample output file: " << outname);
+    }
+    fCreatedOutputs.insert(outname);
+
+    TDirectory *outdir = outfile;
+    if (!subdir.empty()) {
+      outdir = outfile->GetDirectory(subdir.c_str());
+      if (!outdir) {
+        outdir = outfile->mkdir(subdir.c_str());
+      }
+    }
+    outdir->cd();
+
+    WriteSamples(iterOut->second, false, false);
+
+    outfile->Close();
+    delete outfile;
+  }
+
+  curdir->cd();
+};
+
+//***************************************************
+void JointFCN::WriteSamples(std::vector<MeasurementBase *> const &samples,
+                            bool writepulls, bool allinputs) {
+  //***************************************************
+
   // Save a likelihood/ndof plot
   NUIS_LOG(MIN, "Writing likelihood plot...");
   std::vector<double> likes;
   std::vector<double> ndofs;
   std::vector<std::string> names;
-  for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
-       iter++) {
-    MeasurementBase *exp = *iter;
+  for (size_t i = 0; i < samples.size(); i++) {
+    MeasurementBase *exp = samples[i];
     double like = exp->GetLikelihood();
     double ndof = exp->GetNDOF();
     std::string name = exp->GetName();
@@ -989,19 +2430,29 @@ void JointFCN::Write() {
 
   // Loop over individual experiments and call Write
   NUIS_LOG(MIN, "Writing each of the data classes...");
-  for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
-       iter++) {
-    MeasurementBase *exp = *iter;
-    exp->Write();
+  for (size_t i = 0; i < samples.size(); i++) {
+    samples[i]->Write();
   }
 
   // Save Pull Terms
-  for (PullListConstIter iter = fPulls.begin(); iter != fPulls.end(); iter++) {
-    ParamPull *pull = *iter;
-    pull->Write();
+  if (writepulls) {
+    for (PullListConstIter iter = fPulls.begin(); iter != fPulls.end();
+         iter++) {
+      ParamPull *pull = *iter;
+      pull->Write();
+    }
   }
 
   if (FitPar::Config().GetParB("EventManager")) {
+    // Inputs read by these samples
+    std::set<InputHandlerBase *> usedinputs;
+    for (size_t i = 0; i < samples.size(); i++) {
+      std::vector<MeasurementBase *> subsamples = samples[i]->GetSubSamples();
+      for (size_t j = 0; j < subsamples.size(); j++) {
+        usedinputs.insert(subsamples[j]->GetInput());
+      }
+    }
+
     // Get list of inputs
     std::map<int, InputHandlerBase *> fInputs =
         FitBase::EvtManager().GetInputs();
@@ -1009,18 +2460,22 @@ void JointFCN::Write() {
 
     for (iterInp = fInputs.begin(); iterInp != fInputs.end(); iterInp++) {
       InputHandlerBase *input = (iterInp->second);
+      if (!allinputs && !usedinputs.count(input)) {
+        continue;
+      }
 
       input->GetFluxHistogram()->Write();
       input->GetXSecHistogram()->Write();
       input->GetEventHistogram()->Write();
     }
   }
-};
+}
 
 //***************************************************
 void JointFCN::SetFakeData(std::string fakeinput) {
   //***************************************************
 
+  ClearEvalCache();
   NUIS_LOG(MIN, "Setting fake data from " << fakeinput);
   for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
        iter++) {
@@ -1035,6 +2490,7 @@ void JointFCN::SetFakeData(std::string fakeinput) {
 void JointFCN::ThrowDataToy() {
   //***************************************************
 
+  ClearEvalCache();
   for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
        iter++) {
     MeasurementBase *exp = *iter;
@@ -1044,6 +2500,36 @@ void JointFCN::ThrowDataToy() {
   return;
 }
 
+//***************************************************
+void JointFCN::ThrowDataCovariance() {
+  //***************************************************
+
+  ClearEvalCache();
+  for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
+       iter++) {
+    MeasurementBase *exp = *iter;
+    exp->ThrowCovariance();
+  }
+}
+
+//***************************************************
+void JointFCN::SetToySeed(UInt_t seed, int nbatch) {
+  //***************************************************
+
+  if (!seed) {
+    seed = 1 + gRandom->Integer(kMaxUInt - 1);
+  }
+  NUIS_LOG(FIT, "Throwing toys from seed " << seed << " in batches of "
+                                          << nbatch);
+
+  UInt_t sampleseed = seed;
+  for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
+       iter++) {
+    MeasurementBase *exp = *iter;
+    exp->SetToySeed(sampleseed++, nbatch);
+  }
+}
+
 //***************************************************
 std::vector<std::string> JointFCN::GetAllNames() {
   //***************************************************
@@ -1083,6 +2569,16 @@ std::vector<double> JointFCN::GetAllLikelihoods() {
   double total_likelihood = 0.0;
   NUIS_LOG(MIN, "Likelihoods : ");
 
+  // Samples are not at a cached DoEval point, but its likelihoods are known
+  if (!fPendingX.empty()) {
+    likevect = fCurrentLikes;
+    for (size_t i = 0; i < likevect.size(); i++) {
+      total_likelihood += likevect[i];
+    }
+    likevect.push_back(total_likelihood);
+    return likevect;
+  }
+
   // Loop over samples first
   for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
        iter++) {
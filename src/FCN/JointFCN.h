@@ -9,6 +9,8 @@
 #include <vector>
 #include <fstream>
 #include <list>
+#include <map>
+#include <set>
 
 // ROOT headers
 #include "TTree.h"
@@ -34,6 +36,10 @@
 #include "NuisKey.h"
 #include "MeasurementVariableBox.h"
 #include "MeasurementVariableBox1D.h"
+#include "SignalEventCache.h"
+#include "SplineCoeffs.h"
+
+class FCNWorkerPool;
 
 using namespace FitUtils;
 using namespace FitBase;
@@ -56,6 +62,13 @@ public:
   //! Main Likelihood evaluation FCN
   double DoEval(const double *x);
 
+  //! DoEval at each point of a scan, x holding fNPars values per point,
+  //! filling likes in point order. With ScanWorkers > 1 the points between
+  //! the first and last are shared out to forked processes that reuse the
+  //! caches filled here. The iteration tree gets a row per point in order
+  //! and the samples are left at the last point, as for a serial scan.
+  void DoEvalPoints(std::vector<double> const &x, std::vector<double> &likes);
+
   //! Func Wrapper for ROOT
   inline double operator() (const std::vector<double> & x) {
     double* x_array = new double[x.size()];
@@ -67,6 +80,22 @@ public:
     return this->DoEval(x);
   };
 
+  //! Derivative of DoEval with respect to parameter icoord. The whole
+  //! gradient is calculated, and cached, the first time each x is seen.
+  double DoDerivative(const double *x, unsigned int icoord);
+
+  //! Fill grad with the gradient of DoEval at x, leaving the samples
+  //! reconfigured at x. Spline dials use the analytic weight derivatives
+  //! when HasAnalyticGradient(), everything else uses finite differences.
+  //! Each affected sample is refilled once per spline dial when it has a
+  //! GetLikelihoodMCGradient, and twice otherwise, where the result is only
+  //! exact for a likelihood quadratic in the MC (not Poisson ones).
+  void Gradient(const double *x, double *grad);
+
+  //! Whether every input is a spline input with signal reconfigures, so that
+  //! spline dial derivatives come from the cached signal events.
+  bool HasAnalyticGradient();
+
   //! Create a TTree to save all dial value iterations for this FCN
   void CreateIterationTree(std::string name, FitWeight* rw);
 
@@ -100,12 +129,17 @@ public:
   double GetLikelihood();
 
   //! Returns list of pointers to the samples
-  inline std::list<MeasurementBase*> GetSampleList() { return fSamples; }
+  inline std::list<MeasurementBase*> GetSampleList() {
+    SyncSamples();
+    return fSamples;
+  }
 
   //! Return list of pointers to all the pulls
   inline std::list<ParamPull*> GetPullList() { return fPulls; };
 
   //! Write all samples to output DIR
+  //! Samples given an output='file.root' attribute are instead written to
+  //! that file, laid out as if that file's samples had been run on their own.
   void Write();
 
   //! Set Fake data from file/MC
@@ -117,10 +151,35 @@ public:
   //! Reconfigure Fast looping over duplicate inputs
   void ReconfigureFastUsingManager();
 
+  //! Log the bytes held by each cache, sample histograms and covariances,
+  //! and the RSS and peak RSS since the last phase.
+  void ReportMemory(std::string const& phase);
+
 
   /// Throws data according to current stats
   void ThrowDataToy();
 
+  //! Give every sample its own toy stream, seeded from seed, so later
+  //! ThrowDataToy calls are reproducible and generated nbatch at a time.
+  //! A seed of 0 is drawn from gRandom.
+  void SetToySeed(UInt_t seed, int nbatch);
+
+  //! Replace every sample's data with a throw of its covariance, to fit
+  //! toy data.
+  void ThrowDataCovariance();
+
+  //! Forget all cached DoEval results. Needed whenever the likelihood at a
+  //! given x changes, e.g. new fake data or toys.
+  void ClearEvalCache();
+
+  //! Log the DoEval cache hit rate
+  void PrintEvalCacheStats();
+
+  //! Called in a child of FCNWorkerPool::ForkLocal so it reads the non-ROOT
+  //! inputs through its own file handles, and never moves the file offsets
+  //! its parent is using.
+  void ReopenInputs();
+
   std::vector<MeasurementBase*> GetSubSampleList();
   std::vector<InputHandlerBase*> GetInputList();
 
@@ -134,16 +193,91 @@ public:
     mir_par.mirror_value = mirror_value;
     mir_par.mirror_above = mirror_above;
     fMirroredParams[ipar] = mir_par;
+    ClearEvalCache();
   }
   void SetNParams(int npar){
     fNPars = npar;
+    ClearEvalCache();
   }
 
 private:
 
+  //! Reconfigure the samples at x and get the likelihood, no caching.
+  double Evaluate(const double *x);
+
+  //! Reconfigure the samples at the last DoEval point if it was served from
+  //! the cache, so they match what was returned.
+  void SyncSamples();
+
+  //! Dial value the weight engines see for parameter i, after mirroring.
+  double GetParValue(const double *x, int i, bool *mirrored = NULL);
+
+  //! Central difference of DoEval for parameter i, leaves the samples at x+h.
+  double FiniteDifference(const double *x, int i, double step);
+
+  //! Write likelihoods, samples and their inputs to the current directory
+  void WriteSamples(std::vector<MeasurementBase*> const& samples,
+                    bool writepulls, bool allinputs);
+
+  //! Start the workers asked for in the config on the first call. Returns
+  //! true if this process is a master with workers. A process started with
+  //! DistributedMaster becomes a worker here and never returns.
+  bool UseWorkers();
+
+  //! Send the dials to the workers, sum their fills into the samples and
+  //! convert the event rates.
+  void ReconfigureUsingWorkers(bool full);
+
+  //! Worker loop: reconfigure this process's slice on each request from the
+  //! master and send the fills back. Exits the process once stopped.
+  void ServeMaster(int fd, int slice, int nslices);
+
+  //! Whether a weight engine or a sample reading input needs its
+  //! generator-level events, so they can't be replayed from the EventStore.
+  bool NeedsGeneratorEvent(InputHandlerBase* input);
+
+  //! Entries [first, last) of input this process fills, all of them unless
+  //! it is a worker.
+  void GetEntryRange(InputHandlerBase* input, int& first, int& last);
+
+  //! Unique filled histograms of every subsample, in fSubSampleList order
+  std::vector<TH1*> const& GetFilledHistograms();
+
+  //! Flatten the filled histogram contents, errors and entries into buf
+  void PackFilledHistograms(std::vector<double>& buf);
+
+  //! Set the filled histograms to the sum of the workers' packed fills
+  void UnpackFilledHistograms(std::vector<std::vector<double> > const& fills);
+
+  //! Everything the signal cache depends on: code version, sample keys, the
+  //! size and modification time of every input file and the global settings
+  //! that change the signal definitions or event weights.
+  std::string GetSignalCacheKey();
+
+  //! Everything a remote worker must share with its master: code version,
+  //! sample keys, event counts, input file sizes and dial names.
+  std::string GetWorkerKey();
+
+  //! Path of the persistent signal cache for this key in SignalCacheDir,
+  //! empty if it is not set.
+  std::string GetSignalCacheFile();
+
+  //! Write the signal cache, with the likelihood it gave at the current
+  //! dials, for later jobs on the same samples and inputs.
+  void SaveSignalCache(double likelihood);
+
+  //! Load a signal cache saved by an earlier job. It is only kept if a fast
+  //! reconfigure at the dials it was saved with gives the saved likelihood.
+  bool LoadSignalCache();
+
   //! Append the experiments to include in the fit to this list
   std::list<MeasurementBase*> fSamples;
 
+  //! Separate output file for each sample in fSamples, empty for fOutputDir
+  std::vector<std::string> fSampleOutputs;
+  //! Separate output files that have already been recreated
+  std::set<std::string> fCreatedOutputs;
+
   //! Append parameter pull terms to include penalties in the fit to this list
   std::list<ParamPull*> fPulls;
 
@@ -165,15 +299,66 @@ private:
 
   bool fUsingEventManager; //!< Flag for doing joint comparisons
 
-  std::vector< std::vector<float> > fSignalEventSplines;
-  std::vector< std::vector<MeasurementVariableBox*> > fSignalEventBoxes;
+  SparseSplineCoeffs fSignalSplines; //!< Packed coefficients per signal event
   std::vector< bool > fSignalEventFlags;
-  std::vector< std::vector<bool> > fSampleSignalFlags;
+  SignalEventCache fSignalCache; //!< Signal boxes for fast reconfigures
+
+  //! Sorted entries, per input, that were signal for at least one sample
+  std::vector< std::vector<int> > fInputSignalEntries;
+  bool fSignalEntriesDisabled; //!< Skip list failed its likelihood check
+  bool fSignalCacheDisabled;   //!< Signal cache dropped for MemoryBudgetMB
+  bool fEventStoreDisabled;    //!< Event stores dropped for MemoryBudgetMB
+  bool fSignalCacheStored;     //!< Signal cache loaded or saved this job
+  std::string fSampleKeyText;  //!< Sample card keys, for GetSignalCacheKey
 
   std::vector<InputHandlerBase*> fInputList;
   std::vector<MeasurementBase*> fSubSampleList;
   bool fIsAllSplines;
 
+  //! Signal event weights from the last fast reconfigure, for Gradient
+  std::vector<double> fEventWeights;
+  bool fEventWeightsValid;
+  //! Parameters DoEval last left the samples reconfigured at
+  std::vector<double> fLastEvalX;
+  //! Parameters and result of the last Gradient call
+  std::vector<double> fGradientX;
+  std::vector<double> fGradient;
+
+  //! Sample and pull likelihoods and NDOF from the last GetLikelihood/GetNDOF
+  std::vector<double> fCurrentLikes;
+  std::vector<int> fCurrentNDOFs;
+
+  //! DoEval result for one parameter vector
+  struct EvalCacheEntry {
+    double Likelihood;
+    int NDOF;
+    std::vector<double> Likes;
+    std::vector<int> NDOFs;
+    std::vector<double> Dials; //!< Only kept with an iteration tree
+  };
+  typedef std::list<std::pair<std::string, EvalCacheEntry> > EvalCacheList;
+
+  //! LRU cache of DoEval results, most recent first. Keys are the raw bytes
+  //! of x so only bitwise identical parameter vectors match.
+  EvalCacheList fEvalCache;
+  std::map<std::string, EvalCacheList::iterator> fEvalCacheIndex;
+  size_t fEvalCacheSize; //!< EvalCacheSize config, 0 disables
+  unsigned long fEvalCacheRWCount; //!< FitWeight change count after Evaluate
+  long fEvalCacheHits;
+  long fEvalCacheMisses;
+  //! x of the last DoEval if it was a cache hit, samples are not there yet
+  std::vector<double> fPendingX;
+  //! Weight engine dials when fPendingX was set
+  std::vector<double> fPendingDials;
+
+  FCNWorkerPool* fWorkers; //!< Workers filling slices, NULL if none
+  bool fWorkersStarted;    //!< UseWorkers has checked the config
+  bool fCheckWorkers;      //!< Compare the first distributed reconfigure
+  int fSlice;              //!< Slice of each input filled by this worker
+  int fNSlices;            //!< Number of slices, 1 unless this is a worker
+  std::vector<double> fWorkerFills; //!< Packed fills of the last reconfigure
+  std::vector<TH1*> fFilledHists;
+
 
   std::vector< int > fIterationCount;
   std::vector< double > fCurrentValues;
@@ -60,6 +60,18 @@ class MinimizerFCN{
     return fFCN->DoEval(x);
   };
 
+  // Wrapper for jointFCN derivatives, used through ROOT::Math::GradFunctor
+  inline double Derivative(const double *x, unsigned int icoord) const
+  {
+
+    if (!fFCN){
+      NUIS_ERR(FTL,"No FCN Found in MinimizerFCN!");
+      NUIS_ABORT("Exiting!");
+    }
+
+    return fFCN->DoDerivative(x, icoord);
+  };
+
   // Func Operator for vectors
   inline double operator() (const std::vector<double> & x) const
   {
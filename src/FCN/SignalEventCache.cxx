@@ -0,0 +1,184 @@
+#include "SignalEventCache.h"
+
+#include "MeasurementVariableBox1D.h"
+#include "MeasurementVariableBox2D.h"
+
+#include <typeinfo>
+
+namespace {
+// Boxes that only carry X/Y/Z/mode/sample weight can be stored as columns.
+bool IsStandardBox(MeasurementVariableBox *box) {
+  return (typeid(*box) == typeid(MeasurementVariableBox)) ||
+         (typeid(*box) == typeid(MeasurementVariableBox1D)) ||
+         (typeid(*box) == typeid(MeasurementVariableBox2D));
+}
+} // namespace
+
+SignalEventCache::SignalEventCache() : fNEvents(0), fWordsPerEvent(0) {}
+
+SignalEventCache::~SignalEventCache() { ClearCustom(); }
+
+void SignalEventCache::ClearCustom() {
+  for (size_t i = 0; i < fSamples.size(); i++) {
+    for (size_t j = 0; j < fSamples[i].Custom.size(); j++) {
+      delete fSamples[i].Custom[j];
+    }
+    fSamples[i].Custom.clear();
+  }
+}
+
+void SignalEventCache::Reset(size_t nsamples) {
+  ClearCustom();
+  fSamples.clear();
+  fSamples.resize(nsamples);
+  fSampleBits.clear();
+  fNEvents = 0;
+  fWordsPerEvent = (nsamples + 63) / 64;
+}
+
+void SignalEventCache::Release() {
+  ClearCustom();
+  std::vector<SampleColumns>().swap(fSamples);
+  std::vector<uint64_t>().swap(fSampleBits);
+  fNEvents = 0;
+  fWordsPerEvent = 0;
+}
+
+size_t SignalEventCache::AddEvent() {
+  fSampleBits.resize(fSampleBits.size() + fWordsPerEvent, 0);
+  return fNEvents++;
+}
+
+void SignalEventCache::AddBox(size_t isample, MeasurementVariableBox *box) {
+  size_t ievent = fNEvents - 1;
+  fSampleBits[ievent * fWordsPerEvent + isample / 64] |=
+      (uint64_t(1) << (isample % 64));
+
+  SampleColumns &sam = fSamples[isample];
+  if (!sam.IsTyped) {
+    sam.IsCustom = !IsStandardBox(box);
+    sam.IsTyped = true;
+  }
+
+  sam.Event.push_back(ievent);
+  if (sam.IsCustom) {
+    sam.Custom.push_back(box->CloneSignalBox());
+    return;
+  }
+
+  sam.X.push_back(box->GetX());
+  sam.Y.push_back(box->GetY());
+  sam.Z.push_back(box->GetZ());
+  sam.Mode.push_back(box->GetMode());
+  sam.SampleWeight.push_back(box->GetSampleWeight());
+}
+
+void SignalEventCache::Replay(size_t isample, MeasurementBase *meas,
+                              double const *eventweights) const {
+  SampleColumns const &sam = fSamples[isample];
+  size_t nboxes = sam.Event.size();
+
+  if (sam.IsCustom) {
+    for (size_t k = 0; k < nboxes; k++) {
+      meas->SetSignal(true);
+      meas->FillHistogramsFromCachedBox(sam.Custom[k],
+                                        eventweights[sam.Event[k]]);
+    }
+    return;
+  }
+
+  // Standard boxes are refilled into the sample's own box
+  MeasurementVariableBox *box = meas->GetBox();
+  for (size_t k = 0; k < nboxes; k++) {
+    box->SetX(sam.X[k]);
+    box->SetY(sam.Y[k]);
+    box->SetZ(sam.Z[k]);
+    box->SetMode(sam.Mode[k]);
+    box->SetSampleWeight(sam.SampleWeight[k]);
+
+    meas->SetSignal(true);
+    meas->FillHistogramsFromBox(box, eventweights[sam.Event[k]]);
+  }
+}
+
+size_t SignalEventCache::GetMemoryBytes() const {
+  size_t bytes = fSampleBits.capacity() * sizeof(uint64_t);
+  for (size_t i = 0; i < fSamples.size(); i++) {
+    SampleColumns const &sam = fSamples[i];
+    bytes += sam.Event.capacity() * sizeof(UInt_t) +
+             (sam.X.capacity() + sam.Y.capacity() + sam.Z.capacity() +
+              sam.SampleWeight.capacity()) *
+                 sizeof(double) +
+             sam.Mode.capacity() * sizeof(int) +
+             sam.Custom.capacity() * sizeof(MeasurementVariableBox *);
+    if (sam.Custom.size()) {
+      // Assume clones are at least as big as the sample's own box type
+      bytes += sam.Custom.size() * sizeof(MeasurementVariableBox1D);
+    }
+  }
+  return bytes;
+}
+
+bool SignalEventCache::HasCustomBoxes() const {
+  for (size_t i = 0; i < fSamples.size(); i++) {
+    if (fSamples[i].IsCustom) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SignalEventCache::Write(FILE *f) const {
+  if (HasCustomBoxes()) {
+    return false;
+  }
+
+  uint64_t head[3] = {fSamples.size(), fNEvents, fWordsPerEvent};
+  bool ok = (fwrite(head, sizeof(uint64_t), 3, f) == 3) &&
+            SignalCacheIO::WriteColumn(f, fSampleBits);
+  for (size_t i = 0; ok && i < fSamples.size(); i++) {
+    SampleColumns const &sam = fSamples[i];
+    char typed = sam.IsTyped;
+    ok = (fwrite(&typed, 1, 1, f) == 1) && SignalCacheIO::WriteColumn(f, sam.Event) &&
+         SignalCacheIO::WriteColumn(f, sam.X) && SignalCacheIO::WriteColumn(f, sam.Y) &&
+         SignalCacheIO::WriteColumn(f, sam.Z) && SignalCacheIO::WriteColumn(f, sam.Mode) &&
+         SignalCacheIO::WriteColumn(f, sam.SampleWeight);
+  }
+  return ok;
+}
+
+bool SignalEventCache::Read(FILE *f) {
+  Release();
+
+  uint64_t head[3];
+  if (fread(head, sizeof(uint64_t), 3, f) != 3 || head[0] > (1 << 20)) {
+    return false;
+  }
+  Reset(head[0]);
+  fNEvents = head[1];
+
+  bool ok = (head[2] == fWordsPerEvent) && SignalCacheIO::ReadColumn(f, fSampleBits) &&
+            (fSampleBits.size() == fNEvents * fWordsPerEvent);
+  for (size_t i = 0; ok && i < fSamples.size(); i++) {
+    SampleColumns &sam = fSamples[i];
+    char typed = 0;
+    ok = (fread(&typed, 1, 1, f) == 1) && SignalCacheIO::ReadColumn(f, sam.Event) &&
+         SignalCacheIO::ReadColumn(f, sam.X) && SignalCacheIO::ReadColumn(f, sam.Y) &&
+         SignalCacheIO::ReadColumn(f, sam.Z) && SignalCacheIO::ReadColumn(f, sam.Mode) &&
+         SignalCacheIO::ReadColumn(f, sam.SampleWeight);
+    sam.IsTyped = typed;
+
+    size_t nboxes = sam.Event.size();
+    ok = ok && (sam.X.size() == nboxes) && (sam.Y.size() == nboxes) &&
+         (sam.Z.size() == nboxes) && (sam.Mode.size() == nboxes) &&
+         (sam.SampleWeight.size() == nboxes);
+    for (size_t k = 0; ok && k < nboxes; k++) {
+      ok = sam.Event[k] < fNEvents;
+    }
+  }
+
+  if (!ok) {
+    Release();
+  }
+  return ok;
+}
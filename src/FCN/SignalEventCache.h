@@ -0,0 +1,139 @@
+#ifndef _SIGNAL_EVENT_CACHE_H_
+#define _SIGNAL_EVENT_CACHE_H_
+/*!
+ *  \addtogroup FCN
+ *  @{
+ */
+
+#include "MeasurementBase.h"
+#include "MeasurementVariableBox.h"
+
+#include <stdint.h>
+#include <cstdio>
+#include <vector>
+
+//! Columnar store of the signal boxes saved by JointFCN for fast reconfigures.
+//!
+//! Signal events are numbered in the order they are added. Sample membership
+//! is a bitmap with one row per signal event, and each sample keeps its own
+//! contiguous arrays of event number, X/Y/Z, mode and sample weight so a fast
+//! reconfigure replays each sample linearly. Samples with custom boxes
+//! (extra fields beyond the standard 1D/2D boxes) keep cloned boxes instead.
+class SignalEventCache {
+public:
+  SignalEventCache();
+  ~SignalEventCache();
+
+  //! Drop all cached events and set the number of samples.
+  void Reset(size_t nsamples);
+
+  //! Drop all cached events and free their memory.
+  void Release();
+
+  //! Start a new signal event, returns its number.
+  size_t AddEvent();
+
+  //! Save the box for sample isample against the last added event.
+  void AddBox(size_t isample, MeasurementVariableBox *box);
+
+  inline size_t GetNEvents() const { return fNEvents; };
+  inline size_t GetNSamples() const { return fSamples.size(); };
+
+  //! Whether signal event ievent was signal for sample isample.
+  inline bool IsSignal(size_t ievent, size_t isample) const {
+    return (fSampleBits[ievent * fWordsPerEvent + isample / 64] >>
+            (isample % 64)) &
+           1;
+  };
+
+  //! Number of cached boxes for sample isample.
+  inline size_t GetNBoxes(size_t isample) const {
+    return fSamples[isample].Event.size();
+  };
+
+  //! Fill meas from every cached box of sample isample, weighting each by
+  //! eventweights[signal event number].
+  void Replay(size_t isample, MeasurementBase *meas,
+              double const *eventweights) const;
+
+  //! Approximate heap usage in bytes.
+  size_t GetMemoryBytes() const;
+
+  //! Whether any sample keeps cloned custom boxes, which cannot be written.
+  bool HasCustomBoxes() const;
+
+  //! Write the cache to f in native byte order. False if it has custom boxes
+  //! or the write fails.
+  bool Write(FILE *f) const;
+
+  //! Replace the cache with one written by Write. False, leaving the cache
+  //! empty, if f is short or inconsistent.
+  bool Read(FILE *f);
+
+private:
+  struct SampleColumns {
+    SampleColumns() : IsCustom(false), IsTyped(false){};
+
+    std::vector<UInt_t> Event;
+    std::vector<double> X;
+    std::vector<double> Y;
+    std::vector<double> Z;
+    std::vector<int> Mode;
+    std::vector<double> SampleWeight;
+
+    //! Owned clones, only used for custom boxes
+    std::vector<MeasurementVariableBox *> Custom;
+    bool IsCustom;
+    bool IsTyped;
+  };
+
+  void ClearCustom();
+
+  size_t fNEvents;
+  size_t fWordsPerEvent;
+  std::vector<uint64_t> fSampleBits;
+  std::vector<SampleColumns> fSamples;
+};
+
+//! Binary columns for SignalEventCache::Write and Read, and anything saved
+//! alongside them: a uint64 size followed by the raw elements.
+namespace SignalCacheIO {
+
+template <typename T>
+inline bool WriteColumn(FILE *f, std::vector<T> const &v) {
+  uint64_t n = v.size();
+  return (fwrite(&n, sizeof(n), 1, f) == 1) &&
+         (v.empty() || fwrite(&v[0], sizeof(T), n, f) == n);
+}
+
+//! Bytes between the current position and the end of the file.
+inline uint64_t BytesLeft(FILE *f) {
+  long pos = ftell(f);
+  if ((pos < 0) || fseek(f, 0, SEEK_END)) {
+    return 0;
+  }
+  long end = ftell(f);
+  if (fseek(f, pos, SEEK_SET) || (end < pos)) {
+    return 0;
+  }
+  return uint64_t(end - pos);
+}
+
+template <typename T>
+inline bool ReadColumn(FILE *f, std::vector<T> &v) {
+  uint64_t n = 0;
+  if (fread(&n, sizeof(n), 1, f) != 1) {
+    return false;
+  }
+  // A corrupt size must not be able to ask for more than the file holds
+  if (n > BytesLeft(f) / sizeof(T)) {
+    return false;
+  }
+  v.resize(n);
+  return v.empty() || fread(&v[0], sizeof(T), n, f) == n;
+}
+
+} // namespace SignalCacheIO
+
+/*! @} */
+#endif
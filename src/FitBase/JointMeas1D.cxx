@@ -358,7 +358,7 @@ void JointMeas1D::SetCovarFromDiagonal(TH1D *data) {
   if (data) {
     NUIS_LOG(SAM, "Setting diagonal covariance for: " << data->GetName());
     fFullCovar = StatUtils::MakeDiagonalCovarMatrix(data);
-    covar = StatUtils::GetInvert(fFullCovar,true);
+    covar = StatUtils::GetInvert(fFullCovar,true,true);
     fDecomp = StatUtils::GetDecomp(fFullCovar);
   } else {
     NUIS_ERR(FTL, "No data input provided to set diagonal covar from!");
@@ -378,7 +378,7 @@ void JointMeas1D::SetCovarFromTextFile(std::string covfile, int dim) {
   NUIS_LOG(SAM, "Reading covariance from text file: " << covfile);
   fFullCovar = StatUtils::GetCovarFromTextFile(covfile, dim);
 
-  covar = StatUtils::GetInvert(fFullCovar,true);
+  covar = StatUtils::GetInvert(fFullCovar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -399,7 +399,7 @@ void JointMeas1D::SetCovarFromMultipleTextFiles(std::string covfiles, int dim) {
     (*fFullCovar) += (*temp_cov);
     delete temp_cov;
   }
-  covar = StatUtils::GetInvert(fFullCovar,true);
+  covar = StatUtils::GetInvert(fFullCovar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -411,7 +411,7 @@ void JointMeas1D::SetCovarFromRootFile(std::string covfile,
   NUIS_LOG(SAM,
        "Reading covariance from text file: " << covfile << ";" << histname);
   fFullCovar = StatUtils::GetCovarFromRootFile(covfile, histname);
-  covar = StatUtils::GetInvert(fFullCovar,true);
+  covar = StatUtils::GetInvert(fFullCovar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -421,7 +421,7 @@ void JointMeas1D::SetCovarInvertFromTextFile(std::string covfile, int dim) {
 
   NUIS_LOG(SAM, "Reading inverted covariance from text file: " << covfile);
   covar = StatUtils::GetCovarFromTextFile(covfile, dim);
-  fFullCovar = StatUtils::GetInvert(covar,true);
+  fFullCovar = StatUtils::GetInvert(covar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -433,7 +433,7 @@ void JointMeas1D::SetCovarInvertFromRootFile(std::string covfile,
   NUIS_LOG(SAM, "Reading inverted covariance from text file: " << covfile << ";"
                                                            << histname);
   covar = StatUtils::GetCovarFromRootFile(covfile, histname);
-  fFullCovar = StatUtils::GetInvert(covar,true);
+  fFullCovar = StatUtils::GetInvert(covar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -465,7 +465,7 @@ void JointMeas1D::SetCorrelationFromTextFile(std::string covfile, int dim) {
   }
 
   // Fill other covars.
-  covar = StatUtils::GetInvert(fFullCovar,true);
+  covar = StatUtils::GetInvert(fFullCovar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
   delete correlation;
@@ -500,7 +500,7 @@ void JointMeas1D::SetCorrelationFromMultipleTextFiles(std::string corrfiles,
     (*fFullCovar) += (*temp_cov);
     delete temp_cov;
   }
-  covar = StatUtils::GetInvert(fFullCovar,true);
+  covar = StatUtils::GetInvert(fFullCovar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -531,7 +531,7 @@ void JointMeas1D::SetCorrelationFromRootFile(std::string covfile,
   }
 
   // Fill other covars.
-  covar = StatUtils::GetInvert(fFullCovar,true);
+  covar = StatUtils::GetInvert(fFullCovar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
   delete correlation;
@@ -565,7 +565,7 @@ void JointMeas1D::SetCholDecompFromTextFile(std::string covfile, int dim) {
   (*trans) *= (*temp);
 
   fFullCovar = new TMatrixDSym(dim, trans->GetMatrixArray(), "");
-  covar = StatUtils::GetInvert(fFullCovar,true);
+  covar = StatUtils::GetInvert(fFullCovar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
   delete temp;
@@ -586,7 +586,7 @@ void JointMeas1D::SetCholDecompFromRootFile(std::string covfile,
   (*trans) *= (*temp);
 
   fFullCovar = new TMatrixDSym(temp->GetNrows(), trans->GetMatrixArray(), "");
-  covar = StatUtils::GetInvert(fFullCovar,true);
+  covar = StatUtils::GetInvert(fFullCovar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
   delete temp;
@@ -605,6 +605,7 @@ void JointMeas1D::ScaleCovar(double scale) {
   (*fFullCovar) *= scale;
   (*covar) *= 1.0 / scale;
   (*fDecomp) *= sqrt(scale);
+  fToyThrower.CovarianceChanged();
 }
 
 //********************************************************************
@@ -669,7 +670,7 @@ void JointMeas1D::FinaliseMeasurement() {
   }
 
   if (!covar) {
-    covar = StatUtils::GetInvert(fFullCovar,true);
+    covar = StatUtils::GetInvert(fFullCovar,true,true);
   }
 
   if (!fDecomp) {
@@ -1224,7 +1225,7 @@ void JointMeas1D::ThrowCovariance() {
 
   if (fDataHist)
     delete fDataHist;
-  fDataHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
+  fDataHist = fToyThrower.Throw(fDataTrue, fFullCovar);
 
   return;
 };
@@ -1236,7 +1237,13 @@ void JointMeas1D::ThrowDataToy() {
     fDataTrue = (TH1D *)fDataHist->Clone();
   if (fMCHist)
     delete fMCHist;
-  fMCHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
+  fMCHist = fToyThrower.Throw(fDataTrue, fFullCovar);
+}
+
+//********************************************************************
+void JointMeas1D::SetToySeed(UInt_t seed, int nbatch) {
+  //********************************************************************
+  fToyThrower.SetSeed(seed, nbatch);
 }
 
 /*
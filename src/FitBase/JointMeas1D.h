@@ -56,6 +56,7 @@
 #include "MeasurementBase.h"
 #include "PlotUtils.h"
 #include "StatUtils.h"
+#include "ToyThrower.h"
 
 //********************************************************************
 /// 1D Measurement base class. Histogram handling is done in this base layer.
@@ -409,6 +410,12 @@ public:
   /// so that the likelihood is calculated between data and thrown data
   virtual void ThrowDataToy(void);
 
+  /// \brief Throw later toys from a stream seeded with seed
+  ///
+  /// Toys are then generated nbatch at a time from the cached decomposition
+  /// of fFullCovar, see ToyThrower.
+  virtual void SetToySeed(UInt_t seed, int nbatch);
+
   /*
     Access Functions
   */
@@ -591,6 +598,7 @@ protected:
   TMatrixDSym *covar;       ///< Inverted Covariance
   TMatrixDSym *fFullCovar;  ///< Full Covariance
   TMatrixDSym *fDecomp;     ///< Decomposed Covariance
+  ToyThrower fToyThrower;  ///< Cached decomposition for throws
   TMatrixDSym *fCorrel;     ///< Correlation Matrix
   TMatrixDSym *fShapeCovar; ///< Shape-only covariance
 
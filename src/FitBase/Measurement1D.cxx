@@ -255,7 +255,7 @@ void Measurement1D::SetCovarFromDiagonal(TH1D *data) {
   if (data) {
     NUIS_LOG(SAM, "Setting diagonal covariance for: " << data->GetName());
     fFullCovar = StatUtils::MakeDiagonalCovarMatrix(data);
-    covar = StatUtils::GetInvert(fFullCovar, true);
+    covar = StatUtils::GetInvert(fFullCovar, true, true);
     fDecomp = StatUtils::GetDecomp(fFullCovar);
   } else {
     NUIS_ABORT("No data input provided to set diagonal covar from!");
@@ -272,7 +272,7 @@ void Measurement1D::SetCovarFromTextFile(std::string covfile, int dim) {
 
   NUIS_LOG(SAM, "Reading covariance from text file: " << covfile);
   fFullCovar = StatUtils::GetCovarFromTextFile(covfile, dim);
-  covar = StatUtils::GetInvert(fFullCovar, true);
+  covar = StatUtils::GetInvert(fFullCovar, true, true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -294,7 +294,7 @@ void Measurement1D::SetCovarFromMultipleTextFiles(std::string covfiles,
     (*fFullCovar) += (*temp_cov);
     delete temp_cov;
   }
-  covar = StatUtils::GetInvert(fFullCovar, true);
+  covar = StatUtils::GetInvert(fFullCovar, true, true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -306,7 +306,7 @@ void Measurement1D::SetCovarFromRootFile(std::string covfile,
   NUIS_LOG(SAM,
            "Reading covariance from root file: " << covfile << ";" << histname);
   fFullCovar = StatUtils::GetCovarFromRootFile(covfile, histname);
-  covar = StatUtils::GetInvert(fFullCovar, true);
+  covar = StatUtils::GetInvert(fFullCovar, true, true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -320,7 +320,7 @@ void Measurement1D::SetCovarInvertFromTextFile(std::string covfile, int dim) {
 
   NUIS_LOG(SAM, "Reading inverted covariance from text file: " << covfile);
   covar = StatUtils::GetCovarFromTextFile(covfile, dim);
-  fFullCovar = StatUtils::GetInvert(covar, true);
+  fFullCovar = StatUtils::GetInvert(covar, true, true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -332,7 +332,7 @@ void Measurement1D::SetCovarInvertFromRootFile(std::string covfile,
   NUIS_LOG(SAM, "Reading inverted covariance from text file: " << covfile << ";"
                                                                << histname);
   covar = StatUtils::GetCovarFromRootFile(covfile, histname);
-  fFullCovar = StatUtils::GetInvert(covar, true);
+  fFullCovar = StatUtils::GetInvert(covar, true, true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -364,7 +364,7 @@ void Measurement1D::SetCorrelationFromTextFile(std::string covfile, int dim) {
   }
 
   // Fill other covars.
-  covar = StatUtils::GetInvert(fFullCovar, true);
+  covar = StatUtils::GetInvert(fFullCovar, true, true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
   delete correlation;
@@ -396,7 +396,7 @@ void Measurement1D::SetCorrelationFromMultipleTextFiles(std::string corrfiles,
     (*fFullCovar) += (*temp_cov);
     delete temp_cov;
   }
-  covar = StatUtils::GetInvert(fFullCovar, true);
+  covar = StatUtils::GetInvert(fFullCovar, true, true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -427,7 +427,7 @@ void Measurement1D::SetCorrelationFromRootFile(std::string covfile,
   }
 
   // Fill other covars.
-  covar = StatUtils::GetInvert(fFullCovar, true);
+  covar = StatUtils::GetInvert(fFullCovar, true, true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
   delete correlation;
@@ -449,7 +449,7 @@ void Measurement1D::SetCholDecompFromTextFile(std::string covfile, int dim) {
   (*trans) *= (*temp);
 
   fFullCovar = new TMatrixDSym(dim, trans->GetMatrixArray(), "");
-  covar = StatUtils::GetInvert(fFullCovar, true);
+  covar = StatUtils::GetInvert(fFullCovar, true, true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
   delete temp;
@@ -470,7 +470,7 @@ void Measurement1D::SetCholDecompFromRootFile(std::string covfile,
   (*trans) *= (*temp);
 
   fFullCovar = new TMatrixDSym(temp->GetNrows(), trans->GetMatrixArray(), "");
-  covar = StatUtils::GetInvert(fFullCovar, true);
+  covar = StatUtils::GetInvert(fFullCovar, true, true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
   delete temp;
@@ -515,6 +515,7 @@ void Measurement1D::ScaleCovar(double scale) {
   (*fFullCovar) *= scale;
   (*covar) *= 1.0 / scale;
   (*fDecomp) *= sqrt(scale);
+  fToyThrower.CovarianceChanged();
 }
 
 //********************************************************************
@@ -601,7 +602,7 @@ void Measurement1D::FinaliseMeasurement() {
   }
 
   if (!covar) {
-    covar = StatUtils::GetInvert(fFullCovar, true);
+    covar = StatUtils::GetInvert(fFullCovar, true, true);
   }
 
   if (!fDecomp) {
@@ -616,7 +617,7 @@ void Measurement1D::FinaliseMeasurement() {
   // If shape only, set covar and fDecomp using the shape-only matrix (if set)
   if (fIsShape && fShapeCovar && FitPar::Config().GetParB("UseShapeCovar")) {
     if (covar) delete covar;
-    covar = StatUtils::GetInvert(fShapeCovar, true);
+    covar = StatUtils::GetInvert(fShapeCovar, true, true);
     if (fDecomp) delete fDecomp;
     fDecomp = StatUtils::GetDecomp(fFullCovar);
 
@@ -648,8 +649,8 @@ void Measurement1D::FinaliseMeasurement() {
     fDataNSHist = StatUtils::InitToNS(fDataHist, 1e-38);
     StatUtils::SetDataErrorFromCov(fDataNSHist, fNSCovar, 1e-38, false);
 
-    covar = StatUtils::GetInvert(fNSCovar);
-    fInvNormalCovar = StatUtils::GetInvert(fFullCovar);
+    covar = StatUtils::GetInvert(fNSCovar, false, true);
+    fInvNormalCovar = StatUtils::GetInvert(fFullCovar, false, true);
 
   }
 
@@ -1110,6 +1111,45 @@ void Measurement1D::ApplyNormScale(double norm) {
    Statistic Functions - Outsources to StatUtils
 */
 
+//********************************************************************
+std::vector<TH1 *> Measurement1D::GetFilledHistograms() {
+  //********************************************************************
+
+  std::vector<TH1 *> hists = MeasurementBase::GetFilledHistograms();
+  hists.push_back(fMCStat);
+  return hists;
+}
+
+//********************************************************************
+void Measurement1D::TallyHistogramMemory(MemoryUtils::ByteTally &tally) {
+  //********************************************************************
+
+  MeasurementBase::TallyHistogramMemory(tally);
+
+  tally.Add(fDataTrue);
+  tally.Add(fMCWeighted);
+  tally.Add(fResidualHist);
+  tally.Add(fChi2LessBinHist);
+  if (fMCHist_Modes)
+    fMCHist_Modes->TallyMemory(tally);
+  if (fMCFine_Modes)
+    fMCFine_Modes->TallyMemory(tally);
+}
+
+//********************************************************************
+void Measurement1D::TallyCovarianceMemory(MemoryUtils::ByteTally &tally) {
+  //********************************************************************
+
+  tally.AddMatrix(covar);
+  tally.AddMatrix(fFullCovar);
+  tally.AddMatrix(fShapeCovar);
+  tally.AddMatrix(fCovar);
+  tally.AddMatrix(fInvert);
+  tally.AddMatrix(fDecomp);
+  tally.AddMatrix(fNSCovar);
+  tally.AddMatrix(fInvNormalCovar);
+}
+
 //********************************************************************
 int Measurement1D::GetNDOF() {
   //********************************************************************
@@ -1246,6 +1286,56 @@ double Measurement1D::GetLikelihood() {
   return stat;
 }
 
+//********************************************************************
+void Measurement1D::GetMCBinContents(std::vector<double> &mc) {
+  //********************************************************************
+
+  mc.resize(fMCHist->GetNbinsX());
+  for (int i = 0; i < fMCHist->GetNbinsX(); i++) {
+    mc[i] = fMCHist->GetBinContent(i + 1);
+  }
+}
+
+//********************************************************************
+bool Measurement1D::GetLikelihoodMCGradient(std::vector<double> &mc,
+                                            std::vector<double> &dlike) {
+  //********************************************************************
+
+  // Anything that rescales the MC inside GetLikelihood, or makes the chi2
+  // depend on the MC other than through (data - MC), has no simple form.
+  if (!fIsChi2 || fIsShape || fIsNS || fIsRawEvents ||
+      (fIsMask && fMaskHist)) {
+    return false;
+  }
+  if (FitPar::Config().GetParB("addmcerror") ||
+      FitPar::Config().GetParB("statutils.addmcerror")) {
+    return false;
+  }
+
+  GetMCBinContents(mc);
+  if (fNoData || !fDataHist) {
+    dlike.assign(mc.size(), 0.0);
+    return true;
+  }
+
+  std::vector<double> data(mc.size());
+  for (size_t i = 0; i < mc.size(); i++) {
+    data[i] = fDataHist->GetBinContent(i + 1);
+  }
+
+  if (fIsDiag) {
+    std::vector<double> dataerr(mc.size());
+    for (size_t i = 0; i < mc.size(); i++) {
+      dataerr[i] = fDataHist->GetBinError(i + 1);
+    }
+    StatUtils::GetChi2GradientFromDiag(data, mc, dataerr, dlike);
+  } else {
+    StatUtils::GetChi2GradientFromCov(data, mc, covar, dlike);
+  }
+
+  return true;
+}
+
 /*
   Fake Data Functions
 */
@@ -1317,6 +1407,7 @@ void Measurement1D::SetFakeDataValues(std::string fakeOption) {
   if (fDecomp)
     delete fDecomp;
   fDecomp = StatUtils::GetDecomp(fFullCovar);
+  fToyThrower.CovarianceChanged();
 
   delete tempdata;
 
@@ -1360,7 +1451,7 @@ void Measurement1D::ThrowCovariance() {
     fDataTrue = (TH1D *)fDataHist->Clone();
   if (fDataHist)
     delete fDataHist;
-  fDataHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
+  fDataHist = fToyThrower.Throw(fDataTrue, fFullCovar);
 
   return;
 };
@@ -1372,7 +1463,13 @@ void Measurement1D::ThrowDataToy() {
     fDataTrue = (TH1D *)fDataHist->Clone();
   if (fMCHist)
     delete fMCHist;
-  fMCHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
+  fMCHist = fToyThrower.Throw(fDataTrue, fFullCovar);
+}
+
+//********************************************************************
+void Measurement1D::SetToySeed(UInt_t seed, int nbatch) {
+  //********************************************************************
+  fToyThrower.SetSeed(seed, nbatch);
 }
 
 /*
@@ -55,6 +55,7 @@
 #include "MeasurementBase.h"
 #include "PlotUtils.h"
 #include "StatUtils.h"
+#include "ToyThrower.h"
 
 #include "SignalDef.h"
 #include "MeasurementVariableBox.h"
@@ -391,6 +392,26 @@ public:
   /// Diferent likelihoods definitions are used depending on the FitOptions.
   virtual double GetLikelihood(void);
 
+  /// \brief Derivative of GetLikelihood with respect to each MC bin
+  ///
+  /// Available for the diagonal and covariance chi2 without masking, shape
+  /// scaling, NS covariances or MC errors, where the likelihood is a
+  /// quadratic in the MC and the MC is linear in the event weights.
+  virtual bool GetLikelihoodMCGradient(std::vector<double>& mc,
+                                       std::vector<double>& dlike);
+
+  /// \brief Contents of fMCHist bins 1 to N
+  virtual void GetMCBinContents(std::vector<double>& mc);
+
+  /// \brief Add the histograms and mode stacks held to a memory tally
+  virtual void TallyHistogramMemory(MemoryUtils::ByteTally& tally);
+
+  /// \brief Histograms filled in the event loop, including fMCStat
+  virtual std::vector<TH1*> GetFilledHistograms(void);
+
+  /// \brief Add the covariance matrices held to a memory tally
+  virtual void TallyCovarianceMemory(MemoryUtils::ByteTally& tally);
+
 
   /*
     Fake Data
@@ -431,6 +452,12 @@ public:
   /// so that the likelihood is calculated between data and thrown data
   virtual void ThrowDataToy(void);
 
+  /// \brief Throw later toys from a stream seeded with seed
+  ///
+  /// Toys are then generated nbatch at a time from the cached decomposition
+  /// of fFullCovar, see ToyThrower.
+  virtual void SetToySeed(UInt_t seed, int nbatch);
+
 
   /*
     Access Functions
@@ -601,6 +628,7 @@ public:
   TMatrixDSym* covar;       ///< Inverted Covariance
   TMatrixDSym* fFullCovar;  ///< Full Covariance
   TMatrixDSym* fDecomp;     ///< Decomposed Covariance
+  ToyThrower fToyThrower;  ///< Cached decomposition for throws
   TMatrixDSym* fCorrel;     ///< Correlation Matrix
 
   TMatrixDSym* fShapeCovar;  ///< Shape-only covariance
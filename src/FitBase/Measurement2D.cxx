@@ -32,6 +32,8 @@ Measurement2D::Measurement2D(void) {
   fInvert = NULL;
   fDecomp = NULL;
   fFullCovar = NULL;
+  fShapeCovar = NULL;
+  fCovar = NULL;
 
   fMCHist = NULL;
   fMCFine = NULL;
@@ -50,6 +52,7 @@ Measurement2D::Measurement2D(void) {
 
   fResidualHist = NULL;
   fChi2LessBinHist = NULL;
+  fFlatBinIndexMap = NULL;
 
   fDefaultTypes = "FIX/FULL/CHI2";
   fAllowedTypes =
@@ -313,7 +316,7 @@ void Measurement2D::SetCovarFromDiagonal(TH2D *data) {
   if (data) {
     NUIS_LOG(SAM, "Setting diagonal covariance for: " << data->GetName());
     fFullCovar = StatUtils::MakeDiagonalCovarMatrix(data);
-    covar = StatUtils::GetInvert(fFullCovar,true);
+    covar = StatUtils::GetInvert(fFullCovar,true,true);
     fDecomp = StatUtils::GetDecomp(fFullCovar);
   } else {
     NUIS_ABORT("No data input provided to set diagonal covar from!");
@@ -336,7 +339,7 @@ void Measurement2D::SetCovarFromTextFile(std::string covfile, int dim) {
 
   NUIS_LOG(SAM, "Reading covariance from text file: " << covfile << " " << dim);
   fFullCovar = StatUtils::GetCovarFromTextFile(covfile, dim);
-  covar = StatUtils::GetInvert(fFullCovar,true);
+  covar = StatUtils::GetInvert(fFullCovar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -348,7 +351,7 @@ void Measurement2D::SetCovarFromRootFile(std::string covfile,
   NUIS_LOG(SAM,
            "Reading covariance from text file: " << covfile << ";" << histname);
   fFullCovar = StatUtils::GetCovarFromRootFile(covfile, histname);
-  covar = StatUtils::GetInvert(fFullCovar,true);
+  covar = StatUtils::GetInvert(fFullCovar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -362,7 +365,7 @@ void Measurement2D::SetCovarInvertFromTextFile(std::string covfile, int dim) {
 
   NUIS_LOG(SAM, "Reading inverted covariance from text file: " << covfile);
   covar = StatUtils::GetCovarFromTextFile(covfile, dim);
-  fFullCovar = StatUtils::GetInvert(covar,true);
+  fFullCovar = StatUtils::GetInvert(covar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -374,7 +377,7 @@ void Measurement2D::SetCovarInvertFromRootFile(std::string covfile,
   NUIS_LOG(SAM, "Reading inverted covariance from text file: " << covfile << ";"
                                                                << histname);
   covar = StatUtils::GetCovarFromRootFile(covfile, histname);
-  fFullCovar = StatUtils::GetInvert(covar,true);
+  fFullCovar = StatUtils::GetInvert(covar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 }
 
@@ -406,7 +409,7 @@ void Measurement2D::SetCorrelationFromTextFile(std::string covfile, int dim) {
   }
 
   // Fill other covars.
-  covar = StatUtils::GetInvert(fFullCovar,true);
+  covar = StatUtils::GetInvert(fFullCovar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
   delete correlation;
@@ -439,7 +442,7 @@ void Measurement2D::SetCorrelationFromRootFile(std::string covfile,
   }
 
   // Fill other covars.
-  covar = StatUtils::GetInvert(fFullCovar,true);
+  covar = StatUtils::GetInvert(fFullCovar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
   delete correlation;
@@ -461,7 +464,7 @@ void Measurement2D::SetCholDecompFromTextFile(std::string covfile, int dim) {
   (*trans) *= (*temp);
 
   fFullCovar = new TMatrixDSym(dim, trans->GetMatrixArray(), "");
-  covar = StatUtils::GetInvert(fFullCovar,true);
+  covar = StatUtils::GetInvert(fFullCovar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
   delete temp;
@@ -482,7 +485,7 @@ void Measurement2D::SetCholDecompFromRootFile(std::string covfile,
   (*trans) *= (*temp);
 
   fFullCovar = new TMatrixDSym(temp->GetNrows(), trans->GetMatrixArray(), "");
-  covar = StatUtils::GetInvert(fFullCovar,true);
+  covar = StatUtils::GetInvert(fFullCovar,true,true);
   fDecomp = StatUtils::GetDecomp(fFullCovar);
 
   delete temp;
@@ -615,7 +618,7 @@ void Measurement2D::FinaliseMeasurement() {
   }
 
   if (!covar) {
-    covar = StatUtils::GetInvert(fFullCovar,true);
+    covar = StatUtils::GetInvert(fFullCovar,true,true);
   }
 
   if (!fDecomp) {
@@ -626,7 +629,7 @@ void Measurement2D::FinaliseMeasurement() {
   if (fIsShape && fShapeCovar && FitPar::Config().GetParB("UseShapeCovar")) {
     if (covar)
       delete covar;
-    covar = StatUtils::GetInvert(fShapeCovar,true);
+    covar = StatUtils::GetInvert(fShapeCovar,true,true);
     if (fDecomp)
       delete fDecomp;
     fDecomp = StatUtils::GetDecomp(fFullCovar);
@@ -665,8 +668,8 @@ void Measurement2D::FinaliseMeasurement() {
     fDataNS1DHist = StatUtils::InitToNS(fData1DHist, 1e-38);
     StatUtils::SetDataErrorFromCov(fDataNS1DHist, fNSCovar, 1e-38, false);
 
-    covar = StatUtils::GetInvert(fNSCovar);
-    fInvNormalCovar = StatUtils::GetInvert(fFullCovar);
+    covar = StatUtils::GetInvert(fNSCovar,false,true);
+    fInvNormalCovar = StatUtils::GetInvert(fFullCovar,false,true);
 
   }
 
@@ -1053,6 +1056,54 @@ void Measurement2D::ApplyNormScale(double norm) {
    Statistic Functions - Outsources to StatUtils
 */
 
+//********************************************************************
+std::vector<TH1 *> Measurement2D::GetFilledHistograms() {
+  //********************************************************************
+
+  std::vector<TH1 *> hists = MeasurementBase::GetFilledHistograms();
+  hists.push_back(fMCStat);
+  return hists;
+}
+
+//********************************************************************
+void Measurement2D::TallyHistogramMemory(MemoryUtils::ByteTally &tally) {
+  //********************************************************************
+
+  MeasurementBase::TallyHistogramMemory(tally);
+
+  tally.Add(fDataOrig);
+  tally.Add(fDataTrue);
+  tally.Add(fDataHist_X);
+  tally.Add(fDataHist_Y);
+  tally.Add(fMCHist_X);
+  tally.Add(fMCHist_Y);
+  tally.Add(fMCWeighted);
+  tally.Add(fMapHist);
+  tally.Add(fResidualHist);
+  tally.Add(fChi2LessBinHist);
+  if (fMCHist_Modes)
+    fMCHist_Modes->TallyMemory(tally);
+
+  tally.AddBytes(fFlatBinIndex.capacity() * sizeof(int) +
+                 (fFlatData.capacity() + fFlatDataErr.capacity() +
+                  fFlatMC.capacity() + fFlatMCErr.capacity()) *
+                     sizeof(double));
+}
+
+//********************************************************************
+void Measurement2D::TallyCovarianceMemory(MemoryUtils::ByteTally &tally) {
+  //********************************************************************
+
+  tally.AddMatrix(covar);
+  tally.AddMatrix(fFullCovar);
+  tally.AddMatrix(fShapeCovar);
+  tally.AddMatrix(fCovar);
+  tally.AddMatrix(fInvert);
+  tally.AddMatrix(fDecomp);
+  tally.AddMatrix(fNSCovar);
+  tally.AddMatrix(fInvNormalCovar);
+}
+
 //********************************************************************
 int Measurement2D::GetNDOF() {
   //********************************************************************
@@ -1089,6 +1140,19 @@ int Measurement2D::GetNDOF() {
   return nDOF;
 }
 
+//********************************************************************
+void Measurement2D::FillFlatArrays() {
+  //********************************************************************
+
+  if (fFlatBinIndexMap != fMapHist || fFlatBinIndex.empty()) {
+    StatUtils::GetFlatBinIndex(fDataHist, fMapHist, fFlatBinIndex);
+    fFlatBinIndexMap = fMapHist;
+  }
+
+  StatUtils::FillFlatArray(fDataHist, fFlatBinIndex, fFlatData, &fFlatDataErr);
+  StatUtils::FillFlatArray(fMCHist, fFlatBinIndex, fFlatMC, &fFlatMCErr);
+}
+
 //********************************************************************
 double Measurement2D::GetLikelihood() {
   //********************************************************************
@@ -1134,6 +1198,10 @@ double Measurement2D::GetLikelihood() {
     fMapHist = StatUtils::GenerateMap(fDataHist);
   }
 
+  // Adding MC stats to the covariance needs the histogram path
+  static bool const AddMCErrorToCov =
+      FitPar::Config().GetParB("statutils.addmcerror");
+
   // Get the chi2 from either covar or diagonals
   double chi2 = 0.0;
 
@@ -1149,8 +1217,17 @@ double Measurement2D::GetLikelihood() {
 
       // ***** end NS covar modifications *****
     } else if (fIsDiag) {
-      chi2 =
-          StatUtils::GetChi2FromDiag(fDataHist, fMCHist, fMapHist, fMaskHist);
+      if (!fMaskHist) {
+        FillFlatArrays();
+        chi2 = StatUtils::GetChi2FromDiag(fFlatData, fFlatMC, fFlatDataErr,
+                                          fFlatMCErr);
+      } else {
+        chi2 = StatUtils::GetChi2FromDiag(fDataHist, fMCHist, fMapHist,
+                                          fMaskHist);
+      }
+    } else if (!fMaskHist && !fIsWriting && !AddMCErrorToCov) {
+      FillFlatArrays();
+      chi2 = StatUtils::GetChi2FromCov(fFlatData, fFlatMC, covar);
     } else {
       chi2 = StatUtils::GetChi2FromCov(fDataHist, fMCHist, covar, fMapHist,
                                        fMaskHist,
@@ -1343,6 +1420,8 @@ void Measurement2D::ThrowCovariance() {
   // Take a fDecomposition and use it to throw the current dataset.
   // Requires fDataTrue also be set incase used repeatedly.
 
+  if (!fDataTrue)
+    fDataTrue = (TH2D *)fDataHist->Clone();
   if (fDataHist)
     delete fDataHist;
   fDataHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
@@ -387,6 +387,15 @@ public:
   /// Diferent likelihoods definitions are used depending on the FitOptions.
   virtual double GetLikelihood(void);
 
+  /// \brief Add the histograms and mode stacks held to a memory tally
+  virtual void TallyHistogramMemory(MemoryUtils::ByteTally& tally);
+
+  /// \brief Histograms filled in the event loop, including fMCStat
+  virtual std::vector<TH1*> GetFilledHistograms(void);
+
+  /// \brief Add the covariance matrices held to a memory tally
+  virtual void TallyCovarianceMemory(MemoryUtils::ByteTally& tally);
+
   /*
     Fake Data
   */
@@ -420,6 +429,10 @@ public:
   /// Call ResetFakeData or ResetData to return to values before the throw.
   virtual void ThrowCovariance(void);
 
+  /// \brief 2D histograms can not yet be thrown from a covariance, so
+  /// ThrowCovariance leaves the data as it was.
+  virtual bool CanThrowCovariance(void) { return false; };
+
   /// \brief Throw the data by its assigned errors and assign this to MC
   ///
   /// Used when creating data toys by assign the MC to this thrown data
@@ -568,6 +581,18 @@ public:
   TH2D *fResidualHist;
   TH2D *fChi2LessBinHist;
 
+  /// Global fDataHist bin for each covariance row, built once from fMapHist
+  /// so that likelihood evaluations run on flat arrays.
+  std::vector<int> fFlatBinIndex;
+  TH2I *fFlatBinIndexMap; //!< map fFlatBinIndex was built from
+  std::vector<double> fFlatData;    //!< data contents in covariance order
+  std::vector<double> fFlatDataErr; //!< data errors in covariance order
+  std::vector<double> fFlatMC;      //!< MC contents in covariance order
+  std::vector<double> fFlatMCErr;   //!< MC errors in covariance order
+
+  /// Rebuild the flat index if fMapHist changed and refill the flat arrays.
+  void FillFlatArrays();
+
   bool fIsFakeData;         //!< is current data actually fake
   std::string fakeDataFile; //!< MC fake data input file
 
@@ -33,6 +33,7 @@ MeasurementBase::MeasurementBase(void) {
   fNoData = false;
   fInput = NULL;
   NSignal = 0;
+  fTimingID = -1;
 
   // Set the default values
   // After-wards this gets set in SetupMeasurement
@@ -237,8 +238,15 @@ void MeasurementBase::Reconfigure() {
     Mode = cust_event->Mode;
 
     // Extract Measurement Variables
-    this->FillEventVariables(cust_event);
-    Signal = this->isSignal(cust_event);
+    {
+      TimingUtils::ScopedTimer timer(GetTimingID(),
+                                     TimingUtils::kFillEventVariables);
+      this->FillEventVariables(cust_event);
+    }
+    {
+      TimingUtils::ScopedTimer timer(GetTimingID(), TimingUtils::kIsSignal);
+      Signal = this->isSignal(cust_event);
+    }
     if (Signal)
       npassed++;
 
@@ -283,6 +291,8 @@ void MeasurementBase::Reconfigure() {
 
   // Finalise Histograms
   fMCFilled = true;
+  TimingUtils::ScopedTimer timer(GetTimingID(),
+                                 TimingUtils::kConvertEventRates);
   this->ConvertEventRates();
 }
 
@@ -294,12 +304,21 @@ void MeasurementBase::FillHistogramsFromBox(MeasurementVariableBox *var,
   Weight = weight;
   fEventVariables = var;
 
+  TimingUtils::ScopedTimer timer(GetTimingID(), TimingUtils::kFillHistograms);
   FillHistograms();
   FillExtraHistograms(var, weight);
 }
 
+void MeasurementBase::FillHistogramsFromCachedBox(MeasurementVariableBox *var,
+                                                  double weight) {
+  MeasurementVariableBox *own = GetBox();
+  FillHistogramsFromBox(var, weight);
+  fEventVariables = own;
+}
+
 void MeasurementBase::FillHistograms(double weight) {
   Weight = weight * GetBox()->GetSampleWeight();
+  TimingUtils::ScopedTimer timer(GetTimingID(), TimingUtils::kFillHistograms);
   FillHistograms();
   FillExtraHistograms(GetBox(), Weight);
 }
@@ -309,8 +328,15 @@ MeasurementVariableBox *MeasurementBase::FillVariableBox(FitEvent *event) {
   Mode = event->Mode;
   Weight = 1.0; // event->Weight;
 
-  this->FillEventVariables(event);
-  Signal = this->isSignal(event);
+  {
+    TimingUtils::ScopedTimer timer(GetTimingID(),
+                                   TimingUtils::kFillEventVariables);
+    this->FillEventVariables(event);
+  }
+  {
+    TimingUtils::ScopedTimer timer(GetTimingID(), TimingUtils::kIsSignal);
+    Signal = this->isSignal(event);
+  }
 
   GetBox()->FillBoxFromEvent(event);
 
@@ -324,6 +350,49 @@ MeasurementVariableBox *MeasurementBase::FillVariableBox(FitEvent *event) {
   return GetBox();
 }
 
+int MeasurementBase::GetTimingID() {
+  if (!TimingUtils::IsEnabled()) {
+    return -1;
+  }
+  if (fTimingID < 0) {
+    fTimingID = TimingUtils::Register("Sample", fName);
+  }
+  return fTimingID;
+}
+
+void MeasurementBase::TallyHistogramMemory(MemoryUtils::ByteTally &tally) {
+  std::vector<TH1 *> hists = GetDataList();
+  std::vector<TH1 *> mc = GetMCList();
+  std::vector<TH1 *> fine = GetFineList();
+  std::vector<TH1 *> mask = GetMaskList();
+  hists.insert(hists.end(), mc.begin(), mc.end());
+  hists.insert(hists.end(), fine.begin(), fine.end());
+  hists.insert(hists.end(), mask.begin(), mask.end());
+  for (size_t i = 0; i < hists.size(); i++) {
+    tally.Add(hists[i]);
+  }
+
+  std::map<StackBase *, std::vector<int> >::iterator iter =
+      fExtraTH1s.begin();
+  for (; iter != fExtraTH1s.end(); iter++) {
+    iter->first->TallyMemory(tally);
+  }
+}
+
+std::vector<TH1 *> MeasurementBase::GetFilledHistograms() {
+  std::vector<TH1 *> hists = GetMCList();
+  std::vector<TH1 *> fine = GetFineList();
+  hists.insert(hists.end(), fine.begin(), fine.end());
+
+  std::map<StackBase *, std::vector<int> >::iterator iter =
+      fExtraTH1s.begin();
+  for (; iter != fExtraTH1s.end(); iter++) {
+    std::vector<TH1 *> const &stack = iter->first->fAllHists;
+    hists.insert(hists.end(), stack.begin(), stack.end());
+  }
+  return hists;
+}
+
 MeasurementVariableBox *MeasurementBase::GetBox() {
   if (!fEventVariables)
     fEventVariables = CreateBox();
@@ -77,6 +77,8 @@
 #include "SampleSettings.h"
 #include "StackBase.h"
 #include "StandardStacks.h"
+#include "MemoryUtils.h"
+#include "TimingUtils.h"
 
 /// Enumerations to help with extra plot functions
 enum extraplotflags {
@@ -138,9 +140,30 @@ public:
 
   // virtual TH2D GetCovarMatrix(void) = 0;
   virtual double GetLikelihood(void) { return 0.0; };
+  //! Fill mc with the converted MC prediction, and dlike with the
+  //! derivative of GetLikelihood with respect to each of its entries.
+  //! Returns false when the likelihood has no analytic form in the MC, in
+  //! which case JointFCN::Gradient finite differences the likelihood.
+  virtual bool GetLikelihoodMCGradient(std::vector<double> &mc,
+                                       std::vector<double> &dlike) {
+    (void)mc;
+    (void)dlike;
+    return false;
+  };
+  //! Converted MC prediction in GetLikelihoodMCGradient order.
+  virtual void GetMCBinContents(std::vector<double> &mc) { mc.clear(); };
   virtual int GetNDOF(void) { return 0; };
   virtual void ThrowCovariance(void) = 0;
+  //! Whether ThrowCovariance actually fluctuates the data. Samples whose
+  //! throw leaves the data unchanged override this.
+  virtual bool CanThrowCovariance(void) { return true; };
   virtual void ThrowDataToy(void) = 0;
+  //! Seed a private stream for later toys, thrown nbatch at a time where
+  //! the sample supports it.
+  virtual void SetToySeed(UInt_t seed, int nbatch) {
+    (void)seed;
+    (void)nbatch;
+  };
   virtual void SetFakeDataValues(std::string fkdt) = 0;
 
   //! Get the total integrated flux between this samples energy range
@@ -186,6 +209,11 @@ public:
   /// sample)
   virtual void FillEventVariables(FitEvent* event) { (void)event; };
 
+  //! Whether FillEventVariables/isSignal read the generator-level event
+  //! (e.g. genie_event), which events replayed from the EventStore do not
+  //! carry. Samples that look past the FitEvent record override this.
+  virtual bool NeedsGeneratorEvent() { return false; };
+
   ///! Check whether this event is signle (Handled in each inherited sample)
   virtual bool isSignal(FitEvent* event) {
     (void)event;
@@ -214,6 +242,9 @@ public:
   virtual MeasurementVariableBox* GetBox();
 
   void FillHistogramsFromBox(MeasurementVariableBox* var, double weight);
+  ///! As FillHistogramsFromBox, but keeps this sample's own box afterwards so
+  ///! var can be owned elsewhere.
+  void FillHistogramsFromCachedBox(MeasurementVariableBox* var, double weight);
   /*
     Histogram Access Functions
   */
@@ -241,6 +272,21 @@ public:
   std::string GetName(void) { return fName; };
   double GetScaleFactor(void) { return fScaleFactor; };
 
+  ///! TimingUtils id of this sample, -1 if profiling is disabled
+  int GetTimingID(void);
+
+  ///! Add the histograms and stacks this sample holds to tally
+  virtual void TallyHistogramMemory(MemoryUtils::ByteTally& tally);
+
+  ///! Histograms written to by FillHistograms during an event loop, before
+  ///! ConvertEventRates. JointFCN workers sum these across event slices.
+  virtual std::vector<TH1*> GetFilledHistograms(void);
+
+  ///! Add the covariance matrices this sample holds to tally
+  virtual void TallyCovarianceMemory(MemoryUtils::ByteTally& tally) {
+    (void)tally;
+  };
+
   double GetXVar(void) { return fXVar; };
   double GetYVar(void) { return fYVar; };
   double GetZVar(void) { return fZVar; };
@@ -311,6 +357,7 @@ protected:
 
   std::string fName; //!< Name of the sample
   int fEventType;
+  int fTimingID;     //!< TimingUtils id for hot path timings
 
   double fBeamDistance;  //!< Incoming Particle flight distance (for oscillation
   //! analysis)
@@ -6,7 +6,7 @@ class MeasurementVariableBox {
 public:
   
   MeasurementVariableBox() {};
-  ~MeasurementVariableBox() {};
+  virtual ~MeasurementVariableBox() {};
 
   virtual void Reset();
   virtual void FillBoxFromEvent(FitEvent* evt);
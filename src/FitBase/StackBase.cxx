@@ -88,6 +88,12 @@ void StackBase::Reset() {
   }
 };
 
+void StackBase::TallyMemory(MemoryUtils::ByteTally &tally) {
+  for (size_t i = 0; i < fAllHists.size(); i++) {
+    tally.Add(fAllHists[i]);
+  }
+}
+
 void StackBase::FillStack(int index, double x, double y, double z,
                           double weight) {
   if (index < 0 or (UInt_t) index >= fAllLabels.size()) {
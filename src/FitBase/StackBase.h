@@ -11,6 +11,7 @@
 #include "TH3.h"
 #include "THStack.h"
 
+#include "MemoryUtils.h"
 #include "PlotUtils.h"
 
 class StackBase {
@@ -57,6 +58,9 @@ public:
   virtual TH1 *GetHist(std::string label);
   virtual THStack GetStack();
 
+  /// Add the stack histograms to a memory tally
+  void TallyMemory(MemoryUtils::ByteTally &tally);
+
   std::string GetType() { return fType; };
 
   std::string fName;
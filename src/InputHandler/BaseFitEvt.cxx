@@ -36,6 +36,7 @@ BaseFitEvt::BaseFitEvt() {
   }
 
   fSplineCoeff = NULL;
+  fSplineMask = NULL;
   fSplineRead = NULL;
 
   fGenInfo = NULL;
@@ -109,6 +110,7 @@ BaseFitEvt::BaseFitEvt(const BaseFitEvt *obj) {
   }
 
   fSplineCoeff = obj->fSplineCoeff;
+  fSplineMask = obj->fSplineMask;
   fSplineRead = obj->fSplineRead;
 
   fGenInfo = obj->fGenInfo;
@@ -150,6 +152,7 @@ BaseFitEvt::BaseFitEvt(BaseFitEvt const &other) {
   }
 
   fSplineCoeff = other.fSplineCoeff;
+  fSplineMask = other.fSplineMask;
   fSplineRead = other.fSplineRead;
 
   fGenInfo = other.fGenInfo;
@@ -191,6 +194,7 @@ BaseFitEvt BaseFitEvt::operator=(BaseFitEvt const &other) {
     CustomWeightArray[i] = other.CustomWeightArray[i];
   }
   fSplineCoeff = other.fSplineCoeff;
+  fSplineMask = other.fSplineMask;
   fSplineRead = other.fSplineRead;
 
   fGenInfo = other.fGenInfo;
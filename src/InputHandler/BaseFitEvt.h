@@ -93,6 +93,7 @@ class BaseFitEvt {
 
   // Spline Info Coefficients and Readers
   float* fSplineCoeff; ///< ND Array of Spline Coefficients
+  UInt_t* fSplineMask; ///< Response mask if fSplineCoeff is packed, else NULL
   SplineReader* fSplineRead; ///< Spline Interpretter
 
   // Generator Info
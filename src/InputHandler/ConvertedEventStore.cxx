@@ -0,0 +1,320 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+#include "ConvertedEventStore.h"
+
+#include "FitLogger.h"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+
+void ConvertedEventStore::Block::Clear() {
+  Headers.clear();
+  Mom.clear();
+  PDG.clear();
+  State.clear();
+  Primary.clear();
+}
+
+size_t ConvertedEventStore::Block::Bytes() const {
+  return Headers.capacity() * sizeof(EventHeader) +
+         Mom.capacity() * sizeof(float) + PDG.capacity() * sizeof(int) +
+         State.capacity() + Primary.capacity();
+}
+
+ConvertedEventStore::ConvertedEventStore(double budgetmb,
+                                         std::string const &spilldir)
+    : fBudgetBytes(budgetmb * 1024.0 * 1024.0), fSpillDir(spilldir),
+      fValid(true), fComplete(false), fNEvents(0), fSpillFile(NULL),
+      fReadBlockIndex(-1), fMemBytes(0), fSpillBytes(0) {
+
+  if (fSpillDir.empty()) {
+    char const *tmpdir = getenv("TMPDIR");
+    fSpillDir = tmpdir ? tmpdir : "/tmp";
+  }
+}
+
+ConvertedEventStore::~ConvertedEventStore() {
+  // The spill file was unlinked when it was opened
+  if (fSpillFile) {
+    fclose(fSpillFile);
+  }
+}
+
+void ConvertedEventStore::Reset() {
+  fMemBlocks.clear();
+  fFillBlock.Clear();
+  fReadBlock.Clear();
+  fReadBlockIndex = -1;
+  fSpillOffsets.clear();
+  if (fSpillFile) {
+    fclose(fSpillFile);
+    fSpillFile = NULL;
+  }
+  fValid = true;
+  fComplete = false;
+  fNEvents = 0;
+  fMemBytes = 0;
+  fSpillBytes = 0;
+}
+
+void ConvertedEventStore::Invalidate() {
+  Reset();
+  fValid = false;
+}
+
+bool ConvertedEventStore::Add(FitEvent const *evt) {
+  if (!fValid || fComplete) {
+    return false;
+  }
+
+  if (evt->fNParticles > std::numeric_limits<UShort_t>::max()) {
+    fValid = false;
+    return false;
+  }
+
+  EventHeader hdr;
+  hdr.InputWeight = evt->InputWeight;
+  hdr.ProbeE = evt->probe_E;
+  hdr.TotCrs = evt->fTotCrs;
+  hdr.Mode = evt->Mode;
+  hdr.ProbePDG = evt->probe_pdg;
+  hdr.TargetA = evt->fTargetA;
+  hdr.TargetZ = evt->fTargetZ;
+  hdr.TargetH = evt->fTargetH;
+  hdr.TargetPDG = evt->fTargetPDG;
+  hdr.ResCode = evt->fResCode;
+  hdr.Distance = evt->fDistance;
+  hdr.EventNo = evt->fEventNo;
+  hdr.FirstParticle = fFillBlock.PDG.size();
+  hdr.NParticles = evt->fNParticles;
+  hdr.Bound = evt->fBound;
+  fFillBlock.Headers.push_back(hdr);
+
+  for (int i = 0; i < evt->fNParticles; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      fFillBlock.Mom.push_back(evt->fParticleMom[i][j]);
+    }
+    fFillBlock.PDG.push_back(evt->fParticlePDG[i]);
+    fFillBlock.State.push_back(evt->fParticleState[i]);
+    fFillBlock.Primary.push_back(evt->fPrimaryVertex[i]);
+  }
+
+  fNEvents++;
+  if (fFillBlock.Headers.size() == kBlockSize) {
+    CloseBlock();
+  }
+  return fValid;
+}
+
+void ConvertedEventStore::Finalise() {
+  if (!fValid) {
+    return;
+  }
+  if (fFillBlock.Headers.size()) {
+    CloseBlock();
+  }
+  // Blocks are read back from the descriptor, not through the FILE buffer
+  if (fSpillFile && fflush(fSpillFile)) {
+    NUIS_ERR(WRN, "Failed to flush the event store spill file, the event "
+                  "store is disabled for this input.");
+    fValid = false;
+  }
+  fComplete = fValid;
+}
+
+void ConvertedEventStore::CloseBlock() {
+
+  // Trim the vectors so Bytes() reflects what is actually held
+  Block blk;
+  blk.Headers.assign(fFillBlock.Headers.begin(), fFillBlock.Headers.end());
+  blk.Mom.assign(fFillBlock.Mom.begin(), fFillBlock.Mom.end());
+  blk.PDG.assign(fFillBlock.PDG.begin(), fFillBlock.PDG.end());
+  blk.State.assign(fFillBlock.State.begin(), fFillBlock.State.end());
+  blk.Primary.assign(fFillBlock.Primary.begin(), fFillBlock.Primary.end());
+  fFillBlock.Clear();
+
+  size_t bytes = blk.Bytes();
+
+  // Keep blocks in memory in entry order until the budget is used, after
+  // that everything goes to the spill file.
+  if (fSpillOffsets.empty() && (double(fMemBytes + bytes) <= fBudgetBytes)) {
+    fMemBytes += bytes;
+    fMemBlocks.push_back(blk);
+    return;
+  }
+
+  if (!fSpillFile && !OpenSpillFile()) {
+    fValid = false;
+    return;
+  }
+
+  if (!WriteBlock(blk)) {
+    NUIS_ERR(WRN, "Failed to spill converted events to disk, the event "
+                  "store is disabled for this input.");
+    fValid = false;
+  }
+}
+
+bool ConvertedEventStore::OpenSpillFile() {
+  std::string templ = fSpillDir + "/nuisance_evtstore_XXXXXX";
+  std::vector<char> name(templ.begin(), templ.end());
+  name.push_back('\0');
+
+  int fd = mkstemp(&name[0]);
+  if (fd < 0) {
+    NUIS_ERR(WRN, "Could not create event store spill file in " << fSpillDir);
+    return false;
+  }
+  // Nothing else should see it, and it must not outlive the process.
+  unlink(&name[0]);
+
+  fSpillFile = fdopen(fd, "w+b");
+  if (!fSpillFile) {
+    close(fd);
+    return false;
+  }
+
+  NUIS_LOG(SAM, "Event store exceeded its memory budget, spilling to "
+                    << fSpillDir);
+  return true;
+}
+
+namespace {
+template <typename T>
+bool WriteVector(FILE *f, std::vector<T> const &v) {
+  size_t n = v.size();
+  if (fwrite(&n, sizeof(n), 1, f) != 1) {
+    return false;
+  }
+  return !n || (fwrite(v.data(), sizeof(T), n, f) == n);
+}
+
+// Reads go through pread so they never touch the shared file offset, a
+// forked worker and its parent can both read back the same spill file.
+bool ReadAt(int fd, off_t &pos, void *buf, size_t len) {
+  char *dst = static_cast<char *>(buf);
+  while (len) {
+    ssize_t n = pread(fd, dst, len, pos);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    dst += n;
+    pos += n;
+    len -= n;
+  }
+  return true;
+}
+
+template <typename T> bool ReadVector(int fd, off_t &pos, std::vector<T> &v) {
+  size_t n;
+  if (!ReadAt(fd, pos, &n, sizeof(n))) {
+    return false;
+  }
+  v.resize(n);
+  return !n || ReadAt(fd, pos, &v[0], n * sizeof(T));
+}
+} // namespace
+
+bool ConvertedEventStore::WriteBlock(Block const &blk) {
+  if (fseek(fSpillFile, 0, SEEK_END)) {
+    return false;
+  }
+  long start = ftell(fSpillFile);
+
+  bool ok = WriteVector(fSpillFile, blk.Headers) &&
+            WriteVector(fSpillFile, blk.Mom) &&
+            WriteVector(fSpillFile, blk.PDG) &&
+            WriteVector(fSpillFile, blk.State) &&
+            WriteVector(fSpillFile, blk.Primary);
+
+  if (ok) {
+    fSpillOffsets.push_back(start);
+    fSpillBytes += ftell(fSpillFile) - start;
+  }
+  return ok;
+}
+
+bool ConvertedEventStore::ReadBlock(size_t ispill, Block &blk) {
+  int fd = fileno(fSpillFile);
+  off_t pos = fSpillOffsets[ispill];
+  return ReadVector(fd, pos, blk.Headers) && ReadVector(fd, pos, blk.Mom) &&
+         ReadVector(fd, pos, blk.PDG) && ReadVector(fd, pos, blk.State) &&
+         ReadVector(fd, pos, blk.Primary);
+}
+
+bool ConvertedEventStore::Fill(size_t i, FitEvent *evt) {
+  if (!fComplete || (i >= fNEvents)) {
+    return false;
+  }
+
+  size_t iblock = i / kBlockSize;
+  size_t ievt = i % kBlockSize;
+
+  Block const *blk = NULL;
+  if (iblock < fMemBlocks.size()) {
+    blk = &fMemBlocks[iblock];
+  } else {
+    long ispill = iblock - fMemBlocks.size();
+    if (fReadBlockIndex != ispill) {
+      if (!ReadBlock(ispill, fReadBlock)) {
+        NUIS_ABORT("Failed to read back spilled converted events.");
+      }
+      fReadBlockIndex = ispill;
+    }
+    blk = &fReadBlock;
+  }
+
+  EventHeader const &hdr = blk->Headers[ievt];
+
+  // Clears cached FitParticles from the previous entry
+  evt->ResetEvent();
+
+  evt->InputWeight = hdr.InputWeight;
+  evt->probe_E = hdr.ProbeE;
+  evt->probe_pdg = hdr.ProbePDG;
+  evt->fTotCrs = hdr.TotCrs;
+  evt->Mode = hdr.Mode;
+  evt->fTargetA = hdr.TargetA;
+  evt->fTargetZ = hdr.TargetZ;
+  evt->fTargetH = hdr.TargetH;
+  evt->fTargetPDG = hdr.TargetPDG;
+  evt->fResCode = hdr.ResCode;
+  evt->fDistance = hdr.Distance;
+  evt->fEventNo = hdr.EventNo;
+  evt->fBound = hdr.Bound;
+
+  evt->fNParticles = hdr.NParticles;
+  for (int p = 0; p < evt->fNParticles; ++p) {
+    size_t k = hdr.FirstParticle + p;
+    for (int j = 0; j < 4; ++j) {
+      evt->fParticleMom[p][j] = blk->Mom[4 * k + j];
+    }
+    evt->fParticlePDG[p] = blk->PDG[k];
+    evt->fParticleState[p] = blk->State[k];
+    evt->fPrimaryVertex[p] = blk->Primary[k];
+  }
+
+  return true;
+}
@@ -0,0 +1,128 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+#ifndef CONVERTEDEVENTSTORE_H
+#define CONVERTEDEVENTSTORE_H
+/*!
+ *  \addtogroup InputHandler
+ *  @{
+ */
+#include "FitEvent.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/// Compact copy of the converted FitEvent particle stacks for one input.
+///
+/// Filled in entry order on the first full pass over an input, later passes
+/// replay the stored stacks instead of reading and converting the generator
+/// tree again. Momenta are stored as floats and states/vertex flags as bytes.
+/// Events are kept in blocks; once the memory budget is used up, further
+/// blocks are written to an unlinked temporary file and read back one block
+/// at a time on replay.
+class ConvertedEventStore {
+public:
+  /// Budget in MB, spill directory defaults to $TMPDIR or /tmp.
+  ConvertedEventStore(double budgetmb, std::string const &spilldir = "");
+  ~ConvertedEventStore();
+
+  /// Drop anything stored and start filling again from entry 0.
+  void Reset();
+
+  /// Append the converted event for entry Size(). Returns false if the event
+  /// cannot be represented, after which the store is unusable.
+  bool Add(FitEvent const *evt);
+
+  /// Mark the store as holding every entry of the input.
+  void Finalise();
+
+  /// Drop anything stored and refuse further events until Reset().
+  void Invalidate();
+
+  /// Overwrite the particle stack and event information of evt with entry i.
+  /// Entries should be requested in order to avoid re-reading spilled blocks.
+  bool Fill(size_t i, FitEvent *evt);
+
+  inline size_t Size() const { return fNEvents; };
+  inline bool IsComplete() const { return fComplete; };
+  inline bool IsValid() const { return fValid; };
+
+  /// Bytes held in memory and written to the spill file.
+  inline size_t MemoryBytes() const { return fMemBytes; };
+  inline size_t SpillBytes() const { return fSpillBytes; };
+
+private:
+  struct EventHeader {
+    double InputWeight;
+    float ProbeE;
+    float TotCrs;
+    int Mode;
+    int ProbePDG;
+    int TargetA;
+    int TargetZ;
+    int TargetH;
+    int TargetPDG;
+    int ResCode;
+    int Distance;
+    UInt_t EventNo;
+    UInt_t FirstParticle; ///< Offset into the block particle arrays
+    UShort_t NParticles;
+    bool Bound;
+  };
+
+  struct Block {
+    std::vector<EventHeader> Headers;
+    std::vector<float> Mom; ///< px, py, pz, E per particle
+    std::vector<int> PDG;
+    std::vector<UChar_t> State;
+    std::vector<UChar_t> Primary;
+
+    void Clear();
+    size_t Bytes() const;
+  };
+
+  /// Move the block being filled into memory or the spill file.
+  void CloseBlock();
+  bool WriteBlock(Block const &blk);
+  bool ReadBlock(size_t ispill, Block &blk);
+  bool OpenSpillFile();
+
+  static const size_t kBlockSize = 16384;
+
+  double fBudgetBytes;
+  std::string fSpillDir;
+
+  bool fValid;
+  bool fComplete;
+  size_t fNEvents;
+
+  std::vector<Block> fMemBlocks;
+  Block fFillBlock;
+
+  FILE *fSpillFile;
+  std::vector<long> fSpillOffsets;
+  Block fReadBlock;
+  long fReadBlockIndex;
+
+  size_t fMemBytes;
+  size_t fSpillBytes;
+};
+
+/*! @} */
+#endif
@@ -59,6 +59,47 @@ void FitEvent::AllocateParticleStack(int stacksize) {
     fGenInfo->AllocateParticleStack(kMaxParticles);
 }
 
+void FitEvent::CopyEventFrom(FitEvent const *evt) {
+  if (kMaxParticles < UInt_t(evt->fNParticles)) {
+    ExpandParticleStack(evt->kMaxParticles);
+  }
+  ResetEvent();
+
+  Mode = evt->Mode;
+  probe_E = evt->probe_E;
+  probe_pdg = evt->probe_pdg;
+  fType = evt->fType;
+
+  Weight = evt->Weight;
+  InputWeight = evt->InputWeight;
+  RWWeight = evt->RWWeight;
+  CustomWeight = evt->CustomWeight;
+  SavedRWWeight = evt->SavedRWWeight;
+  for (int i = 0; i < 6; i++) {
+    CustomWeightArray[i] = evt->CustomWeightArray[i];
+  }
+
+  fEventNo = evt->fEventNo;
+  fTotCrs = evt->fTotCrs;
+  fTargetA = evt->fTargetA;
+  fTargetZ = evt->fTargetZ;
+  fTargetH = evt->fTargetH;
+  fBound = evt->fBound;
+  fDistance = evt->fDistance;
+  fTargetPDG = evt->fTargetPDG;
+  fResCode = evt->fResCode;
+
+  fNParticles = evt->fNParticles;
+  for (int i = 0; i < fNParticles; i++) {
+    for (int j = 0; j < 4; j++) {
+      fParticleMom[i][j] = evt->fParticleMom[i][j];
+    }
+    fParticleState[i] = evt->fParticleState[i];
+    fParticlePDG[i] = evt->fParticlePDG[i];
+    fPrimaryVertex[i] = evt->fPrimaryVertex[i];
+  }
+}
+
 void FitEvent::ExpandParticleStack(int stacksize) {
   DeallocateParticleStack();
   AllocateParticleStack(stacksize);
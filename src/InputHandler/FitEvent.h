@@ -59,6 +59,9 @@ public:
   void AllocateParticleStack(int stacksize);
   void ExpandParticleStack(int stacksize);
   void AddGeneratorInfo(GeneratorInfoBase* gen);
+  /// Copy the event information, weights and particle stack of evt.
+  /// Generator event pointers are not copied.
+  void CopyEventFrom(FitEvent const* evt);
 
 
   // ---- HELPER/ACCESS FUNCTIONS ---- //
@@ -84,6 +87,18 @@ public:
   TLorentzVector GetParticleP4    (int index) const;
   /// Return Particle 3-momentum for given index in particle stack
   TVector3       GetParticleP3    (int index) const;
+  /// Return Particle 4-momentum for given index, without a TObject
+  inline FitVector4 GetParticleVec4(int index) const {
+    if (index == -1 or index >= fNParticles) return FitVector4(0, 0, 0, 0);
+    return FitVector4(fParticleMom[index][0], fParticleMom[index][1],
+                      fParticleMom[index][2], fParticleMom[index][3]);
+  }
+  /// Return Particle 3-momentum for given index, without a TObject
+  inline FitVector3 GetParticleVec3(int index) const {
+    if (index == -1 or index >= fNParticles) return FitVector3(0, 0, 0);
+    return FitVector3(fParticleMom[index][0], fParticleMom[index][1],
+                      fParticleMom[index][2]);
+  }
   /// Return Particle absolute momentum for given index in particle stack
   double         GetParticleMom   (int index) const;
   /// Return Particle absolute momentum-squared for given index in particle stack
@@ -629,6 +644,7 @@ public:
   int                   GetBeamNeutrinoIndex   (void) const;
   inline TLorentzVector GetBeamNeutrinoP4      (void) const { return GetParticleP4(GetBeamNeutrinoIndex()); }
   inline TVector3       GetBeamNeutrinoP3      (void) const { return GetParticleP3(GetBeamNeutrinoIndex()); }
+  inline FitVector4     GetBeamNeutrinoVec4    (void) const { return GetParticleVec4(GetBeamNeutrinoIndex()); }
   inline double         GetBeamNeutrinoMom     (void) const { return GetParticleMom(GetBeamNeutrinoIndex()); }
   inline double         GetBeamNeutrinoMom2    (void) const { return GetParticleMom2(GetBeamNeutrinoIndex()); }
   inline double         GetBeamNeutrinoE       (void) const { return GetParticleE(GetBeamNeutrinoIndex()); }
@@ -23,6 +23,7 @@
  *  @{
  */
 
+#include "FitVector.h"
 #include "TLorentzVector.h"
 
 #include <iostream>
@@ -76,11 +77,17 @@ class FitParticle {
   inline double E  (void) const { return fP.E(); };
 
   /// Get 4 Momentum
-  inline TLorentzVector P4(void)  const {return fP;};
+  inline TLorentzVector const& P4(void)  const {return fP;};
 
   /// Get 3 Momentum
   inline TVector3       P3(void)  const {return fP.Vect();};
 
+  /// Get 4 Momentum without constructing a TObject
+  inline FitVector4     Vec4(void) const {return FitVector4(fP);};
+
+  /// Get 3 Momentum without constructing a TObject
+  inline FitVector3     Vec3(void) const {return FitVector3(fP.X(), fP.Y(), fP.Z());};
+
   /// Get 3 momentum magnitude
   inline double         p(void)  const { return fP.Vect().Mag(); };
 
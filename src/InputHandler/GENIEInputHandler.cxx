@@ -256,6 +256,10 @@ void GENIEInputHandler::CreateCache() {
   }
 }
 
+size_t GENIEInputHandler::GetCacheBytes() {
+  return InputHandlerBase::GetCacheBytes() + fGENIETree->GetCacheSize();
+}
+
 void GENIEInputHandler::RemoveCache() {
   // fGENIETree->SetCacheEntryRange(0, fNEvents);
   fGENIETree->AddBranchToCache("*", 0);
@@ -84,6 +84,9 @@ public:
   /// Remove TTree Cache to save memory
   void RemoveCache();
 
+  /// TTree cache and event store bytes
+  size_t GetCacheBytes();
+
   /// Returns a NUISANCE format event from the GENIE TTree. If !lightweight
   /// then CalcNUISANCEKinematics() is called to convert the GENIE event into
   /// a standard NUISANCE format.
@@ -18,6 +18,7 @@
  *******************************************************************************/
 #include "InputHandler.h"
 #include "InputUtils.h"
+#include "TimingUtils.h"
 
 InputHandlerBase::InputHandlerBase() {
   fName = "";
@@ -31,7 +32,10 @@ InputHandlerBase::InputHandlerBase() {
   kRemoveNuclearParticles = FitPar::Config().GetParB("RemoveNuclearParticles");
   fMaxEvents = FitPar::Config().GetParI("MAXEVENTS");
   fTTreePerformance = NULL;
+  fEventStore = NULL;
+  fUseEventStore = false;
   fSkip = 0;
+  fTimingID = -1;
   if (FitPar::Config().HasConfig("NSKIPEVENTS")) {
     fSkip = FitPar::Config().GetParI("NSKIPEVENTS");
   }
@@ -50,6 +54,7 @@ InputHandlerBase::~InputHandlerBase() {
   jointindexhigh.clear();
   jointindexallowed.clear();
   jointindexscale.clear();
+  ClearEventStore();
 
   //  if (fTTreePerformance) {
   //    fTTreePerformance->SaveAs(("ttreeperfstats_" + fName +
@@ -167,19 +172,104 @@ std::vector<TH1 *> InputHandlerBase::GetXSecList(void) {
 };
 
 FitEvent *InputHandlerBase::FirstNuisanceEvent() {
+  TimingUtils::ScopedTimer timer(GetTimingID(), TimingUtils::kReadEvent);
   fCurrentIndex = 0;
-  return GetNuisanceEvent(fCurrentIndex);
+
+  if (fUseEventStore) {
+    if (fEventStore->IsComplete()) {
+      return StoredNuisanceEvent();
+    }
+    // Any previous partial pass is thrown away and the store refilled.
+    fEventStore->Reset();
+  }
+
+  return StoreNuisanceEvent(GetNuisanceEvent(fCurrentIndex));
 };
 
 FitEvent *InputHandlerBase::NextNuisanceEvent() {
+  TimingUtils::ScopedTimer timer(GetTimingID(), TimingUtils::kReadEvent);
   fCurrentIndex++;
   if ((fMaxEvents != -1) && (fCurrentIndex > fMaxEvents)) {
-    return NULL;
+    return StoreNuisanceEvent(NULL);
   }
 
-  return GetNuisanceEvent(fCurrentIndex);
+  if (fUseEventStore && fEventStore->IsComplete()) {
+    return StoredNuisanceEvent();
+  }
+
+  return StoreNuisanceEvent(GetNuisanceEvent(fCurrentIndex));
 };
 
+void InputHandlerBase::EnableEventStore(bool enable) {
+  fUseEventStore = enable;
+  if (fUseEventStore && !fEventStore) {
+    fEventStore =
+        new ConvertedEventStore(FitPar::Config().GetParD("EventStore_MaxMB"),
+                                FitPar::Config().GetParS("EventStore_SpillDir"));
+  }
+}
+
+void InputHandlerBase::ClearEventStore() {
+  if (fEventStore) {
+    delete fEventStore;
+  }
+  fEventStore = NULL;
+  fUseEventStore = false;
+}
+
+FitEvent *InputHandlerBase::StoreNuisanceEvent(FitEvent *evt) {
+  if (!fUseEventStore || !fEventStore->IsValid() ||
+      fEventStore->IsComplete()) {
+    return evt;
+  }
+
+  if (!evt) {
+    fEventStore->Finalise();
+    NUIS_LOG(SAM, "Stored " << fEventStore->Size() << " converted events for "
+                            << fName << " ("
+                            << fEventStore->MemoryBytes() / (1024 * 1024)
+                            << " MB in memory, "
+                            << fEventStore->SpillBytes() / (1024 * 1024)
+                            << " MB on disk).");
+    return NULL;
+  }
+
+  // Events must arrive in entry order, generator extras and input spline
+  // coefficients are not stored so inputs using them are never replayed.
+  if ((evt != fNUISANCEEvent) || (size_t(fCurrentIndex) != fEventStore->Size()) ||
+      evt->fGenInfo || evt->fSplineRead || !fEventStore->Add(evt)) {
+    NUIS_LOG(SAM, "Input " << fName
+                           << " cannot use the converted event store.");
+    fEventStore->Invalidate();
+  }
+
+  return evt;
+}
+
+FitEvent *InputHandlerBase::StoredNuisanceEvent() {
+  if (!fEventStore->Fill(fCurrentIndex, fNUISANCEEvent)) {
+    return NULL;
+  }
+  return fNUISANCEEvent;
+}
+
+size_t InputHandlerBase::GetCacheBytes() {
+  if (!fEventStore) {
+    return 0;
+  }
+  return fEventStore->MemoryBytes();
+}
+
+int InputHandlerBase::GetTimingID() {
+  if (!TimingUtils::IsEnabled()) {
+    return -1;
+  }
+  if (fTimingID < 0) {
+    fTimingID = TimingUtils::Register("Input", fName);
+  }
+  return fTimingID;
+}
+
 BaseFitEvt *InputHandlerBase::FirstBaseEvent() {
   fCurrentIndex = 0;
   return GetBaseEvent(fCurrentIndex);
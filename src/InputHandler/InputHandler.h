@@ -23,6 +23,7 @@
  *  @{
  */
 #include "BaseFitEvt.h"
+#include "ConvertedEventStore.h"
 #include "FitEvent.h"
 #include "TH1D.h"
 #include "TTreePerfStats.h"
@@ -72,11 +73,26 @@ public:
   inline virtual void CreateCache(){};
   /// Placeholder to remove optional cache to free up memory
   inline virtual void RemoveCache(){};
+  /// Give a forked process its own handles on any non-ROOT files this input
+  /// reads, so it does not move the file offsets shared with its parent.
+  /// Inputs read through ROOT are covered by FCNWorkers::ReopenROOTFiles.
+  inline virtual void ReopenFiles(){};
 
   /// Return starting NUISANCE event pointer (entry=0)
   FitEvent *FirstNuisanceEvent();
   /// Iterate to next NUISANCE event. Returns NULL when entry > fNEvents.
   FitEvent *NextNuisanceEvent();
+
+  /// Serve First/NextNuisanceEvent from a store of converted events that is
+  /// filled on the first full pass. Only valid if nothing downstream needs
+  /// the generator-level event (e.g. generator reweighting engines).
+  void EnableEventStore(bool enable);
+  /// Free the converted event store.
+  void ClearEventStore();
+  /// TimingUtils id of this input, -1 if profiling is disabled
+  int GetTimingID();
+  /// Bytes held by read caches and the converted event store.
+  virtual size_t GetCacheBytes();
   /// Returns starting Base Event Pointer (entry=0)
   BaseFitEvt *FirstBaseEvent();
   /// Iterate to next NUISANCE Base Event. Returns NULL when entry > fNEvents.
@@ -130,6 +146,16 @@ public:
   bool kRemoveNuclearParticles;
   TTreePerfStats *fTTreePerformance;
   int fSkip;
+  int fTimingID; ///< TimingUtils id, registered on first timed read
+
+protected:
+  /// Adds evt to the event store if it is being filled.
+  FitEvent *StoreNuisanceEvent(FitEvent *evt);
+  /// Fill fNUISANCEEvent from the event store.
+  FitEvent *StoredNuisanceEvent();
+
+  ConvertedEventStore *fEventStore;
+  bool fUseEventStore;
 };
 /*! @} */
 #endif
@@ -183,6 +183,10 @@ void NEUTInputHandler::CreateCache() {
   }
 }
 
+size_t NEUTInputHandler::GetCacheBytes() {
+  return InputHandlerBase::GetCacheBytes() + fNEUTTree->GetCacheSize();
+}
+
 void NEUTInputHandler::RemoveCache() {
   // fNEUTTree->SetCacheEntryRange(0, fNEvents);
   fNEUTTree->AddBranchToCache("vectorbranch", 0);
@@ -54,6 +54,9 @@ public:
 	/// Remove TTree Cache to save memory
 	void RemoveCache();
 
+	/// TTree cache and event store bytes
+	size_t GetCacheBytes();
+
 	/// Convert NEUT particle status codes to NUISANCE format status
 	int GetNeutParticleStatus(NeutPart* part);
 
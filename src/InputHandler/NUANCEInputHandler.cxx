@@ -125,6 +125,10 @@ void NUANCEInputHandler::CreateCache() {
   }
 }
 
+size_t NUANCEInputHandler::GetCacheBytes() {
+  return InputHandlerBase::GetCacheBytes() + fNUANCETree->GetCacheSize();
+}
+
 void NUANCEInputHandler::RemoveCache() {
   fNUANCETree->SetCacheEntryRange(0, fNEvents);
   fNUANCETree->AddBranchToCache("h3", 0);
@@ -76,6 +76,9 @@ public:
 	/// Remove TTree Cache to save memory
 	void RemoveCache();
 
+	/// TTree cache and event store bytes
+	size_t GetCacheBytes();
+
 	/// Print event information
 	void Print();
 
@@ -10,15 +10,193 @@
 #include "NuHepMC/HepMC3Features.hxx"
 
 #include "HepMC3/Print.h"
+#include "HepMC3/ReaderAscii.h"
 #include "HepMC3/ReaderFactory.h"
 
+#include "OpenMPWrapper.h"
+
+#include <sys/stat.h>
+
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
+namespace {
+char const NuHepMCIndexMagic[8] = {'N', 'U', 'I', 'S', 'H', 'M', 'C', 'I'};
+uint32_t const NuHepMCIndexVersion = 1;
+
+bool StatFile(std::string const &filename, uint64_t &size, int64_t &mtime) {
+  struct stat st;
+  if (stat(filename.c_str(), &st)) {
+    return false;
+  }
+  size = st.st_size;
+  mtime = st.st_mtime;
+  return true;
+}
+
+bool IsCompressedName(std::string const &filename) {
+  static char const *exts[] = {".gz", ".bz2", ".xz", ".zst", ".lzma"};
+  for (char const *ext : exts) {
+    size_t len = strlen(ext);
+    if ((filename.size() > len) &&
+        !filename.compare(filename.size() - len, len, ext)) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+std::string
+NuHepMCInputHandler::GetOffsetIndexName(std::string const &filename) {
+  return filename + ".nuisidx";
+}
+
+bool NuHepMCInputHandler::BuildOffsetIndex(
+    std::string const &filename, std::vector<std::streamoff> &offsets) {
+
+  offsets.clear();
+
+  // Only plain HepMC3 ASCII can be repositioned with seekg
+  if (IsCompressedName(filename)) {
+    return false;
+  }
+
+  std::ifstream ifs(filename, std::ios::binary);
+  if (!ifs.good()) {
+    return false;
+  }
+
+  std::string line;
+  std::streamoff pos = 0;
+  bool isascii3 = false;
+  while (std::getline(ifs, line)) {
+    if (!isascii3) {
+      if (!line.compare(0, 34, "HepMC::Asciiv3-START_EVENT_LISTING")) {
+        isascii3 = true;
+      } else if (!line.empty() && line.compare(0, 5, "HepMC")) {
+        // Anything other than the HepMC3 ASCII preamble
+        return false;
+      }
+    } else if ((line.size() > 1) && (line[0] == 'E') && (line[1] == ' ')) {
+      offsets.push_back(pos);
+    }
+    // getline strips the newline but it still has to be counted
+    pos += line.size() + 1;
+  }
+
+  return isascii3;
+}
+
+bool NuHepMCInputHandler::ReadOffsetIndex(
+    std::string const &filename, std::vector<std::streamoff> &offsets) {
+
+  offsets.clear();
+
+  uint64_t size;
+  int64_t mtime;
+  if (!StatFile(filename, size, mtime)) {
+    return false;
+  }
+
+  std::ifstream ifs(GetOffsetIndexName(filename), std::ios::binary);
+  if (!ifs.good()) {
+    return false;
+  }
+
+  char magic[8];
+  uint32_t version;
+  uint64_t idx_size, nevents;
+  int64_t idx_mtime;
+  ifs.read(magic, 8);
+  ifs.read(reinterpret_cast<char *>(&version), sizeof(version));
+  ifs.read(reinterpret_cast<char *>(&idx_size), sizeof(idx_size));
+  ifs.read(reinterpret_cast<char *>(&idx_mtime), sizeof(idx_mtime));
+  ifs.read(reinterpret_cast<char *>(&nevents), sizeof(nevents));
+
+  if (!ifs.good() || memcmp(magic, NuHepMCIndexMagic, 8) ||
+      (version != NuHepMCIndexVersion)) {
+    NUIS_ERR(WRN, "Ignoring unrecognised offset index: "
+                      << GetOffsetIndexName(filename));
+    return false;
+  }
+
+  if ((idx_size != size) || (idx_mtime != mtime)) {
+    NUIS_ERR(WRN, "Offset index: " << GetOffsetIndexName(filename)
+                                   << " is older than " << filename
+                                   << ", it will be rebuilt.");
+    return false;
+  }
+
+  // Check the event count against what is on disk before allocating for it,
+  // every event takes at least a byte of the input and 8 of the index.
+  std::streamoff start = ifs.tellg();
+  ifs.seekg(0, std::ios::end);
+  std::streamoff remaining = ifs.tellg() - start;
+  ifs.seekg(start);
+  if (!ifs.good() || (remaining < 0) || (nevents > size) ||
+      (nevents > uint64_t(remaining) / sizeof(uint64_t))) {
+    NUIS_ERR(WRN, "Truncated offset index: " << GetOffsetIndexName(filename));
+    return false;
+  }
+
+  std::vector<uint64_t> raw(nevents);
+  ifs.read(reinterpret_cast<char *>(raw.data()), nevents * sizeof(uint64_t));
+  if (!ifs.good()) {
+    NUIS_ERR(WRN, "Truncated offset index: " << GetOffsetIndexName(filename));
+    return false;
+  }
+
+  for (size_t i = 0; i < raw.size(); ++i) {
+    if (raw[i] >= size) {
+      NUIS_ERR(WRN, "Ignoring corrupt offset index: "
+                        << GetOffsetIndexName(filename));
+      return false;
+    }
+  }
+
+  offsets.assign(raw.begin(), raw.end());
+  return true;
+}
+
+bool NuHepMCInputHandler::WriteOffsetIndex(
+    std::string const &filename, std::vector<std::streamoff> const &offsets) {
+
+  uint64_t size;
+  int64_t mtime;
+  if (!StatFile(filename, size, mtime)) {
+    return false;
+  }
+
+  std::ofstream ofs(GetOffsetIndexName(filename),
+                    std::ios::binary | std::ios::trunc);
+  if (!ofs.good()) {
+    return false;
+  }
+
+  uint64_t nevents = offsets.size();
+  std::vector<uint64_t> raw(offsets.begin(), offsets.end());
+
+  ofs.write(NuHepMCIndexMagic, 8);
+  ofs.write(reinterpret_cast<char const *>(&NuHepMCIndexVersion),
+            sizeof(NuHepMCIndexVersion));
+  ofs.write(reinterpret_cast<char const *>(&size), sizeof(size));
+  ofs.write(reinterpret_cast<char const *>(&mtime), sizeof(mtime));
+  ofs.write(reinterpret_cast<char const *>(&nevents), sizeof(nevents));
+  ofs.write(reinterpret_cast<char const *>(raw.data()),
+            nevents * sizeof(uint64_t));
+
+  return ofs.good();
+}
+
 NuHepMCInputHandler::~NuHepMCInputHandler() {}
 
 NuHepMCInputHandler::NuHepMCInputHandler(std::string const &handle,
                                          std::string const &rawinputs)
-    : frun_info(nullptr) {
+    : frun_info(nullptr), nextentry(0), fDecodedEntry(kNoEntry),
+      fDecodeChunkSize(0), fChunkFirst(0), fPrevChunkFirst(0) {
 
   NUIS_LOG(SAM, "Creating NuHepMCInputHandler : " << handle);
 
@@ -94,10 +272,196 @@ NuHepMCInputHandler::NuHepMCInputHandler(std::string const &handle,
   fBaseEvent = static_cast<BaseFitEvt *>(fNUISANCEEvent);
 
   fReader = HepMC3::deduce_reader(fFilename);
+
+  // Random access: try the sidecar index first, then scan the file for event
+  // records. Anything that is not plain HepMC3 ASCII falls back to
+  // reopen-and-skip for non-sequential reads.
+  if (FitPar::Config().GetParB("NuHepMC_OffsetIndex")) {
+    if (!ReadOffsetIndex(fFilename, fEventOffsets)) {
+      if (BuildOffsetIndex(fFilename, fEventOffsets) &&
+          (fEventOffsets.size() == size_t(fNEvents)) &&
+          FitPar::Config().GetParB("NuHepMC_WriteOffsetIndex")) {
+        if (WriteOffsetIndex(fFilename, fEventOffsets)) {
+          NUIS_LOG(SAM, "Wrote NuHepMC offset index: "
+                            << GetOffsetIndexName(fFilename));
+        } else {
+          NUIS_ERR(WRN, "Could not write NuHepMC offset index: "
+                            << GetOffsetIndexName(fFilename)
+                            << ", it will be rebuilt next time.");
+        }
+      }
+    }
+
+    if (fEventOffsets.size() != size_t(fNEvents)) {
+      if (fEventOffsets.size()) {
+        NUIS_ERR(WRN, "NuHepMC offset index found "
+                          << fEventOffsets.size() << " events, but the reader "
+                          << "found " << fNEvents << ", disabling it.");
+      } else {
+        NUIS_LOG(SAM, "Input " << fFilename
+                               << " cannot be indexed, non-sequential reads "
+                                  "will rewind the file.");
+      }
+      fEventOffsets.clear();
+    } else if (!OpenSeekableReader(fSeekReader)) {
+      NUIS_ERR(WRN, "Failed to open " << fFilename << " for random access.");
+      fEventOffsets.clear();
+    }
+  }
+
+  if (fEventOffsets.size()) {
+    int chunk = FitPar::Config().GetParI("NuHepMC_DecodeChunkSize");
+    fDecodeChunkSize = (chunk > 1) ? UInt_t(chunk) : 0;
+    if (fDecodeChunkSize) {
+      NUIS_LOG(SAM, "Decoding NuHepMC events in chunks of "
+                        << fDecodeChunkSize << " on up to "
+                        << omp_get_max_threads() << " threads.");
+    }
+  }
 };
 
+bool NuHepMCInputHandler::OpenSeekableReader(SeekableReader &sr) {
+  sr.Stream = std::make_shared<std::ifstream>(fFilename, std::ios::binary);
+  if (!sr.Stream->good()) {
+    return false;
+  }
+  sr.Reader = std::make_shared<HepMC3::ReaderAscii>(
+      std::static_pointer_cast<std::istream>(sr.Stream));
+
+  // Reading the first event consumes the run info header, after which the
+  // stream can be repositioned on any event record.
+  HepMC3::GenEvent evt;
+  sr.Reader->read_event(evt);
+  return !sr.Reader->failed();
+}
+
+void NuHepMCInputHandler::ReopenFiles() {
+  // The std::ifstreams were inherited with the parent's open file
+  // descriptions, so every seek and read here would move its offsets too.
+  fReader = HepMC3::deduce_reader(fFilename);
+  nextentry = 0;
+
+  if (fSeekReader.Reader && !OpenSeekableReader(fSeekReader)) {
+    NUIS_ABORT("Failed to reopen " << fFilename << " for random access.");
+  }
+
+  // Opened again on first use by DecodeChunk
+  fThreadReaders.clear();
+}
+
+bool NuHepMCInputHandler::ReadEventAt(SeekableReader &sr, UInt_t entry,
+                                      HepMC3::GenEvent &evt) {
+  if (entry >= fEventOffsets.size()) {
+    return false;
+  }
+  // Clear eof from running off the end of the previous read
+  sr.Stream->clear();
+  sr.Stream->seekg(fEventOffsets[entry]);
+  sr.Reader->read_event(evt);
+  return !sr.Reader->failed();
+}
+
+bool NuHepMCInputHandler::DecodeChunk(UInt_t first) {
+
+  UInt_t last = std::min(UInt_t(fEventOffsets.size()), first + fDecodeChunkSize);
+  if (first >= last) {
+    return false;
+  }
+
+  int nthreads = omp_get_max_threads();
+  if (fThreadReaders.size() != size_t(nthreads)) {
+    fThreadReaders.resize(nthreads);
+    fThreadEvents.resize(nthreads);
+  }
+
+  // The outgoing chunk becomes the previous one, and its buffer is reused
+  fChunk.swap(fPrevChunk);
+  std::swap(fChunkFirst, fPrevChunkFirst);
+  fChunk.resize(last - first);
+  fChunkFirst = first;
+
+  bool failed = false;
+#ifdef __USE_OPENMP__
+#pragma omp parallel for schedule(static)
+#endif
+  for (int i = 0; i < int(last - first); ++i) {
+    int tid = omp_get_thread_num();
+    DecodedEvent &dev = fChunk[i];
+    dev.Valid = false;
+
+    SeekableReader &sr = fThreadReaders[tid];
+    if (!sr.Reader && !OpenSeekableReader(sr)) {
+      failed = true;
+      continue;
+    }
+    if (!ReadEventAt(sr, first + i, fThreadEvents[tid])) {
+      continue;
+    }
+    DecodeEvent(fThreadEvents[tid], fToMeV, dev);
+  }
+
+  if (failed) {
+    NUIS_ABORT("Failed to open " << fFilename << " for parallel decoding.");
+  }
+  return true;
+}
+
 FitEvent *NuHepMCInputHandler::GetNuisanceEvent(const UInt_t entry, bool) {
 
+  DecodedEvent const *dev = &fDecoded;
+
+  if (fDecodeChunkSize) {
+    // Events are converted a chunk at a time over all threads, the per-entry
+    // work left here is a copy into the FitEvent stack.
+    if ((entry >= fPrevChunkFirst) &&
+        (entry < fPrevChunkFirst + fPrevChunk.size())) {
+      fChunk.swap(fPrevChunk);
+      std::swap(fChunkFirst, fPrevChunkFirst);
+    } else if ((entry < fChunkFirst) ||
+               (entry >= fChunkFirst + fChunk.size())) {
+      if (!DecodeChunk(entry - (entry % fDecodeChunkSize))) {
+        return NULL;
+      }
+    }
+    dev = &fChunk[entry - fChunkFirst];
+    if (!dev->Valid) {
+      return NULL;
+    }
+  } else if (entry == fDecodedEntry) {
+    // Asked for the same event again, e.g. a base event then its FitEvent
+  } else if (fEventOffsets.size()) {
+    fDecodedEntry = kNoEntry;
+    if (!ReadEventAt(fSeekReader, entry, fHepMC3Evt)) {
+      return NULL;
+    }
+    DecodeEvent(fHepMC3Evt, fToMeV, fDecoded);
+    fDecodedEntry = entry;
+  } else {
+    fDecodedEntry = kNoEntry;
+    if (!ReadNextEvent(entry)) {
+      return NULL;
+    }
+    fDecodedEntry = entry;
+  }
+
+  // Setup Input scaling for joint inputs
+  if (jointinput) {
+    fNUISANCEEvent->InputWeight = GetInputWeight(entry);
+  } else {
+    fNUISANCEEvent->InputWeight = 1.0;
+  }
+
+  fNUISANCEEvent->InputWeight *= dev->Weight * double(fNEvents) / fsumevw;
+
+  // Run NUISANCE Vector Filler
+  FillNUISANCEEvent(*dev);
+
+  // Return event pointer
+  return fNUISANCEEvent;
+}
+
+bool NuHepMCInputHandler::ReadNextEvent(const UInt_t entry) {
+
   int ntoskip = 0;
 
   if (nextentry != entry) {
@@ -120,38 +484,30 @@ FitEvent *NuHepMCInputHandler::GetNuisanceEvent(const UInt_t entry, bool) {
 
   // Catch too large entries
   if (fReader->failed()) {
-    return NULL;
-  }
-
-  // Setup Input scaling for joint inputs
-  if (jointinput) {
-    fNUISANCEEvent->InputWeight = GetInputWeight(entry);
-  } else {
-    fNUISANCEEvent->InputWeight = 1.0;
+    return false;
   }
 
-  fNUISANCEEvent->InputWeight *=
-      fHepMC3Evt.weights()[0] * double(fNEvents) / fsumevw;
-
-  // Run NUISANCE Vector Filler
-  CalcNUISANCEKinematics();
-
-  // Return event pointer
-  return fNUISANCEEvent;
+  DecodeEvent(fHepMC3Evt, fToMeV, fDecoded);
+  return true;
 }
 
 void NuHepMCInputHandler::CalcNUISANCEKinematics() {
+  DecodeEvent(fHepMC3Evt, fToMeV, fDecoded);
+  FillNUISANCEEvent(fDecoded);
+}
 
-  // Reset all variables
-  fNUISANCEEvent->ResetEvent();
-
-  fNUISANCEEvent->Mode = NuHepMC::ER3::ReadProcessID(fHepMC3Evt);
+void NuHepMCInputHandler::DecodeEvent(HepMC3::GenEvent const &evt,
+                                      double tomev, DecodedEvent &dev) {
 
-  fNUISANCEEvent->fEventNo = fHepMC3Evt.event_number();
+  dev.Valid = true;
+  dev.Mode = NuHepMC::ER3::ReadProcessID(evt);
+  dev.EventNo = evt.event_number();
+  dev.HasTarget = false;
+  dev.Weight = evt.weights()[0];
 
-  // Read all particles from fHepMCEvent
-  fNUISANCEEvent->fNParticles = 0;
-  for (auto const &p : fHepMC3Evt.particles()) {
+  // Read all particles from the HepMC3 event, keeps capacity between events
+  dev.Particles.clear();
+  for (auto const &p : evt.particles()) {
 
     int status = 0;
 
@@ -166,10 +522,10 @@ void NuHepMCInputHandler::CalcNUISANCEKinematics() {
 
       status = kNuclearInitial;
 
-      fNUISANCEEvent->fTargetA = (p->pid() / 10) % 1000;
-      fNUISANCEEvent->fTargetZ = (p->pid() / 10000) % 1000;
-      fNUISANCEEvent->fTargetH = 0;
-      fNUISANCEEvent->fBound = (p->pid() == 1000010010);
+      dev.HasTarget = true;
+      dev.TargetA = (p->pid() / 10) % 1000;
+      dev.TargetZ = (p->pid() / 10000) % 1000;
+      dev.Bound = (p->pid() == 1000010010);
 
     } else if (p->status() == NuHepMC::ParticleStatus::StruckNucleon) {
       status = kInitialState;
@@ -180,22 +536,54 @@ void NuHepMCInputHandler::CalcNUISANCEKinematics() {
       continue;
     }
 
-    fNUISANCEEvent->fPrimaryVertex[fNUISANCEEvent->fNParticles] =
+    DecodedParticle dp;
+    dp.PrimaryVertex =
         (p->production_vertex()->status() == NuHepMC::VertexStatus::Primary);
 
     // Mom
-    fNUISANCEEvent->fParticleMom[fNUISANCEEvent->fNParticles][0] =
-        p->momentum().px() * fToMeV;
-    fNUISANCEEvent->fParticleMom[fNUISANCEEvent->fNParticles][1] =
-        p->momentum().py() * fToMeV;
-    fNUISANCEEvent->fParticleMom[fNUISANCEEvent->fNParticles][2] =
-        p->momentum().pz() * fToMeV;
-    fNUISANCEEvent->fParticleMom[fNUISANCEEvent->fNParticles][3] =
-        p->momentum().e() * fToMeV;
+    dp.Mom[0] = p->momentum().px() * tomev;
+    dp.Mom[1] = p->momentum().py() * tomev;
+    dp.Mom[2] = p->momentum().pz() * tomev;
+    dp.Mom[3] = p->momentum().e() * tomev;
+
+    // PDG
+    dp.PDG = p->pid();
+    dp.State = status;
+
+    dev.Particles.push_back(dp);
+  }
+}
+
+void NuHepMCInputHandler::FillNUISANCEEvent(DecodedEvent const &dev) {
+
+  // Reset all variables
+  fNUISANCEEvent->ResetEvent();
+
+  fNUISANCEEvent->Mode = dev.Mode;
+  fNUISANCEEvent->fEventNo = dev.EventNo;
+
+  if (dev.HasTarget) {
+    fNUISANCEEvent->fTargetA = dev.TargetA;
+    fNUISANCEEvent->fTargetZ = dev.TargetZ;
+    fNUISANCEEvent->fTargetH = 0;
+    fNUISANCEEvent->fBound = dev.Bound;
+  }
+
+  fNUISANCEEvent->fNParticles = 0;
+  for (auto const &dp : dev.Particles) {
+    UInt_t i = fNUISANCEEvent->fNParticles;
+
+    fNUISANCEEvent->fPrimaryVertex[i] = dp.PrimaryVertex;
+
+    // Mom
+    fNUISANCEEvent->fParticleMom[i][0] = dp.Mom[0];
+    fNUISANCEEvent->fParticleMom[i][1] = dp.Mom[1];
+    fNUISANCEEvent->fParticleMom[i][2] = dp.Mom[2];
+    fNUISANCEEvent->fParticleMom[i][3] = dp.Mom[3];
 
     // PDG
-    fNUISANCEEvent->fParticlePDG[fNUISANCEEvent->fNParticles] = p->pid();
-    fNUISANCEEvent->fParticleState[fNUISANCEEvent->fNParticles] = status;
+    fNUISANCEEvent->fParticlePDG[i] = dp.PDG;
+    fNUISANCEEvent->fParticleState[i] = dp.State;
 
     // Add up particle count
     fNUISANCEEvent->fNParticles++;
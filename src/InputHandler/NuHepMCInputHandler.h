@@ -5,14 +5,16 @@
 #include "HepMC3/Reader.h"
 #include "HepMC3/GenEvent.h"
 
+#include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
 
 /// NEUT Input Convertor to read in NeutVects and convert to FitEvents
 class NuHepMCInputHandler : public InputHandlerBase {
 public:
 
-  NuHepMCInputHandler(){}
+  NuHepMCInputHandler() : nextentry(0) {}
 	NuHepMCInputHandler(std::string const& handle, std::string const& rawinputs);
 	~NuHepMCInputHandler();
 
@@ -26,6 +28,61 @@ public:
 
 	double GetInputWeight(const UInt_t entry);
 
+  void ReopenFiles();
+
+  /// Name of the sidecar offset index written next to a NuHepMC file.
+  static std::string GetOffsetIndexName(std::string const &filename);
+
+  /// Scans an uncompressed HepMC3 ASCII file for the byte offset of every
+  /// event record. Returns false if the file cannot be randomly accessed.
+  static bool BuildOffsetIndex(std::string const &filename,
+                               std::vector<std::streamoff> &offsets);
+
+  /// Reads the sidecar index, returns false if it is missing or stale.
+  static bool ReadOffsetIndex(std::string const &filename,
+                              std::vector<std::streamoff> &offsets);
+
+  /// Writes the sidecar index, returns false if it could not be written.
+  static bool WriteOffsetIndex(std::string const &filename,
+                               std::vector<std::streamoff> const &offsets);
+
+  /// Intermediate, generator-independent copy of the particle stack so that
+  /// HepMC3 events can be converted away from the main thread.
+  struct DecodedParticle {
+    double Mom[4];
+    int PDG;
+    UInt_t State;
+    bool PrimaryVertex;
+  };
+
+  struct DecodedEvent {
+    bool Valid;
+    int Mode;
+    UInt_t EventNo;
+    bool HasTarget;
+    int TargetA;
+    int TargetZ;
+    bool Bound;
+    double Weight;
+    std::vector<DecodedParticle> Particles;
+  };
+
+  /// Owned ASCII stream that can be repositioned with the offset index.
+  struct SeekableReader {
+    std::shared_ptr<std::ifstream> Stream;
+    std::shared_ptr<HepMC3::Reader> Reader;
+  };
+
+  static void DecodeEvent(HepMC3::GenEvent const &evt, double tomev,
+                          DecodedEvent &dev);
+  void FillNUISANCEEvent(DecodedEvent const &dev);
+
+  /// Forward-only read used when the input has no offset index.
+  bool ReadNextEvent(const UInt_t entry);
+  bool OpenSeekableReader(SeekableReader &sr);
+  bool ReadEventAt(SeekableReader &sr, UInt_t entry, HepMC3::GenEvent &evt);
+  bool DecodeChunk(UInt_t first);
+
   std::shared_ptr<HepMC3::Reader> fReader;
   std::shared_ptr<HepMC3::GenRunInfo> frun_info;
   UInt_t nextentry;
@@ -36,4 +93,23 @@ public:
 
   //holds the process id numbers and names for this input file
   std::map<int, std::pair<std::string, std::string>> fprocids;
+
+  static const UInt_t kNoEntry = UInt_t(-1);
+
+  /// Byte offset of each event record, empty if only forward reads work.
+  std::vector<std::streamoff> fEventOffsets;
+  SeekableReader fSeekReader;
+  DecodedEvent fDecoded;
+  UInt_t fDecodedEntry; ///< Entry held in fDecoded, kNoEntry if none
+
+  /// Chunked parallel decode state, only used if NuHepMC_DecodeChunkSize > 1.
+  /// Chunks start on multiples of the chunk size, and the one before the
+  /// current chunk is kept so stepping back across a boundary is free.
+  UInt_t fDecodeChunkSize;
+  UInt_t fChunkFirst;
+  std::vector<DecodedEvent> fChunk;
+  UInt_t fPrevChunkFirst;
+  std::vector<DecodedEvent> fPrevChunk;
+  std::vector<SeekableReader> fThreadReaders;
+  std::vector<HepMC3::GenEvent> fThreadEvents;
 };
@@ -54,7 +54,12 @@ SplineInputHandler::SplineInputHandler(std::string const &handle,
 
   // Setup Matching Spline TTree
   fSplTree = (TTree *)inp_file->Get("spline_tree");
-  fSplTree->SetBranchAddress("SplineCoeff", fSplineCoeff);
+  if (fSplRead->GetNPar() > 1000) {
+    NUIS_ABORT("Spline input has " << fSplRead->GetNPar()
+                                   << " coefficients, at most 1000 are read.");
+  }
+  fSplCoeffTree = new SplineCoeffTree(fSplRead);
+  fSplCoeffTree->SetBranchAddress(fSplTree);
   fNUISANCEEvent->fSplineCoeff = this->fSplineCoeff;
 
   // Load into memory
@@ -70,6 +75,8 @@ SplineInputHandler::~SplineInputHandler() {
     delete fFitEventTree;
   if (fSplTree)
     delete fSplTree;
+  if (fSplCoeffTree)
+    delete fSplCoeffTree;
   if (fSplRead)
     delete fSplRead;
   fStartingWeights.clear();
@@ -87,6 +94,12 @@ void SplineInputHandler::CreateCache() {
   }
 }
 
+size_t SplineInputHandler::GetCacheBytes() {
+  return InputHandlerBase::GetCacheBytes() + fFitEventTree->GetCacheSize() +
+         fSplTree->GetCacheSize() +
+         fStartingWeights.capacity() * sizeof(float);
+}
+
 void SplineInputHandler::RemoveCache() {
   fFitEventTree->SetCacheEntryRange(0, fNEvents);
   fFitEventTree->AddBranchToCache("*", 0);
@@ -114,7 +127,9 @@ FitEvent *SplineInputHandler::GetNuisanceEvent(const UInt_t ent,
 
   // Get Spline Coefficients
   fSplTree->GetEntry(entry);
+  fSplCoeffTree->GetCoefficients(fSplineCoeff);
   fNUISANCEEvent->fSplineCoeff = fSplineCoeff;
+  fNUISANCEEvent->fSplineMask = NULL;
 
   // Setup Input scaling for joint inputs
   fNUISANCEEvent->InputWeight = fStartingWeights[entry];
@@ -4,6 +4,7 @@
 #include "InputHandler.h"
 #include "FitEvent.h"
 #include "PlotUtils.h"
+#include "SplineCoeffs.h"
 
 /// Spline InputHandler. Almost functionally identical to FitEventInputHandler
 /// with an extension to handle the spline co-efficients.
@@ -24,6 +25,9 @@ public:
 	/// Remove TTree Cache to save memory
 	void RemoveCache();
 
+	/// TTree caches, starting weights and event store bytes
+	size_t GetCacheBytes();
+
 	/// Return extra input weighting
 	double GetInputWeight(int entry);
 
@@ -33,6 +37,7 @@ public:
 	TChain* fFitEventTree;   ///< Main Fit Event Tree
 	TTree* fSplTree;	     ///< Main Spline Coefficient Tree
 	SplineReader* fSplRead;  ///< Spline Reader Object used to interpret splines
+	SplineCoeffTree* fSplCoeffTree; ///< Dense or sparse coefficient branches
 	float fSplineCoeff[1000];///< Coefficients. Currently a hardcoded limit of 1000.
 
 	/// Starting RW Input Weights corresponding to nominal spline weight
@@ -51,8 +51,39 @@ int savedstderrfd = dup(fileno(stderr));
 
 int nloggercalls = 0;
 int timelastlog = 0;
+
+bool use_buffer = false;
+size_t buffer_size = 1 << 16;
 }
 
+namespace {
+
+// Per-thread log buffer. The whole buffer goes to std::cout in one write,
+// which the stdio-synchronised stream passes on as a single fwrite, so
+// lines from different threads do not interleave.
+struct LogBuffer {
+  std::ostringstream stream;
+
+  ~LogBuffer() { Flush(); }
+
+  void Flush() {
+    if (stream.tellp() <= 0) {
+      return;
+    }
+    std::string text = stream.str();
+    std::cout.write(text.data(), text.size());
+    std::cout.flush();
+    stream.str("");
+  }
+};
+
+LogBuffer &GetLogBuffer() {
+  static thread_local LogBuffer buffer;
+  return buffer;
+}
+
+} // namespace
+
 // -------- Logging Functions --------- //
 
 bool LOGGING(int level) {
@@ -87,25 +118,35 @@ std::ostream& __OUTLOG(int level, const char* filename, const char* funct,
     return (Logger::__LOG_nullstream);
 
   } else {
+    std::ostream* logstream = &std::cout;
+    if (Logger::use_buffer) {
+      LogBuffer& buffer = GetLogBuffer();
+      if (size_t(buffer.stream.tellp()) >= Logger::buffer_size) {
+        buffer.Flush();
+      }
+      logstream = &buffer.stream;
+    }
+    std::ostream& out = *logstream;
+
     if (Logger::use_colors) {
       switch (level) {
         case FIT:
-          std::cout << BOLDGREEN;
+          out << BOLDGREEN;
           break;
         case MIN:
-          std::cout << BOLDBLUE;
+          out << BOLDBLUE;
           break;
         case SAM:
-          std::cout << MAGENTA;
+          out << MAGENTA;
           break;
         case REC:
-          std::cout << BLUE;
+          out << BLUE;
           break;
         case SIG:
-          std::cout << GREEN;
+          out << GREEN;
           break;
         case DEB:
-          std::cout << CYAN;
+          out << CYAN;
           break;
         default:
           break;
@@ -114,28 +155,28 @@ std::ostream& __OUTLOG(int level, const char* filename, const char* funct,
 
     switch (level) {
       case FIT:
-        std::cout << "[LOG Fitter]";
+        out << "[LOG Fitter]";
         break;
       case MIN:
-        std::cout << "[LOG Minmzr]";
+        out << "[LOG Minmzr]";
         break;
       case SAM:
-        std::cout << "[LOG Sample]";
+        out << "[LOG Sample]";
         break;
       case REC:
-        std::cout << "[LOG Reconf]";
+        out << "[LOG Reconf]";
         break;
       case SIG:
-        std::cout << "[LOG Signal]";
+        out << "[LOG Signal]";
         break;
       case EVT:
-        std::cout << "[LOG Event ]";
+        out << "[LOG Event ]";
         break;
       case DEB:
-        std::cout << "[LOG DEBUG ]";
+        out << "[LOG DEBUG ]";
         break;
       default:
-        std::cout << "[LOG INFO  ]";
+        out << "[LOG INFO  ]";
         break;
     }
 
@@ -143,39 +184,41 @@ std::ostream& __OUTLOG(int level, const char* filename, const char* funct,
     if (true) {
       switch (level) {
         case FIT:
-          std::cout << ": ";
+          out << ": ";
           break;
         case MIN:
-          std::cout << ":- ";
+          out << ":- ";
           break;
         case SAM:
-          std::cout << ":-- ";
+          out << ":-- ";
           break;
         case REC:
-          std::cout << ":--- ";
+          out << ":--- ";
           break;
         case SIG:
-          std::cout << ":---- ";
+          out << ":---- ";
           break;
         case EVT:
-          std::cout << ":----- ";
+          out << ":----- ";
           break;
         case DEB:
-          std::cout << ":------ ";
+          out << ":------ ";
           break;
         default:
-          std::cout << " ";
+          out << " ";
           break;
       }
     }
 
-    if (Logger::use_colors) std::cout << RESET;
+    if (Logger::use_colors) out << RESET;
 
     if (Logger::showtrace) {
-      std::cout << " : " << filename << "::" << funct << "[l. " << line
-                << "] : ";
+      out << " : " << filename << "::" << funct << "[l. " << line << "] : ";
     }
 
+    if (Logger::use_buffer) {
+      return *logstream;
+    }
     return *(Logger::__LOG_outstream);
   }
 }
@@ -224,9 +267,21 @@ void SETERRVERBOSITY(std::string verb) {
 /// Set Trace Option
 void SETTRACE(bool val) { Logger::showtrace = val; }
 
+void SETLOGBUFFER(bool val) {
+  if (!val) {
+    LOGFLUSH();
+  }
+  Logger::use_buffer = val;
+}
+
+void LOGFLUSH() { GetLogBuffer().Flush(); }
+
 // ------ ERROR FUNCTIONS ---------- //
 std::ostream& __OUTERR(int level, const char* filename, const char* funct,
                        int line) {
+  // Keep errors after the log lines that led up to them
+  if (Logger::use_buffer) LOGFLUSH();
+
   if (Logger::use_colors) std::cerr << RED;
 
   switch (level) {
@@ -258,6 +313,9 @@ void StopTalking() {
   // Only redirect if we're not debugging
   if (Logger::log_verb == (int)DEB) return;
 
+  // Anything still buffered was logged before the redirect
+  if (Logger::use_buffer) LOGFLUSH();
+
   std::cout.rdbuf(Logger::redirect_stream.rdbuf());
   std::cerr.rdbuf(Logger::redirect_stream.rdbuf());
   shhnuisancepythiaitokay_();
@@ -280,21 +338,6 @@ void StartTalking() {
   dup2(Logger::savedstderrfd, fileno(stderr));
 }
 
-//******************************************
-bool LOG_LEVEL(int level) {
-  //******************************************
-
-  if (Logger::log_verb == (int)DEB) {
-    return true;
-  }
-
-  if (Logger::log_verb < (int)level) {
-    return false;
-  }
-
-  return true;
-}
-
 void SET_TRACE(bool val) { Logger::showtrace = val; }
 
 //******************************************
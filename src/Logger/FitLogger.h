@@ -23,6 +23,7 @@
  *  @{
  */
 
+#include <cstddef>
 #include <fstream>
 #include <iosfwd>
 #include <iostream>
@@ -69,6 +70,8 @@ extern std::streambuf
     *default_cerr; //!< Where the STDERR stream is currently directed
 extern std::ofstream
     redirect_stream; //!< Where should unwanted messages be thrown
+extern bool use_buffer; //!< Collect log output in per-thread buffers
+extern size_t buffer_size; //!< Bytes a thread buffers before writing out
 } // namespace Logger
 
 /// Returns full path to file currently in
@@ -98,10 +101,24 @@ extern std::ostream *__LOG_outstream;
 /// was made
 enum __LOG_levels { QUIET = 0, FIT, MIN, SAM, REC, SIG, EVT, DEB };
 
+/// Most verbose level compiled in. Logging above it is removed at compile
+/// time whatever the runtime VERBOSITY, set with the CMake option
+/// NUISANCE_LOG_COMPILED_LEVEL.
+#ifndef NUIS_LOG_COMPILED_LEVEL
+#define NUIS_LOG_COMPILED_LEVEL 7
+#endif
+
 /// Returns log level for a given file/function
 int __GETLOG_LEVEL(int level, const char *filename, const char *funct);
 
-bool LOG_LEVEL(int level);
+/// Whether a message at level would be printed. Inline so that checks in
+/// per-event loops are a compare on Logger::log_verb rather than a call.
+inline bool LOG_LEVEL(int level) {
+  if (level > NUIS_LOG_COMPILED_LEVEL) {
+    return false;
+  }
+  return (Logger::log_verb == (int)DEB) || (Logger::log_verb >= level);
+}
 
 /// Actually runs the logger
 std::ostream &__OUTLOG(int level, const char *filename, const char *funct,
@@ -110,7 +127,7 @@ std::ostream &__OUTLOG(int level, const char *filename, const char *funct,
 /// Global Logging Definitions
 #define NUIS_LOGN(level, stream)                                               \
   {                                                                            \
-    if (LOG_LEVEL(level)) {                                                    \
+    if (((level) <= NUIS_LOG_COMPILED_LEVEL) && LOG_LEVEL(level)) {            \
       __OUTLOG(level, __FILENAME__, __FUNCTION__, __LINE__) << stream;         \
     }                                                                          \
   };
@@ -143,6 +160,15 @@ void SETERRVERBOSITY(std::string verb);
 /// Set Trace Option
 void SETTRACE(bool val);
 
+/// Send log output through a per-thread buffer, written out once
+/// Logger::buffer_size bytes have built up, on LOGFLUSH, before any error
+/// message, and when the thread exits. Threads only touch their own buffer,
+/// so logging from workers does not contend on std::cout per message.
+void SETLOGBUFFER(bool val);
+
+/// Write out the calling thread's log buffer.
+void LOGFLUSH();
+
 // ----------- ERROR FUNCTIONS ---------- //
 
 /// Error Stream
@@ -18,6 +18,9 @@
  *******************************************************************************/
 
 #include "GenericFlux_Vectors.h"
+#include "OpenMPWrapper.h"
+
+#include "TROOT.h"
 
 #ifdef MINERvA_ENABLED
 #include "MINERvA_SignalDef.h"
@@ -55,6 +58,62 @@ GenericFlux_Vectors::GenericFlux_Vectors(std::string name,
   NUIS_LOG(SAM, "Running GenericFlux_Vectors saving signal flags? "
 	   << SaveSignalFlags);
 
+  std::vector<std::string> savebranches =
+      GeneralUtils::ParseToStr(Config::GetParS("nuisflat_Branches"), ",");
+  for (size_t i = 0; i < savebranches.size(); ++i) {
+    if (!savebranches[i].empty()) {
+      fSaveBranches.insert(savebranches[i]);
+    }
+  }
+  if (!fSaveBranches.empty()) {
+    NUIS_LOG(SAM, "Running GenericFlux_Vectors saving only "
+                      << fSaveBranches.size() << " requested branches.");
+  }
+
+  // Array branches need their counter saved too
+  if (!fSaveBranches.empty()) {
+    if (SaveAnyBranch("px,py,pz,E,pdg,pdg_rank")) {
+      fSaveBranches.insert("nfsp");
+    }
+    if (SaveAnyBranch("px_init,py_init,pz_init,E_init,pdg_init")) {
+      fSaveBranches.insert("ninitp");
+    }
+    if (SaveAnyBranch("px_vert,py_vert,pz_vert,E_vert,pdg_vert")) {
+      fSaveBranches.insert("nvertp");
+    }
+  }
+
+  fCalcEmiss = SaveAnyBranch("Emiss,pmiss");
+  fCalcEmissPreFSI = SaveAnyBranch("Emiss_preFSI,pmiss_preFSI");
+  fCalcQERec = SaveAnyBranch("Enu_QE,Q2_QE");
+  fCalcErecoil = SaveAnyBranch("Erecoil_minerva,Erecoil_charged,EavAlt");
+  fCalcAdler = SaveAnyBranch("CosThetaAdler,PhiAdler");
+  fCalcSTV = SaveAnyBranch("dalphat,dpt,dphit,pnreco_C");
+
+  fNThreads = Config::GetParI("nuisflat_NThreads");
+  if (fNThreads < 1) {
+    fNThreads = omp_get_max_threads();
+  }
+#ifndef __USE_OPENMP__
+  if (fNThreads > 1) {
+    NUIS_ERR(WRN, "nuisflat_NThreads = "
+                      << fNThreads
+                      << " needs a build with OpenMP, flattening on one "
+                         "thread instead.");
+    fNThreads = 1;
+  }
+#endif
+  fChunkSize = Config::GetParI("nuisflat_ChunkSize");
+  if (fChunkSize < 1) {
+    fChunkSize = 1;
+  }
+  if (fNThreads > 1) {
+    ROOT::EnableThreadSafety();
+    NUIS_LOG(SAM, "Running GenericFlux_Vectors on " << fNThreads
+                      << " threads in chunks of " << fChunkSize
+                      << " events.");
+  }
+
   // Set default fitter flags
   fIsDiag = true;
   fIsShape = false;
@@ -103,6 +162,27 @@ GenericFlux_Vectors::GenericFlux_Vectors(std::string name,
   if (SaveSignalFlags) this->AddSignalFlagsToTree();
 }
 
+GenericFlux_Vectors::~GenericFlux_Vectors() {
+  for (size_t i = 0; i < fChunkEvents.size(); ++i) {
+    fChunkEvents[i]->DeallocateParticleStack();
+    delete fChunkEvents[i];
+  }
+}
+
+bool GenericFlux_Vectors::SaveBranch(std::string const &name) const {
+  return fSaveBranches.empty() || fSaveBranches.count(name);
+}
+
+bool GenericFlux_Vectors::SaveAnyBranch(std::string const &names) const {
+  std::vector<std::string> branches = GeneralUtils::ParseToStr(names, ",");
+  for (size_t i = 0; i < branches.size(); ++i) {
+    if (SaveBranch(branches[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void GenericFlux_Vectors::AddEventVariablesToTree() {
   // Setup the TTree to save everything
   if (!eventVariables) {
@@ -113,170 +193,292 @@ void GenericFlux_Vectors::AddEventVariablesToTree() {
 
   NUIS_LOG(SAM, "Adding Event Variables");
 
-  eventVariables->Branch("Mode", &Mode, "Mode/I");
+  AddBranch("Mode", &fVars.Mode, "Mode/I");
   // Add only for GENIE
 #ifdef GENIE_ENABLED
-  eventVariables->Branch("GENIEResCode", &GENIEResCode, "GENIEResCode/I");
+  AddBranch("GENIEResCode", &fVars.GENIEResCode, "GENIEResCode/I");
 #endif
-  eventVariables->Branch("cc", &cc, "cc/B");
-  eventVariables->Branch("PDGnu", &PDGnu, "PDGnu/I");
-  eventVariables->Branch("Enu_true", &Enu_true, "Enu_true/F");
-  eventVariables->Branch("tgt", &tgt, "tgt/I");
-  eventVariables->Branch("tgta", &tgta, "tgta/I");
-  eventVariables->Branch("tgtz", &tgtz, "tgtz/I");
-  eventVariables->Branch("PDGLep", &PDGLep, "PDGLep/I");
-  eventVariables->Branch("ELep", &ELep, "ELep/F");
-  eventVariables->Branch("CosLep", &CosLep, "CosLep/F");
+  AddBranch("cc", &fVars.cc, "cc/B");
+  AddBranch("PDGnu", &fVars.PDGnu, "PDGnu/I");
+  AddBranch("Enu_true", &fVars.Enu_true, "Enu_true/F");
+  AddBranch("tgt", &fVars.tgt, "tgt/I");
+  AddBranch("tgta", &fVars.tgta, "tgta/I");
+  AddBranch("tgtz", &fVars.tgtz, "tgtz/I");
+  AddBranch("PDGLep", &fVars.PDGLep, "PDGLep/I");
+  AddBranch("ELep", &fVars.ELep, "ELep/F");
+  AddBranch("CosLep", &fVars.CosLep, "CosLep/F");
 
   // Basic interaction kinematics
-  eventVariables->Branch("Q2", &Q2, "Q2/F");
-  eventVariables->Branch("q0", &q0, "q0/F");
-  eventVariables->Branch("q3", &q3, "q3/F");
-  eventVariables->Branch("Enu_QE", &Enu_QE, "Enu_QE/F");
-  eventVariables->Branch("Q2_QE", &Q2_QE, "Q2_QE/F");
-  eventVariables->Branch("W_nuc_rest", &W_nuc_rest, "W_nuc_rest/F");
-  eventVariables->Branch("W", &W, "W/F");
-  eventVariables->Branch("W_genie", &W_genie, "W_genie/F");
-  eventVariables->Branch("x", &x, "x/F");
-  eventVariables->Branch("y", &y, "y/F");
-  eventVariables->Branch("Erecoil_minerva", &Erecoil_minerva, "Erecoil_minerva/F");
-  eventVariables->Branch("Erecoil_charged", &Erecoil_charged, "Erecoil_charged/F");
-  eventVariables->Branch("EavAlt", &EavAlt, "EavAlt/F");
+  AddBranch("Q2", &fVars.Q2, "Q2/F");
+  AddBranch("q0", &fVars.q0, "q0/F");
+  AddBranch("q3", &fVars.q3, "q3/F");
+  AddBranch("Enu_QE", &fVars.Enu_QE, "Enu_QE/F");
+  AddBranch("Q2_QE", &fVars.Q2_QE, "Q2_QE/F");
+  AddBranch("W_nuc_rest", &fVars.W_nuc_rest, "W_nuc_rest/F");
+  AddBranch("W", &fVars.W, "W/F");
+  AddBranch("W_genie", &fVars.W_genie, "W_genie/F");
+  AddBranch("x", &fVars.x, "x/F");
+  AddBranch("y", &fVars.y, "y/F");
+  AddBranch("Erecoil_minerva", &fVars.Erecoil_minerva, "Erecoil_minerva/F");
+  AddBranch("Erecoil_charged", &fVars.Erecoil_charged, "Erecoil_charged/F");
+  AddBranch("EavAlt", &fVars.EavAlt, "EavAlt/F");
   
   // Add in EMiss and PMiss
-  eventVariables->Branch("Emiss", &Emiss, "Emiss/F");
-  eventVariables->Branch("pmiss", &pmiss);
-  eventVariables->Branch("Emiss_preFSI", &Emiss_preFSI, "Emiss_preFSI/F");
-  eventVariables->Branch("pmiss_preFSI", &pmiss_preFSI);
+  AddBranch("Emiss", &fVars.Emiss, "Emiss/F");
+  if (SaveBranch("pmiss")) {
+    eventVariables->Branch("pmiss", &fVars.pmiss);
+  }
+  AddBranch("Emiss_preFSI", &fVars.Emiss_preFSI, "Emiss_preFSI/F");
+  if (SaveBranch("pmiss_preFSI")) {
+    eventVariables->Branch("pmiss_preFSI", &fVars.pmiss_preFSI);
+  }
 
-  eventVariables->Branch("CosThetaAdler", &CosThetaAdler, "CosThetaAdler/F");
-  eventVariables->Branch("PhiAdler", &PhiAdler, "PhiAdler/F");
+  AddBranch("CosThetaAdler", &fVars.CosThetaAdler, "CosThetaAdler/F");
+  AddBranch("PhiAdler", &fVars.PhiAdler, "PhiAdler/F");
 
-  eventVariables->Branch("dalphat", &dalphat, "dalphat/F");
-  eventVariables->Branch("dpt", &dpt, "dpt/F");
-  eventVariables->Branch("dphit", &dphit, "dphit/F");
-  eventVariables->Branch("pnreco_C", &pnreco_C, "pnreco_C/F");
+  AddBranch("dalphat", &fVars.dalphat, "dalphat/F");
+  AddBranch("dpt", &fVars.dpt, "dpt/F");
+  AddBranch("dphit", &fVars.dphit, "dphit/F");
+  AddBranch("pnreco_C", &fVars.pnreco_C, "pnreco_C/F");
 
   // Save outgoing particle vectors
-  eventVariables->Branch("nfsp", &nfsp, "nfsp/I");
-  eventVariables->Branch("px", px, "px[nfsp]/F");
-  eventVariables->Branch("py", py, "py[nfsp]/F");
-  eventVariables->Branch("pz", pz, "pz[nfsp]/F");
-  eventVariables->Branch("E", E, "E[nfsp]/F");
-  eventVariables->Branch("pdg", pdg, "pdg[nfsp]/I");
-  eventVariables->Branch("pdg_rank", pdg_rank, "pdg_rank[nfsp]/I");
+  AddBranch("nfsp", &fVars.nfsp, "nfsp/I");
+  AddBranch("px", fVars.px, "px[nfsp]/F");
+  AddBranch("py", fVars.py, "py[nfsp]/F");
+  AddBranch("pz", fVars.pz, "pz[nfsp]/F");
+  AddBranch("E", fVars.E, "E[nfsp]/F");
+  AddBranch("pdg", fVars.pdg, "pdg[nfsp]/I");
+  AddBranch("pdg_rank", fVars.pdg_rank, "pdg_rank[nfsp]/I");
 
   // Save init particle vectors
-  eventVariables->Branch("ninitp", &ninitp, "ninitp/I");
-  eventVariables->Branch("px_init", px_init, "px_init[ninitp]/F");
-  eventVariables->Branch("py_init", py_init, "py_init[ninitp]/F");
-  eventVariables->Branch("pz_init", pz_init, "pz_init[ninitp]/F");
-  eventVariables->Branch("E_init", E_init, "E_init[ninitp]/F");
-  eventVariables->Branch("pdg_init", pdg_init, "pdg_init[ninitp]/I");
+  AddBranch("ninitp", &fVars.ninitp, "ninitp/I");
+  AddBranch("px_init", fVars.px_init, "px_init[ninitp]/F");
+  AddBranch("py_init", fVars.py_init, "py_init[ninitp]/F");
+  AddBranch("pz_init", fVars.pz_init, "pz_init[ninitp]/F");
+  AddBranch("E_init", fVars.E_init, "E_init[ninitp]/F");
+  AddBranch("pdg_init", fVars.pdg_init, "pdg_init[ninitp]/I");
 
   // Save pre-FSI vectors
-  eventVariables->Branch("nvertp", &nvertp, "nvertp/I");
-  eventVariables->Branch("px_vert", px_vert, "px_vert[nvertp]/F");
-  eventVariables->Branch("py_vert", py_vert, "py_vert[nvertp]/F");
-  eventVariables->Branch("pz_vert", pz_vert, "pz_vert[nvertp]/F");
-  eventVariables->Branch("E_vert", E_vert, "E_vert[nvertp]/F");
-  eventVariables->Branch("pdg_vert", pdg_vert, "pdg_vert[nvertp]/I");
+  AddBranch("nvertp", &fVars.nvertp, "nvertp/I");
+  AddBranch("px_vert", fVars.px_vert, "px_vert[nvertp]/F");
+  AddBranch("py_vert", fVars.py_vert, "py_vert[nvertp]/F");
+  AddBranch("pz_vert", fVars.pz_vert, "pz_vert[nvertp]/F");
+  AddBranch("E_vert", fVars.E_vert, "E_vert[nvertp]/F");
+  AddBranch("pdg_vert", fVars.pdg_vert, "pdg_vert[nvertp]/I");
 
   // Event Scaling Information
-  eventVariables->Branch("Weight", &Weight, "Weight/F");
-  eventVariables->Branch("InputWeight", &InputWeight, "InputWeight/F");
-  eventVariables->Branch("RWWeight", &RWWeight, "RWWeight/F");
+  AddBranch("Weight", &fVars.Weight, "Weight/F");
+  AddBranch("InputWeight", &fVars.InputWeight, "InputWeight/F");
+  AddBranch("RWWeight", &fVars.RWWeight, "RWWeight/F");
   // Should be a double because may be 1E-39 and less
-  eventVariables->Branch("fScaleFactor", &fScaleFactor, "fScaleFactor/D");
+  AddBranch("fScaleFactor", &fScaleFactor, "fScaleFactor/D");
 
   // The customs
-  eventVariables->Branch("CustomWeight", &CustomWeight, "CustomWeight/F");
-  eventVariables->Branch("CustomWeightArray", CustomWeightArray,
-                         "CustomWeightArray[6]/F");
+  AddBranch("CustomWeight", &fVars.CustomWeight, "CustomWeight/F");
+  AddBranch("CustomWeightArray", fVars.CustomWeightArray,
+            "CustomWeightArray[6]/F");
 
   return;
 }
 
 void GenericFlux_Vectors::FillEventVariables(FitEvent *event) {
 
-  ResetVariables();
+  fVars.Reset();
+  NUIS_LOG(DEB, "Filling signal");
+  CalcEventVariables(event, fVars);
+  CalcGeneratorVariables(event, fVars);
+
+  // Fill the eventVariables Tree
+  eventVariables->Fill();
+  return;
+};
+
+//********************************************************************
+void GenericFlux_Vectors::Reconfigure() {
+  //********************************************************************
+
+  if (fNThreads <= 1) {
+    Measurement1D::Reconfigure();
+    return;
+  }
+
+  NUIS_LOG(REC, " Reconfiguring sample " << fName);
+  this->ResetAll();
+
+  if (fChunkEvents.empty()) {
+    for (int i = 0; i < fChunkSize; ++i) {
+      fChunkEvents.push_back(new FitEvent());
+    }
+    fChunkVars.resize(fChunkSize);
+  }
+
+  int nevents = fInput->GetNEvents();
+  int countwidth = (nevents / 5);
+  int ievt = 0;
+
+  FitEvent *cust_event = fInput->FirstNuisanceEvent();
+  while (cust_event) {
+
+    // Read, weight and copy a chunk of events on the main thread, the input
+    // handlers and weight engines are not thread safe.
+    int nchunk = 0;
+    while (cust_event && (nchunk < fChunkSize)) {
+      cust_event->RWWeight = fRW->CalcWeight(cust_event);
+      cust_event->Weight = cust_event->RWWeight * cust_event->InputWeight;
+
+      fChunkVars[nchunk].Reset();
+      CalcGeneratorVariables(cust_event, fChunkVars[nchunk]);
+      fChunkEvents[nchunk]->CopyEventFrom(cust_event);
+
+      nchunk++;
+      cust_event = fInput->NextNuisanceEvent();
+    }
+
+    // Derived variables for each event in the chunk
+#ifdef __USE_OPENMP__
+#pragma omp parallel for schedule(dynamic, 64) num_threads(fNThreads)
+#endif
+    for (int i = 0; i < nchunk; ++i) {
+      CalcEventVariables(fChunkEvents[i], fChunkVars[i]);
+    }
+
+    // Fill in the original event order
+    for (int i = 0; i < nchunk; ++i) {
+      fVars = fChunkVars[i];
+      eventVariables->Fill();
+
+      if (LOG_LEVEL(REC) && countwidth > 0 && !(ievt % countwidth)) {
+        NUIS_LOG(SAM, std::setw(7) << std::right << ievt << "/" << nevents
+                                   << " events flattened.");
+      }
+      ievt++;
+    }
+  }
+
+  NUIS_LOG(SAM, ievt << "/" << nevents << " events flattened.");
+  fMCFilled = true;
+}
+
+//********************************************************************
+void GenericFlux_Vectors::CalcGeneratorVariables(FitEvent *event,
+                                                 EventVars &vars) {
+  //********************************************************************
+
+#ifdef GENIE_ENABLED
+  if (event->fType == kGENIE) {
+    EventRecord *gevent = static_cast<EventRecord *>(event->genie_event->event);
+    const Interaction *interaction = gevent->Summary();
+    const Kinematics &kine = interaction->Kine();
+    StopTalking();
+    vars.W_genie = kine.W();
+    StartTalking();
+  }
+#else
+  (void)event;
+  (void)vars;
+#endif
+}
+
+//********************************************************************
+void GenericFlux_Vectors::CalcEventVariables(FitEvent *event,
+                                             EventVars &vars) const {
+  //********************************************************************
 
   // Fill Signal Variables
-  if (SaveSignalFlags) FillSignalFlags(event);
-  NUIS_LOG(DEB, "Filling signal");
+  if (SaveSignalFlags) FillSignalFlags(event, vars);
 
   // Now fill the information
-  Mode = event->Mode;
+  vars.Mode = event->Mode;
 #ifdef GENIE_ENABLED
-  GENIEResCode = event->fResCode;
+  vars.GENIEResCode = event->fResCode;
 #endif
-  cc = event->IsCC();
+  vars.cc = event->IsCC();
 
   // Get the incoming neutrino and outgoing lepton
   FitParticle *nu = event->GetBeamPart();
   FitParticle *lep = event->GetHMFSAnyLepton();
 
-  PDGnu = nu->fPID;
-  Enu_true = nu->fP.E() / 1E3;
-  tgt = event->fTargetPDG;
-  tgta = event->fTargetA;
-  tgtz = event->fTargetZ;
+  vars.PDGnu = nu->fPID;
+  vars.Enu_true = nu->fP.E() / 1E3;
+  vars.tgt = event->fTargetPDG;
+  vars.tgta = event->fTargetA;
+  vars.tgtz = event->fTargetZ;
 
-  TLorentzVector ISP4 = nu->fP;
+  FitVector4 Pnu = nu->Vec4();
+  FitVector4 ISP4 = Pnu;
 
   if (lep != NULL) {
-    PDGLep = lep->fPID;
-    ELep = lep->fP.E() / 1E3;
-    CosLep = cos(nu->fP.Vect().Angle(lep->fP.Vect()));
+    FitVector4 Plep = lep->Vec4();
+    FitVector4 q = Pnu - Plep;
+
+    vars.PDGLep = lep->fPID;
+    vars.ELep = Plep.E() / 1E3;
+    vars.CosLep = cos(Pnu.Vect().Angle(Plep.Vect()));
 
     // Basic interaction kinematics
-    Q2 = -1 * (nu->fP - lep->fP).Mag2() / 1E6;
-    q0 = (nu->fP - lep->fP).E() / 1E3;
-    q3 = (nu->fP - lep->fP).Vect().Mag() / 1E3;
+    vars.Q2 = -1 * q.Mag2() / 1E6;
+    vars.q0 = q.E() / 1E3;
+    vars.q3 = q.Vect().Mag() / 1E3;
 
-	Emiss = FitUtils::GetEmiss(event);
-	pmiss = FitUtils::GetPmiss(event);
+    if (fCalcEmiss) {
+      vars.Emiss = FitUtils::GetEmiss(event);
+      vars.pmiss = FitUtils::GetPmiss(event);
+    }
 
-  Emiss_preFSI = FitUtils::GetEmiss(event, 1);
-  pmiss_preFSI = FitUtils::GetPmiss(event, 1);
+    if (fCalcEmissPreFSI) {
+      vars.Emiss_preFSI = FitUtils::GetEmiss(event, 1);
+      vars.pmiss_preFSI = FitUtils::GetPmiss(event, 1);
+    }
 
     // These assume C12 binding from MINERvA... not ideal
-    Enu_QE = FitUtils::EnuQErec(lep->fP, CosLep, 34., true);
-    Q2_QE = FitUtils::Q2QErec(lep->fP, CosLep, 34., true);
+    if (fCalcQERec) {
+      vars.Enu_QE = FitUtils::EnuQErec(Plep, vars.CosLep, 34., true);
+      vars.Q2_QE = FitUtils::Q2QErec(Plep, vars.CosLep, 34., true);
+    }
 
-    Erecoil_minerva = FitUtils::GetErecoil_MINERvA_LowRecoil(event) / 1.E3;
-    Erecoil_charged = FitUtils::GetErecoil_CHARGED(event) / 1.E3;
-	EavAlt = FitUtils::Eavailable(event) / 1.E3;
+    if (fCalcErecoil) {
+      vars.Erecoil_minerva =
+          FitUtils::GetErecoil_MINERvA_LowRecoil(event) / 1.E3;
+      vars.Erecoil_charged = FitUtils::GetErecoil_CHARGED(event) / 1.E3;
+      vars.EavAlt = FitUtils::Eavailable(event) / 1.E3;
+    }
 
     // Check if this is a 1pi+ or 1pi0 event
-    if ((SignalDef::isCC1pi(event, PDGnu, 211) ||
-         SignalDef::isCC1pi(event, PDGnu, -211) ||
-         SignalDef::isCC1pi(event, PDGnu, 111)) &&
+    if (fCalcAdler && (SignalDef::isCC1pi(event, vars.PDGnu, 211) ||
+                       SignalDef::isCC1pi(event, vars.PDGnu, -211) ||
+                       SignalDef::isCC1pi(event, vars.PDGnu, 111)) &&
         event->NumFSNucleons() == 1) {
-      TLorentzVector Pnu = nu->fP;
-      TLorentzVector Pmu = lep->fP;
-      TLorentzVector Ppi = event->GetHMFSPions()->fP;
-      TLorentzVector Pprot = event->GetHMFSNucleons()->fP;
-      CosThetaAdler = FitUtils::CosThAdler(Pnu, Pmu, Ppi, Pprot);
-      PhiAdler = FitUtils::PhiAdler(Pnu, Pmu, Ppi, Pprot);
+      // The Adler frame boosts, which needs the ROOT vectors
+      TLorentzVector const &Pmu = lep->P4();
+      TLorentzVector const &Ppi = event->GetHMFSPions()->P4();
+      TLorentzVector const &Pprot = event->GetHMFSNucleons()->P4();
+      vars.CosThetaAdler = FitUtils::CosThAdler(nu->P4(), Pmu, Ppi, Pprot);
+      vars.PhiAdler = FitUtils::PhiAdler(nu->P4(), Pmu, Ppi, Pprot);
     }
 
     // Get W_true with assumption of initial state nucleon at rest
     float m_n = (float)PhysConst::mass_proton;
     // Q2 assuming nucleon at rest
-    W_nuc_rest = sqrt(-Q2 + 2 * m_n * q0 + m_n * m_n);
-    W = W_nuc_rest; // For want of a better thing to do
+    vars.W_nuc_rest = sqrt(-vars.Q2 + 2 * m_n * vars.q0 + m_n * m_n);
+    vars.W = vars.W_nuc_rest; // For want of a better thing to do
     // True Q2
-    x = Q2 / (2 * m_n * q0);
-    y = 1 - ELep / Enu_true;
-
-    dalphat = FitUtils::Get_STV_dalphat_HMProton(event, PDGnu, true);
-    dpt = FitUtils::Get_STV_dpt_HMProton(event, PDGnu, true);
-    dphit = FitUtils::Get_STV_dphit_HMProton(event, PDGnu, true);
-    pnreco_C = FitUtils::Get_pn_reco_C_HMProton(event, PDGnu, true);
+    vars.x = vars.Q2 / (2 * m_n * vars.q0);
+    vars.y = 1 - vars.ELep / vars.Enu_true;
+
+    if (fCalcSTV) {
+      vars.dalphat =
+          FitUtils::Get_STV_dalphat_HMProton(event, vars.PDGnu, true);
+      vars.dpt = FitUtils::Get_STV_dpt_HMProton(event, vars.PDGnu, true);
+      vars.dphit = FitUtils::Get_STV_dphit_HMProton(event, vars.PDGnu, true);
+      vars.pnreco_C =
+          FitUtils::Get_pn_reco_C_HMProton(event, vars.PDGnu, true);
+    }
   }
 
   // Loop over the particles and store all the final state particles in a vector
+  std::vector<FitParticle *> partList;
+  std::vector<FitParticle *> initList;
+  std::vector<FitParticle *> vertList;
   for (UInt_t i = 0; i < event->Npart(); ++i) {
 
     if (event->PartInfo(i)->fIsAlive &&
@@ -290,21 +492,22 @@ void GenericFlux_Vectors::FillEventVariables(FitEvent *event) {
       initList.push_back(event->PartInfo(i));
 
     if (event->PartInfo(i)->IsInitialState()) {
-      ISP4 += event->PartInfo(i)->fP;
+      ISP4 += event->PartInfo(i)->Vec4();
     }
   }
 
   // Save outgoing particle vectors
-  nfsp = (int)partList.size();
+  vars.nfsp = (int)partList.size();
   std::map<int, std::vector<std::pair<double, int> > > pdgMap;
 
-  for (int i = 0; i < nfsp; ++i) {
-    px[i] = partList[i]->fP.X() / 1E3;
-    py[i] = partList[i]->fP.Y() / 1E3;
-    pz[i] = partList[i]->fP.Z() / 1E3;
-    E[i] = partList[i]->fP.E() / 1E3;
-    pdg[i] = partList[i]->fPID;
-    pdgMap[pdg[i]].push_back(std::make_pair(partList[i]->fP.Vect().Mag(), i));
+  for (int i = 0; i < vars.nfsp; ++i) {
+    FitVector4 P = partList[i]->Vec4();
+    vars.px[i] = P.X() / 1E3;
+    vars.py[i] = P.Y() / 1E3;
+    vars.pz[i] = P.Z() / 1E3;
+    vars.E[i] = P.E() / 1E3;
+    vars.pdg[i] = partList[i]->fPID;
+    pdgMap[vars.pdg[i]].push_back(std::make_pair(P.Vect().Mag(), i));
   }
 
   for (std::map<int, std::vector<std::pair<double, int> > >::iterator iter =
@@ -316,59 +519,50 @@ void GenericFlux_Vectors::FillEventVariables(FitEvent *event) {
     // Now save the order... a bit funky to avoid inverting
     int nPart = (int)thisVect.size() - 1;
     for (int i = nPart; i >= 0; --i) {
-      pdg_rank[thisVect[i].second] = nPart - i;
+      vars.pdg_rank[thisVect[i].second] = nPart - i;
     }
   }
 
   // Save pre-FSI particles
-  nvertp = (int)vertList.size();
-  for (int i = 0; i < nvertp; ++i) {
-    px_vert[i] = vertList[i]->fP.X() / 1E3;
-    py_vert[i] = vertList[i]->fP.Y() / 1E3;
-    pz_vert[i] = vertList[i]->fP.Z() / 1E3;
-    E_vert[i] = vertList[i]->fP.E() / 1E3;
-    pdg_vert[i] = vertList[i]->fPID;
+  vars.nvertp = (int)vertList.size();
+  for (int i = 0; i < vars.nvertp; ++i) {
+    vars.px_vert[i] = vertList[i]->fP.X() / 1E3;
+    vars.py_vert[i] = vertList[i]->fP.Y() / 1E3;
+    vars.pz_vert[i] = vertList[i]->fP.Z() / 1E3;
+    vars.E_vert[i] = vertList[i]->fP.E() / 1E3;
+    vars.pdg_vert[i] = vertList[i]->fPID;
   }
 
   // Save init particles
-  ninitp = (int)initList.size();
-  for (int i = 0; i < ninitp; ++i) {
-    px_init[i] = initList[i]->fP.X() / 1E3;
-    py_init[i] = initList[i]->fP.Y() / 1E3;
-    pz_init[i] = initList[i]->fP.Z() / 1E3;
-    E_init[i] = initList[i]->fP.E() / 1E3;
-    pdg_init[i] = initList[i]->fPID;
+  vars.ninitp = (int)initList.size();
+  for (int i = 0; i < vars.ninitp; ++i) {
+    vars.px_init[i] = initList[i]->fP.X() / 1E3;
+    vars.py_init[i] = initList[i]->fP.Y() / 1E3;
+    vars.pz_init[i] = initList[i]->fP.Z() / 1E3;
+    vars.E_init[i] = initList[i]->fP.E() / 1E3;
+    vars.pdg_init[i] = initList[i]->fPID;
   }
 
-#ifdef GENIE_ENABLED
-  if (event->fType == kGENIE) {
-    EventRecord *gevent = static_cast<EventRecord *>(event->genie_event->event);
-    const Interaction *interaction = gevent->Summary();
-    const Kinematics &kine = interaction->Kine();
-    StopTalking();
-    W_genie = kine.W();
-    StartTalking();
-  }
-#endif
-
   // Fill event weights
-  Weight = event->RWWeight * event->InputWeight;
-  RWWeight = event->RWWeight;
-  InputWeight = event->InputWeight;
+  vars.Weight = event->RWWeight * event->InputWeight;
+  vars.RWWeight = event->RWWeight;
+  vars.InputWeight = event->InputWeight;
   // And the Customs
-  CustomWeight = event->CustomWeight;
+  vars.CustomWeight = event->CustomWeight;
   for (int i = 0; i < 6; ++i) {
-    CustomWeightArray[i] = event->CustomWeightArray[i];
+    vars.CustomWeightArray[i] = event->CustomWeightArray[i];
   }
-
-  // Fill the eventVariables Tree
-  eventVariables->Fill();
-  return;
-};
+}
 
 //********************************************************************
 void GenericFlux_Vectors::ResetVariables() {
   //********************************************************************
+  fVars.Reset();
+}
+
+//********************************************************************
+void GenericFlux_Vectors::EventVars::Reset() {
+  //********************************************************************
 
   cc = false;
 
@@ -408,10 +602,6 @@ void GenericFlux_Vectors::ResetVariables() {
   for (int i = 0; i < 6; ++i)
     CustomWeightArray[i] = 0.0;
 
-  partList.clear();
-  initList.clear();
-  vertList.clear();
-
   flagCCINC = flagNCINC = flagCCQE = flagCC0pi = flagCCQELike = flagNCEL =
       flagNC0pi = flagCCcoh = flagNCcoh = flagCC1pip = flagNC1pip = flagCC1pim =
           flagNC1pim = flagCC1pi0 = flagNC1pi0 = false;
@@ -419,14 +609,13 @@ void GenericFlux_Vectors::ResetVariables() {
 #ifdef MINERvA_ENABLED
   flagCC0piMINERvA = false;
 #endif
-#ifdef T2K_ENABLED
   flagCC0Pi_T2K_AnaI = false;
   flagCC0Pi_T2K_AnaII = false;
-#endif
 }
 
 //********************************************************************
-void GenericFlux_Vectors::FillSignalFlags(FitEvent *event) {
+void GenericFlux_Vectors::FillSignalFlags(FitEvent *event,
+                                          EventVars &vars) const {
   //********************************************************************
 
   // Some example flags are given from SignalDef.
@@ -434,28 +623,28 @@ void GenericFlux_Vectors::FillSignalFlags(FitEvent *event) {
   int nuPDG = event->PartInfo(0)->fPID;
 
   // Generic signal flags
-  flagCCINC = SignalDef::isCCINC(event, nuPDG);
-  flagNCINC = SignalDef::isNCINC(event, nuPDG);
-  flagCCQE = SignalDef::isCCQE(event, nuPDG);
-  flagCCQELike = SignalDef::isCCQELike(event, nuPDG);
-  flagCC0pi = SignalDef::isCC0pi(event, nuPDG);
-  flagNCEL = SignalDef::isNCEL(event, nuPDG);
-  flagNC0pi = SignalDef::isNC0pi(event, nuPDG);
-  flagCCcoh = SignalDef::isCCCOH(event, nuPDG, 211);
-  flagNCcoh = SignalDef::isNCCOH(event, nuPDG, 111);
-  flagCC1pip = SignalDef::isCC1pi(event, nuPDG, 211);
-  flagNC1pip = SignalDef::isNC1pi(event, nuPDG, 211);
-  flagCC1pim = SignalDef::isCC1pi(event, nuPDG, -211);
-  flagNC1pim = SignalDef::isNC1pi(event, nuPDG, -211);
-  flagCC1pi0 = SignalDef::isCC1pi(event, nuPDG, 111);
-  flagNC1pi0 = SignalDef::isNC1pi(event, nuPDG, 111);
+  vars.flagCCINC = SignalDef::isCCINC(event, nuPDG);
+  vars.flagNCINC = SignalDef::isNCINC(event, nuPDG);
+  vars.flagCCQE = SignalDef::isCCQE(event, nuPDG);
+  vars.flagCCQELike = SignalDef::isCCQELike(event, nuPDG);
+  vars.flagCC0pi = SignalDef::isCC0pi(event, nuPDG);
+  vars.flagNCEL = SignalDef::isNCEL(event, nuPDG);
+  vars.flagNC0pi = SignalDef::isNC0pi(event, nuPDG);
+  vars.flagCCcoh = SignalDef::isCCCOH(event, nuPDG, 211);
+  vars.flagNCcoh = SignalDef::isNCCOH(event, nuPDG, 111);
+  vars.flagCC1pip = SignalDef::isCC1pi(event, nuPDG, 211);
+  vars.flagNC1pip = SignalDef::isNC1pi(event, nuPDG, 211);
+  vars.flagCC1pim = SignalDef::isCC1pi(event, nuPDG, -211);
+  vars.flagNC1pim = SignalDef::isNC1pi(event, nuPDG, -211);
+  vars.flagCC1pi0 = SignalDef::isCC1pi(event, nuPDG, 111);
+  vars.flagNC1pi0 = SignalDef::isNC1pi(event, nuPDG, 111);
 #ifdef MINERvA_ENABLED
-  flagCC0piMINERvA = SignalDef::isCC0pi_MINERvAPTPZ(event, 14);
+  vars.flagCC0piMINERvA = SignalDef::isCC0pi_MINERvAPTPZ(event, 14);
 #endif
 #ifdef T2K_ENABLED
-  flagCC0Pi_T2K_AnaI =
+  vars.flagCC0Pi_T2K_AnaI =
       SignalDef::isT2K_CC0pi(event, EnuMin, EnuMax, SignalDef::kAnalysis_I);
-  flagCC0Pi_T2K_AnaII =
+  vars.flagCC0Pi_T2K_AnaII =
       SignalDef::isT2K_CC0pi(event, EnuMin, EnuMax, SignalDef::kAnalysis_II);
 #endif
 }
@@ -470,30 +659,30 @@ void GenericFlux_Vectors::AddSignalFlagsToTree() {
   NUIS_LOG(SAM, "Adding signal flags");
 
   // Signal Definitions from SignalDef.cxx
-  eventVariables->Branch("flagCCINC", &flagCCINC, "flagCCINC/O");
-  eventVariables->Branch("flagNCINC", &flagNCINC, "flagNCINC/O");
-  eventVariables->Branch("flagCCQE", &flagCCQE, "flagCCQE/O");
-  eventVariables->Branch("flagCC0pi", &flagCC0pi, "flagCC0pi/O");
-  eventVariables->Branch("flagCCQELike", &flagCCQELike, "flagCCQELike/O");
-  eventVariables->Branch("flagNCEL", &flagNCEL, "flagNCEL/O");
-  eventVariables->Branch("flagNC0pi", &flagNC0pi, "flagNC0pi/O");
-  eventVariables->Branch("flagCCcoh", &flagCCcoh, "flagCCcoh/O");
-  eventVariables->Branch("flagNCcoh", &flagNCcoh, "flagNCcoh/O");
-  eventVariables->Branch("flagCC1pip", &flagCC1pip, "flagCC1pip/O");
-  eventVariables->Branch("flagNC1pip", &flagNC1pip, "flagNC1pip/O");
-  eventVariables->Branch("flagCC1pim", &flagCC1pim, "flagCC1pim/O");
-  eventVariables->Branch("flagNC1pim", &flagNC1pim, "flagNC1pim/O");
-  eventVariables->Branch("flagCC1pi0", &flagCC1pi0, "flagCC1pi0/O");
-  eventVariables->Branch("flagNC1pi0", &flagNC1pi0, "flagNC1pi0/O");
+  AddBranch("flagCCINC", &fVars.flagCCINC, "flagCCINC/O");
+  AddBranch("flagNCINC", &fVars.flagNCINC, "flagNCINC/O");
+  AddBranch("flagCCQE", &fVars.flagCCQE, "flagCCQE/O");
+  AddBranch("flagCC0pi", &fVars.flagCC0pi, "flagCC0pi/O");
+  AddBranch("flagCCQELike", &fVars.flagCCQELike, "flagCCQELike/O");
+  AddBranch("flagNCEL", &fVars.flagNCEL, "flagNCEL/O");
+  AddBranch("flagNC0pi", &fVars.flagNC0pi, "flagNC0pi/O");
+  AddBranch("flagCCcoh", &fVars.flagCCcoh, "flagCCcoh/O");
+  AddBranch("flagNCcoh", &fVars.flagNCcoh, "flagNCcoh/O");
+  AddBranch("flagCC1pip", &fVars.flagCC1pip, "flagCC1pip/O");
+  AddBranch("flagNC1pip", &fVars.flagNC1pip, "flagNC1pip/O");
+  AddBranch("flagCC1pim", &fVars.flagCC1pim, "flagCC1pim/O");
+  AddBranch("flagNC1pim", &fVars.flagNC1pim, "flagNC1pim/O");
+  AddBranch("flagCC1pi0", &fVars.flagCC1pi0, "flagCC1pi0/O");
+  AddBranch("flagNC1pi0", &fVars.flagNC1pi0, "flagNC1pi0/O");
 #ifdef MINERvA_ENABLED
-  eventVariables->Branch("flagCC0piMINERvA", &flagCC0piMINERvA,
-                         "flagCC0piMINERvA/O");
+  AddBranch("flagCC0piMINERvA", &fVars.flagCC0piMINERvA,
+            "flagCC0piMINERvA/O");
 #endif
 #ifdef T2K_ENABLED
-  eventVariables->Branch("flagCC0Pi_T2K_AnaI", &flagCC0Pi_T2K_AnaI,
-                         "flagCC0Pi_T2K_AnaI/O");
-  eventVariables->Branch("flagCC0Pi_T2K_AnaII", &flagCC0Pi_T2K_AnaII,
-                         "flagCC0Pi_T2K_AnaII/O");
+  AddBranch("flagCC0Pi_T2K_AnaI", &fVars.flagCC0Pi_T2K_AnaI,
+            "flagCC0Pi_T2K_AnaI/O");
+  AddBranch("flagCC0Pi_T2K_AnaII", &fVars.flagCC0Pi_T2K_AnaII,
+            "flagCC0Pi_T2K_AnaII/O");
 #endif
 };
 
@@ -22,19 +22,21 @@
 #include "Measurement1D.h"
 #include "FitEvent.h"
 
+#include <set>
+
 class GenericFlux_Vectors : public Measurement1D {
 
 public:
 
   GenericFlux_Vectors(std::string name, std::string inputfile, FitWeight *rw, std::string type, std::string fakeDataFile);
-  virtual ~GenericFlux_Vectors() {};
+  virtual ~GenericFlux_Vectors();
+
+  //! Chunked multithreaded event loop if nuisflat_NThreads > 1
+  void Reconfigure();
 
   //! Grab info from event
   void FillEventVariables(FitEvent *event);
 
-  //! Fill signal flags
-  void FillSignalFlags(FitEvent *event);
-
   void ResetVariables();
 
   //! Fill Custom Histograms
@@ -51,6 +53,7 @@ public:
 
   //! Define this samples signal
   bool isSignal(FitEvent *nvect);
+  bool NeedsGeneratorEvent() { return true; };
 
   //! Write Files
   void Write(std::string drawOpt);
@@ -63,112 +66,159 @@ public:
 
  private:
 
-  TTree* eventVariables;
-  std::vector<FitParticle*> partList;
-  std::vector<FitParticle*> initList;
-  std::vector<FitParticle*> vertList;
+  static const int kMAX = 200;
 
-  bool SavePreFSI;
-  bool SaveSignalFlags;
+  /// Everything saved to the tree for a single event. Kept separate from the
+  /// sample so that a chunk of events can be calculated on several threads
+  /// before being filled in order.
+  struct EventVars {
+    void Reset();
 
-  int Mode;
+    int Mode;
 #ifdef GENIE_ENABLED
-  int GENIEResCode;
+    int GENIEResCode;
 #endif
-  bool cc;
-  int PDGnu;
-  int tgt;
-  int tgta;
-  int tgtz;
-  int PDGLep;
-  float ELep;
-  float CosLep;
-
-  // Basic interaction kinematics
-  float Q2;
-  float q0;
-  float q3;
-  float Emiss;
-  TVector3 pmiss;
-  float Emiss_preFSI;
-  TVector3 pmiss_preFSI;
-  float Enu_QE;
-  float Enu_true;
-  float Q2_QE;
-  float W_nuc_rest;
-  float W;
-  float x;
-  float y;
-  float Erecoil_minerva;
-  float Erecoil_charged;
-  float EavAlt;
-  float dalphat;
-  float W_genie;
-  float dpt;
-  float dphit;
-  float pnreco_C;
-
-  float CosThetaAdler;
-  float PhiAdler;
-
-  // Save outgoing particle vectors
-  int nfsp;
-  static const int kMAX = 200;
-  float px[kMAX];
-  float py[kMAX];
-  float pz[kMAX];
-  float E[kMAX];
-  int pdg[kMAX];
-  int pdg_rank[kMAX];
-
-  // Save incoming particle info
-  int ninitp;
-  float px_init[kMAX];
-  float py_init[kMAX];
-  float pz_init[kMAX];
-  float E_init[kMAX];
-  int pdg_init[kMAX];
-
-  // Save pre-FSI particle info
-  int nvertp;
-  float px_vert[kMAX];
-  float py_vert[kMAX];
-  float pz_vert[kMAX];
-  float E_vert[kMAX];
-  int pdg_vert[kMAX];
-
-  // Basic event info
-  float Weight;
-  float InputWeight;
-  float RWWeight;
-  double fScaleFactor;
-
-  // Custom weights
-  float CustomWeight;
-  float CustomWeightArray[6];
-
-  // Generic signal flags
-  bool flagCCINC;
-  bool flagNCINC;
-  bool flagCCQE;
-  bool flagCC0pi;
-  bool flagCCQELike;
-  bool flagNCEL;
-  bool flagNC0pi;
-  bool flagCCcoh;
-  bool flagNCcoh;
-  bool flagCC1pip;
-  bool flagNC1pip;
-  bool flagCC1pim;
-  bool flagNC1pim;
-  bool flagCC1pi0;
-  bool flagNC1pi0;
+    bool cc;
+    int PDGnu;
+    int tgt;
+    int tgta;
+    int tgtz;
+    int PDGLep;
+    float ELep;
+    float CosLep;
+
+    // Basic interaction kinematics
+    float Q2;
+    float q0;
+    float q3;
+    float Emiss;
+    TVector3 pmiss;
+    float Emiss_preFSI;
+    TVector3 pmiss_preFSI;
+    float Enu_QE;
+    float Enu_true;
+    float Q2_QE;
+    float W_nuc_rest;
+    float W;
+    float x;
+    float y;
+    float Erecoil_minerva;
+    float Erecoil_charged;
+    float EavAlt;
+    float dalphat;
+    float W_genie;
+    float dpt;
+    float dphit;
+    float pnreco_C;
+
+    float CosThetaAdler;
+    float PhiAdler;
+
+    // Save outgoing particle vectors
+    int nfsp;
+    float px[kMAX];
+    float py[kMAX];
+    float pz[kMAX];
+    float E[kMAX];
+    int pdg[kMAX];
+    int pdg_rank[kMAX];
+
+    // Save incoming particle info
+    int ninitp;
+    float px_init[kMAX];
+    float py_init[kMAX];
+    float pz_init[kMAX];
+    float E_init[kMAX];
+    int pdg_init[kMAX];
+
+    // Save pre-FSI particle info
+    int nvertp;
+    float px_vert[kMAX];
+    float py_vert[kMAX];
+    float pz_vert[kMAX];
+    float E_vert[kMAX];
+    int pdg_vert[kMAX];
+
+    // Basic event info
+    float Weight;
+    float InputWeight;
+    float RWWeight;
+
+    // Custom weights
+    float CustomWeight;
+    float CustomWeightArray[6];
+
+    // Generic signal flags
+    bool flagCCINC;
+    bool flagNCINC;
+    bool flagCCQE;
+    bool flagCC0pi;
+    bool flagCCQELike;
+    bool flagNCEL;
+    bool flagNC0pi;
+    bool flagCCcoh;
+    bool flagNCcoh;
+    bool flagCC1pip;
+    bool flagNC1pip;
+    bool flagCC1pim;
+    bool flagNC1pim;
+    bool flagCC1pi0;
+    bool flagNC1pi0;
 #ifdef MINERvA_ENABLED
-  bool flagCC0piMINERvA;
+    bool flagCC0piMINERvA;
 #endif
 
     bool flagCC0Pi_T2K_AnaI;
     bool flagCC0Pi_T2K_AnaII;
+  };
+
+  //! Variables that only need the converted particle stack, safe to call
+  //! from several threads on different events.
+  void CalcEventVariables(FitEvent *event, EventVars &vars) const;
+
+  //! Variables that need the generator event, main thread only.
+  void CalcGeneratorVariables(FitEvent *event, EventVars &vars);
+
+  //! Fill signal flags
+  void FillSignalFlags(FitEvent *event, EventVars &vars) const;
+
+  //! Branch is in nuisflat_Branches, or no whitelist was given.
+  bool SaveBranch(std::string const &name) const;
+  bool SaveAnyBranch(std::string const &names) const;
+
+  template <typename T>
+  void AddBranch(std::string const &name, T *address,
+                 std::string const &leaflist) {
+    if (SaveBranch(name)) {
+      eventVariables->Branch(name.c_str(), address, leaflist.c_str());
+    }
+  }
+
+  TTree* eventVariables;
+
+  bool SavePreFSI;
+  bool SaveSignalFlags;
+
+  /// Branch whitelist, empty saves everything.
+  std::set<std::string> fSaveBranches;
+
+  // Derived quantities that are skipped if none of their branches are saved
+  bool fCalcEmiss;
+  bool fCalcEmissPreFSI;
+  bool fCalcQERec;
+  bool fCalcErecoil;
+  bool fCalcAdler;
+  bool fCalcSTV;
+
+  /// Tree buffer
+  EventVars fVars;
+  double fScaleFactor;
+
+  /// Chunked event loop state
+  int fNThreads;
+  int fChunkSize;
+  std::vector<FitEvent *> fChunkEvents;
+  std::vector<EventVars> fChunkVars;
 };
 
 #endif
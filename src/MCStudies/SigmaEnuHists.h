@@ -33,6 +33,7 @@ public:
 
   //! Define this samples signal
   bool isSignal(FitEvent *nvect);
+  bool NeedsGeneratorEvent() { return true; };
 
   //! Write Files
   void Write(std::string drawOpt);
@@ -104,6 +104,16 @@ Smearceptance_Tester::Smearceptance_Tester(nuiskey samplekey) {
 
   smearceptor = &Smearcepterton::Get().GetSmearcepter(smearceptorName);
 
+  // Throws are drawn from an explicit stream so that output is reproducible
+  // for a given seed. The TRandom3 default seed matches the previous
+  // behaviour of the smearcepter-owned generators.
+  UInt_t smearSeed = 4357;
+  if (Config::HasPar("smear.seed")) {
+    smearSeed = Config::GetParI("smear.seed");
+    NUIS_LOG(SAM, "Seeding smearcepter throws with: " << smearSeed);
+  }
+  smearRNG.SetSeed(smearSeed);
+
   Int_t RecNBins = 20, TrueNBins = 20;
   double RecBinL = 0xdeadbeef, TrueBinL = 0, RecBinH = 10, TrueBinH = 10;
 
@@ -337,7 +347,7 @@ void Smearceptance_Tester::AddEventVariablesToTree() {
 }
 
 template <size_t N>
-int CountNPdgsSeen(RecoInfo ri, int const (&pdgs)[N]) {
+int CountNPdgsSeen(RecoInfo const &ri, int const (&pdgs)[N]) {
   int sum = 0;
   for (size_t pdg_it = 0; pdg_it < N; ++pdg_it) {
     sum +=
@@ -347,7 +357,7 @@ int CountNPdgsSeen(RecoInfo ri, int const (&pdgs)[N]) {
 }
 
 template <size_t N>
-int CountNNotPdgsSeen(RecoInfo ri, int const (&pdgs)[N]) {
+int CountNNotPdgsSeen(RecoInfo const &ri, int const (&pdgs)[N]) {
   int sum = 0;
   for (size_t p_it = 0; p_it < ri.RecObjClass.size(); ++p_it) {
     if (!std::count(pdgs, pdgs + N, ri.RecObjClass[p_it])) {
@@ -358,7 +368,7 @@ int CountNNotPdgsSeen(RecoInfo ri, int const (&pdgs)[N]) {
 }
 
 template <size_t N>
-int CountNPdgsContributed(RecoInfo ri, int const (&pdgs)[N]) {
+int CountNPdgsContributed(RecoInfo const &ri, int const (&pdgs)[N]) {
   int sum = 0;
   for (size_t pdg_it = 0; pdg_it < N; ++pdg_it) {
     sum += std::count(ri.TrueContribPDGs.begin(), ri.TrueContribPDGs.end(),
@@ -368,7 +378,7 @@ int CountNPdgsContributed(RecoInfo ri, int const (&pdgs)[N]) {
 }
 
 template <size_t N>
-int CountNNotPdgsContributed(RecoInfo ri, int const (&pdgs)[N]) {
+int CountNNotPdgsContributed(RecoInfo const &ri, int const (&pdgs)[N]) {
   int sum = 0;
   for (size_t p_it = 0; p_it < ri.TrueContribPDGs.size(); ++p_it) {
     if (!std::count(pdgs, pdgs + N, ri.TrueContribPDGs[p_it])) {
@@ -378,7 +388,7 @@ int CountNNotPdgsContributed(RecoInfo ri, int const (&pdgs)[N]) {
   return sum;
 }
 
-TLorentzVector GetHMFSRecParticles(RecoInfo ri, int pdg) {
+TLorentzVector GetHMFSRecParticles(RecoInfo const &ri, int pdg) {
   TLorentzVector mom(0, 0, 0, 0);
   for (size_t p_it = 0; p_it < ri.RecObjMom.size(); ++p_it) {
     if ((ri.RecObjClass[p_it] == pdg) &&
@@ -392,7 +402,7 @@ TLorentzVector GetHMFSRecParticles(RecoInfo ri, int pdg) {
 }
 
 template <size_t N>
-double SumKE_RecoInfo(RecoInfo ri, int const (&pdgs)[N], double mass) {
+double SumKE_RecoInfo(RecoInfo const &ri, int const (&pdgs)[N], double mass) {
   double sum = 0;
   for (size_t p_it = 0; p_it < ri.RecObjMom.size(); ++p_it) {
     if (!std::count(pdgs, pdgs + N,
@@ -407,7 +417,7 @@ double SumKE_RecoInfo(RecoInfo ri, int const (&pdgs)[N], double mass) {
 }
 
 template <size_t N>
-double SumTE_RecoInfo(RecoInfo ri, int const (&pdgs)[N], double mass) {
+double SumTE_RecoInfo(RecoInfo const &ri, int const (&pdgs)[N], double mass) {
   double sum = 0;
   for (size_t p_it = 0; p_it < ri.RecObjMom.size(); ++p_it) {
     if (!std::count(pdgs, pdgs + N,
@@ -422,7 +432,7 @@ double SumTE_RecoInfo(RecoInfo ri, int const (&pdgs)[N], double mass) {
 }
 
 template <size_t N>
-double SumVisE_RecoInfo(RecoInfo ri, int const (&pdgs)[N]) {
+double SumVisE_RecoInfo(RecoInfo const &ri, int const (&pdgs)[N]) {
   double sum = 0;
 
   for (size_t p_it = 0; p_it < ri.RecVisibleEnergy.size(); ++p_it) {
@@ -438,7 +448,7 @@ double SumVisE_RecoInfo(RecoInfo ri, int const (&pdgs)[N]) {
 }
 
 template <size_t N>
-double SumVisE_RecoInfo_NotPdgs(RecoInfo ri, int const (&pdgs)[N]) {
+double SumVisE_RecoInfo_NotPdgs(RecoInfo const &ri, int const (&pdgs)[N]) {
   double sum = 0;
 
   for (size_t p_it = 0; p_it < ri.RecVisibleEnergy.size(); ++p_it) {
@@ -472,7 +482,8 @@ void Smearceptance_Tester::FillEventVariables(FitEvent *event) {
                                      2212, 2112, 22,  11,  13,   15,  12,  14,
                                      16,   -11,  -13, -15, -12,  -14, -16};
 
-  RecoInfo *ri = smearceptor->Smearcept(event);
+  RecoInfo *ri = &recoInfo;
+  smearceptor->Smearcept(event, ri, &smearRNG);
 
   //** START Pions
 
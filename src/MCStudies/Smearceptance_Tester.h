@@ -64,6 +64,9 @@ class Smearceptance_Tester : public Measurement1D {
 
  private:
   ISmearcepter *smearceptor;
+  /// Reused for every event to avoid per-event allocations.
+  RecoInfo recoInfo;
+  TRandom3 smearRNG;
 
   TTree *eventVariables;
 
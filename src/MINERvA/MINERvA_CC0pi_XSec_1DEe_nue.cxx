@@ -73,8 +73,8 @@ void MINERvA_CC0pi_XSec_1DEe_nue::FillEventVariables(FitEvent *event) {
   if (event->NumFSParticle(PDGe) == 0)
     return;
 
-  TLorentzVector Pnu  = event->GetNeutrinoIn()->fP;
-  TLorentzVector Pe   = event->GetHMFSParticle(PDGe)->fP;
+  FitVector4 Pnu  = event->GetNeutrinoIn()->Vec4();
+  FitVector4 Pe   = event->GetHMFSParticle(PDGe)->Vec4();
 
   Thetae   = Pnu.Vect().Angle(Pe.Vect());
   Q2QEe    = FitUtils::Q2QErec(Pe, cos(Thetae), 34., true);
@@ -96,17 +96,17 @@ void MINERvA_CC0pi_XSec_1DQ2_Tgt_nu::FillEventVariables(FitEvent *event){
       event->HasFSMuon() &&
       event->HasFSProton()){
 
-    TLorentzVector pnu    = event->GetHMISNuMuon()->fP;
-    TLorentzVector pprot  = event->GetHMFSProton()->fP;
-    TLorentzVector pmu    = event->GetHMFSMuon()->fP;
+    FitVector4 pnu    = event->GetHMISNuMuon()->Vec4();
+    FitVector4 pprot  = event->GetHMFSProton()->Vec4();
+    FitVector4 pmu    = event->GetHMFSMuon()->Vec4();
 
     // Q2QE rec from leading proton assuming 34 MeV Eb
     double protmax = pprot.E();
     double q2qe    = FitUtils::ProtonQ2QErec(protmax, 34.);
 
     // Coplanar is angle between muon and proton plane
-    TVector3 plnprotnu = pprot.Vect().Cross(pnu.Vect());
-    TVector3 plnmunu   = pmu.Vect().Cross(pnu.Vect());
+    FitVector3 plnprotnu = pprot.Vect().Cross(pnu.Vect());
+    FitVector3 plnmunu   = pmu.Vect().Cross(pnu.Vect());
     double copl        = plnprotnu.Angle(plnmunu);
 
     // Fill X Variables
@@ -99,8 +99,8 @@ void MINERvA_CC0pi_XSec_1DQ2_antinu_H::FillEventVariables(FitEvent *event) {
   // Checking to see if there is a Muon
   if (event->NumFSParticle(-13) == 0) return;
 
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
-  TLorentzVector Pmu  = event->GetHMFSParticle(-13)->fP;
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
+  FitVector4 Pmu  = event->GetHMFSParticle(-13)->Vec4();
   double Q2 = -1*(Pnu-Pmu).Mag2()/1.E6;
 
   // Just a check to make sure Q2QE on hydrogen and Q2 true is the same, and it is (to 1E-3 GeV2)
@@ -197,8 +197,8 @@ void MINERvA_CC0pi_XSec_1D_2018_nu::FillEventVariables(FitEvent *event) {
     return;
 
   // Get the muon kinematics
-  TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
+  FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
 
   // Now we set the x-axis
   switch (fDist) {
@@ -191,8 +191,8 @@ void MINERvA_CC0pi_XSec_2D_antinu::FillEventVariables(FitEvent *event) {
   // Checking to see if there is a Muon
   if (event->NumFSParticle(-13) == 0) return;
 
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
-  TLorentzVector Pmu  = event->GetHMFSParticle(-13)->fP;
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
+  FitVector4 Pmu  = event->GetHMFSParticle(-13)->Vec4();
 
   switch (fDist) {
     case (kPtPz):
@@ -193,8 +193,8 @@ void MINERvA_CC0pi_XSec_2D_nu::FillEventVariables(FitEvent *event) {
     return;
 
   // Get the muon kinematics
-  TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
+  FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
 
   Double_t px = Pmu.X() / 1000;
   Double_t py = Pmu.Y() / 1000;
@@ -217,7 +217,7 @@ bool MINERvA_CC0pi_XSec_2D_nu::isSignal(FitEvent *event) {
   if (event->NumFSParticle(13) == 0) return false;
   // Check outgoing muon is at least 1.5 GeV in ME
   if (IsME) {
-    TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
+    FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
     if (Pmu.Vect().Mag() < 1.5) return false;
   }
 
@@ -80,8 +80,8 @@ void MINERvA_CC0pi_XSec_3DptpzTp_1DVersion_nu::FillEventVariables( FitEvent* eve
   if (event->NumFSParticle(13) == 0) return;
 
   // Get the muon kinematics
-  TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
+  FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
 
   Double_t px = Pmu.X() / 1000.;
   Double_t py = Pmu.Y() / 1000.;
@@ -107,8 +107,8 @@ void MINERvA_CC0pi_XSec_3DptpzTp_nu::FillEventVariables(FitEvent *event) {
   if (event->NumFSParticle(13) == 0) return;
 
   // Get the muon kinematics
-  TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
+  FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
 
   Double_t px = Pmu.X() / 1000;
   Double_t py = Pmu.Y() / 1000;
@@ -178,59 +178,48 @@ double MINERvA_CC0pi_XSec_3DptpzTp_nu::GetLikelihood() {
   int nbinsy = fMCHist->GetNbinsY();
   Int_t Nbins = nbinsx * nbinsy;
 
+  // Data - MC in covariance order (x fastest), filled once per evaluation
+  fFlatDiff.resize(Nbins);
+  for (int i = 0; i < Nbins; ++i) {
+    int gbin = fMCHist->GetBin((i % nbinsx) + 1, (i / nbinsx) + 1);
+    fFlatDiff[i] = fDataHist->GetBinContent(gbin) - fMCHist->GetBinContent(gbin);
+  }
+  const double *cov = covar->GetMatrixArray();
+
   // Loop over the covariance matrix bins
   for (int i = 0; i < Nbins; ++i) {
-    int xbin = (i % nbinsx) + 1;
-    int ybin = (i / nbinsx) + 1;
-    double datax = fDataHist->GetBinContent(xbin, ybin);
-    double mcx = fMCHist->GetBinContent(xbin, ybin);
     double chi2_bin = 0;
+    const double *covrow = cov + i * Nbins;
     for (int j = 0; j < Nbins; ++j) {
-      int xbin2 = (j % nbinsx) + 1;
-      int ybin2 = (j / nbinsx) + 1;
-
-      double datay = fDataHist->GetBinContent(xbin2, ybin2);
-      double mcy = fMCHist->GetBinContent(xbin2, ybin2);
-
-      double chi2_xy = (datax - mcx) * (*covar)(i, j) * (datay - mcy);
-      chi2_bin += chi2_xy;
+      chi2_bin += fFlatDiff[i] * covrow[j] * fFlatDiff[j];
     }
     if (fResidualHist) {
-      fResidualHist->SetBinContent(xbin, ybin, chi2_bin);
+      fResidualHist->SetBinContent((i % nbinsx) + 1, (i / nbinsx) + 1,
+                                   chi2_bin);
     }
     chi2 += chi2_bin;
   }
 
   if (fChi2LessBinHist) {
     for (int igbin = 0; igbin < Nbins; ++igbin) {
-      int igxbin = (igbin % nbinsx) + 1;
-      int igybin = (igbin / nbinsx) + 1;
       double tchi2 = 0;
       for (int i = 0; i < Nbins; ++i) {
-        int xbin = (i % nbinsx) + 1;
-        int ybin = (i / nbinsx) + 1;
-        if ((xbin == igxbin) && (ybin == igybin)) {
+        if (i == igbin) {
           continue;
         }
-        double datax = fDataHist->GetBinContent(xbin, ybin);
-        double mcx = fMCHist->GetBinContent(xbin, ybin);
         double chi2_bin = 0;
+        const double *covrow = cov + i * Nbins;
         for (int j = 0; j < Nbins; ++j) {
-          int xbin2 = (j % nbinsx) + 1;
-          int ybin2 = (j / nbinsx) + 1;
-          if ((xbin2 == igxbin) && (ybin2 == igybin)) {
+          if (j == igbin) {
             continue;
           }
-          double datay = fDataHist->GetBinContent(xbin2, ybin2);
-          double mcy = fMCHist->GetBinContent(xbin2, ybin2);
-
-          double chi2_xy = (datax - mcx) * (*covar)(i, j) * (datay - mcy);
-          chi2_bin += chi2_xy;
+          chi2_bin += fFlatDiff[i] * covrow[j] * fFlatDiff[j];
         }
         tchi2 += chi2_bin;
       }
 
-      fChi2LessBinHist->SetBinContent(igxbin, igybin, tchi2);
+      fChi2LessBinHist->SetBinContent((igbin % nbinsx) + 1,
+                                      (igbin / nbinsx) + 1, tchi2);
     }
   }
 
@@ -48,6 +48,9 @@ class MINERvA_CC0pi_XSec_3DptpzTp_nu : public Measurement2D {
   std::vector<TH2D*> fDataHist_Slices;
   std::vector<TH2D*> fMCHist_Slices;
 
+  // Data - MC in covariance order, reused between evaluations
+  std::vector<double> fFlatDiff;
+
   int nptbins;
   double *ptbins;
   int npzbins;
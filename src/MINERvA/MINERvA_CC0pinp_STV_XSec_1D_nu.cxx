@@ -330,11 +330,11 @@ void MINERvA_CC0pinp_STV_XSec_1D_nu::FillEventVariables(FitEvent *event) {
     return;
   }
 
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
-  TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
+  FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
   // Find the highest momentum proton in the event between 450 and 1200 MeV with
   // theta_p < 70
-  TLorentzVector Pprot = MINERvAUtils::GetProtonInRange(event, ProtonMinCut, ProtonMaxCut, cos(ProtonThetaCut/180.0*M_PI));
+  FitVector4 Pprot(MINERvAUtils::GetProtonInRange(event, ProtonMinCut, ProtonMaxCut, cos(ProtonThetaCut/180.0*M_PI)));
 
   switch (fDist) {
   case (kMuonMom):
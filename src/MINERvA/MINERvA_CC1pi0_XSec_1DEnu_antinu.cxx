@@ -70,8 +70,8 @@ void MINERvA_CC1pi0_XSec_1DEnu_antinu::FillEventVariables(FitEvent *event) {
 
   if (event->NumFSParticle(-13) == 0) return;
 
-  TLorentzVector Pnu  = event->GetNeutrinoIn()->fP;
-  TLorentzVector Pmu  = event->GetHMFSParticle(-13)->fP;
+  FitVector4 Pnu  = event->GetNeutrinoIn()->Vec4();
+  FitVector4 Pmu  = event->GetHMFSParticle(-13)->Vec4();
 
   double hadMass = FitUtils::Wrec(Pnu, Pmu);
   double Enu     = -999;
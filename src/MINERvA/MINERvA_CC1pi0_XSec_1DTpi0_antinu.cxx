@@ -77,9 +77,9 @@ void MINERvA_CC1pi0_XSec_1DTpi0_antinu::FillEventVariables(FitEvent *event) {
       event->NumFSParticle(-13) == 0)
     return;
 
-  TLorentzVector Pnu  = event->GetNeutrinoIn()->fP;
-  TLorentzVector Ppi0 = event->GetHMFSParticle(111)->fP;
-  TLorentzVector Pmu  = event->GetHMFSParticle(-13)->fP;
+  FitVector4 Pnu  = event->GetNeutrinoIn()->Vec4();
+  FitVector4 Ppi0 = event->GetHMFSParticle(111)->Vec4();
+  FitVector4 Pmu  = event->GetHMFSParticle(-13)->Vec4();
 
   double hadMass = FitUtils::Wrec(Pnu, Pmu);
   double Tpi0 = -999;
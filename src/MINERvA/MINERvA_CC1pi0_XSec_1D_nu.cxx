@@ -203,10 +203,10 @@ void MINERvA_CC1pi0_XSec_1D_nu::FillEventVariables(FitEvent *event) {
     return;
   }
 
-  // Get the TLorentzVectors from the event
-  TLorentzVector Pnu  = event->GetNeutrinoIn()->fP;
-  TLorentzVector Ppi0 = event->GetHMFSParticle(111)->fP;
-  TLorentzVector Pmu  = event->GetHMFSParticle(13)->fP;
+  // Get the four-vectors from the event
+  FitVector4 Pnu  = event->GetNeutrinoIn()->Vec4();
+  FitVector4 Ppi0 = event->GetHMFSParticle(111)->Vec4();
+  FitVector4 Pmu  = event->GetHMFSParticle(13)->Vec4();
 
   // Pion kinetic energy
   double Tpi     = (Ppi0.E() - Ppi0.Mag())/1.E3;
@@ -263,7 +263,7 @@ void MINERvA_CC1pi0_XSec_1D_nu::FillEventVariables(FitEvent *event) {
     case kPPi0MassDelta:
       {
       // Get the proton
-      TLorentzVector Pprot = event->GetHMFSParticle(2212)->fP;
+      FitVector4 Pprot = event->GetHMFSParticle(2212)->Vec4();
       double Ppi0Mass = (Ppi0+Pprot).Mag()/1.E3;
       fXVar = Ppi0Mass;
       break;
@@ -271,16 +271,19 @@ void MINERvA_CC1pi0_XSec_1D_nu::FillEventVariables(FitEvent *event) {
     // Cos theta Adler angle
     case kCosAdler:
       {
-      TLorentzVector Pprot = event->GetHMFSParticle(2212)->fP;
-      double CosThAdler = FitUtils::CosThAdler(Pnu, Pmu, Ppi0, Pprot);
+      FitVector4 Pprot = event->GetHMFSParticle(2212)->Vec4();
+      // The Adler frame boosts, which needs the ROOT vectors
+      double CosThAdler = FitUtils::CosThAdler(
+          Pnu.ToROOT(), Pmu.ToROOT(), Ppi0.ToROOT(), Pprot.ToROOT());
       fXVar = CosThAdler;
       break;
       }
     // Phi Adler angle
     case kPhiAdler:
       {
-      TLorentzVector Pprot = event->GetHMFSParticle(2212)->fP;
-      double PhiAdler = FitUtils::PhiAdler(Pnu, Pmu, Ppi0, Pprot);
+      FitVector4 Pprot = event->GetHMFSParticle(2212)->Vec4();
+      double PhiAdler = FitUtils::PhiAdler(
+          Pnu.ToROOT(), Pmu.ToROOT(), Ppi0.ToROOT(), Pprot.ToROOT());
       fXVar = PhiAdler;
       break;
       }
@@ -304,7 +307,7 @@ bool MINERvA_CC1pi0_XSec_1D_nu::isSignal(FitEvent *event) {
     if (!pass_cc1pi0) return false;
 
     // And the proton needs at least 100 MeV kinetic energy
-    TLorentzVector Pprot = event->GetHMFSParticle(2212)->fP;
+    FitVector4 Pprot = event->GetHMFSParticle(2212)->Vec4();
     double ke = (Pprot.E() - Pprot.Mag())/1.E3;
     if (pass_cc1pi0 && ke > ProtonCut) {
       return true;
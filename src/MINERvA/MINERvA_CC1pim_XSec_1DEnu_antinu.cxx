@@ -71,7 +71,7 @@ void MINERvA_CC1pim_XSec_1DEnu_antinu::FillEventVariables( FitEvent* event ) {
 
   const int ANTI_NUMU = -14;
   if ( event->NumISParticle(ANTI_NUMU) <= 0 ) return;
-  TLorentzVector p4_numubar = event->GetHMISParticle( ANTI_NUMU )->fP;
+  FitVector4 p4_numubar = event->GetHMISParticle( ANTI_NUMU )->Vec4();
 
   // Convert the true energy from MeV to GeV
   double Enubar = p4_numubar.E() / 1e3;
@@ -70,15 +70,15 @@ void MINERvA_CC1pim_XSec_1DQ2_antinu::FillEventVariables( FitEvent* event ) {
 
   const int ANTI_NUMU = -14;
   if ( event->NumISParticle(ANTI_NUMU) <= 0 ) return;
-  TLorentzVector pnu = event->GetHMISParticle( ANTI_NUMU )->fP;
+  FitVector4 pnu = event->GetHMISParticle( ANTI_NUMU )->Vec4();
 
   const int MU_PLUS = -13;
   if ( event->NumFSParticle(MU_PLUS) <= 0 ) return;
-  TLorentzVector pmu = event->GetHMFSParticle( MU_PLUS )->fP;
+  FitVector4 pmu = event->GetHMFSParticle( MU_PLUS )->Vec4();
 
   const int PI_MINUS = -211;
   if ( event->NumFSParticle(PI_MINUS) <= 0 ) return;
-  TLorentzVector ppi = event->GetHMFSParticle( PI_MINUS )->fP;
+  FitVector4 ppi = event->GetHMFSParticle( PI_MINUS )->Vec4();
 
   // FitUtils::Q2CC1piprec can use either a reconstructed Q^2 or a true one
   // based on the true neutrino energy. In this case, we want the true one.
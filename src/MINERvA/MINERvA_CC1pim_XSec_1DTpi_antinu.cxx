@@ -71,7 +71,7 @@ void MINERvA_CC1pim_XSec_1DTpi_antinu::FillEventVariables( FitEvent* event ) {
   const int PI_MINUS = -211;
   if ( event->NumFSParticle(PI_MINUS) <= 0 ) return;
 
-  TLorentzVector P_pi_m = event->GetHMFSParticle( PI_MINUS )->fP;
+  FitVector4 P_pi_m = event->GetHMFSParticle( PI_MINUS )->Vec4();
   double Tpi = FitUtils::T( P_pi_m ); // Kinetic energy returned in GeV
 
   fXVar = Tpi;
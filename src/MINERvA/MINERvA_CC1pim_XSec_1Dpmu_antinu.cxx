@@ -70,7 +70,7 @@ void MINERvA_CC1pim_XSec_1Dpmu_antinu::FillEventVariables( FitEvent* event ) {
 
   const int MU_PLUS = -13;
   if ( event->NumFSParticle(MU_PLUS) <= 0 ) return;
-  TLorentzVector p4_mu = event->GetHMFSParticle( MU_PLUS )->fP;
+  FitVector4 p4_mu = event->GetHMFSParticle( MU_PLUS )->Vec4();
 
   // Convert the 3-momentum magnitude from MeV to GeV
   double pmu = p4_mu.P() / 1e3;
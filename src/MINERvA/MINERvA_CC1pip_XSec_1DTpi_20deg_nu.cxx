@@ -55,9 +55,9 @@ void MINERvA_CC1pip_XSec_1DTpi_20deg_nu::FillEventVariables(FitEvent *event) {
       event->NumFSParticle(13) == 0)
     return;
 
-  TLorentzVector Pnu  = event->GetNeutrinoIn()->fP;
-  TLorentzVector Ppip = event->GetHMFSParticle(PhysConst::pdg_charged_pions)->fP;
-  TLorentzVector Pmu  = event->GetHMFSParticle(13)->fP;
+  FitVector4 Pnu  = event->GetNeutrinoIn()->Vec4();
+  FitVector4 Ppip = event->GetHMFSParticle(PhysConst::pdg_charged_pions)->Vec4();
+  FitVector4 Pmu  = event->GetHMFSParticle(13)->Vec4();
 
   double hadMass = FitUtils::Wrec(Pnu, Pmu);
   double Tpi     = -999;
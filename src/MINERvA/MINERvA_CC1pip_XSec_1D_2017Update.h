@@ -65,6 +65,7 @@ public:
   void SetupDataSettings();
   void FillEventVariables(FitEvent *event);
   bool isSignal(FitEvent *event);
+  bool NeedsGeneratorEvent() { return true; };
   
   private:
   int fDist;
@@ -34,6 +34,7 @@ public:
 
   void FillEventVariables(FitEvent *event);
   bool isSignal(FitEvent *event);
+  bool NeedsGeneratorEvent() { return true; };
 
   void Write(std::string drawOpt);
 
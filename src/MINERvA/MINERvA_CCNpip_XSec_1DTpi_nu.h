@@ -31,6 +31,7 @@ public:
   void FillEventVariables(FitEvent *event);
   void FillHistograms();
   bool isSignal(FitEvent *event);
+  bool NeedsGeneratorEvent() { return true; };
   void ScaleEvents();
   void Write(std::string drawOpts);
   
@@ -30,6 +30,7 @@ public:
   void FillEventVariables(FitEvent *event);
   void FillHistograms();
   bool isSignal(FitEvent *event);
+  bool NeedsGeneratorEvent() { return true; };
   void Write(std::string drawOpt);
   bool fFullPhaseSpace;
   bool fUpdatedData;
@@ -149,13 +149,13 @@ void MINERvA_NukeCC1pip_XSec_1D_nu::FillEventVariables(FitEvent *event) {
     return;
   }
 
-  TLorentzVector Pnu = event->GetHMISParticle(14)->fP;
-  TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
-  TLorentzVector Ppip = event->GetHMFSParticle(PhysConst::pdg_charged_pions)->fP;
+  FitVector4 Pnu = event->GetHMISParticle(14)->Vec4();
+  FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
+  FitVector4 Ppip = event->GetHMFSParticle(PhysConst::pdg_charged_pions)->Vec4();
 
   // Pz is the neutrino-direction component of muon 3-momentum
   Double_t pz_mu = Pmu.Vect().Dot( Pnu.Vect().Unit() ); // MeV
-  TVector3 pt_mu = Pmu.Vect() - pz_mu * Pnu.Vect().Unit(); // MeV
+  FitVector3 pt_mu = Pmu.Vect() - pz_mu * Pnu.Vect().Unit(); // MeV
 
   float Q2_true = -1 * (Pmu - Pnu).Mag2()/1E6;
   double Tpi = (Ppip.E() - Ppip.Mag())/1E3; // GeV
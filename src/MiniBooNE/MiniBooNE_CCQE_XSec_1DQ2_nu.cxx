@@ -137,11 +137,11 @@ void  MiniBooNE_CCQE_XSec_1DQ2_nu::FillEventVariables(FitEvent *event) {
   if (event->NumFSParticle(PhysConst::pdg_muons) == 0)
     return;
 
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
 
   // The highest momentum mu+/mu-. The isSignal definition should make sure we only
   // accept events we want, so no need to do an additional check here.
-  TLorentzVector Pmu = event->GetHMFSParticle(PhysConst::pdg_muons)->fP;
+  FitVector4 Pmu = event->GetHMFSParticle(PhysConst::pdg_muons)->Vec4();
 
   q2qe = FitUtils::Q2QErec(Pmu, cos(Pnu.Vect().Angle(Pmu.Vect())), 34., false);
 
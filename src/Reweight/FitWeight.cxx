@@ -5,6 +5,7 @@
 #include "NUISANCEWeightEngine.h"
 #include "SampleNormEngine.h"
 #include "SplineWeightEngine.h"
+#include "TimingUtils.h"
 
 #ifdef NEUTReWeight_ENABLED
 #include "NEUTWeightEngine.h"
@@ -102,10 +103,20 @@ void FitWeight::AddRWEngine(int type) {
       NUIS_ABORT("CANNOT ADD RW Engine for unknown dial type: " << type);
       break;
   }
+
+  // Not every engine names itself, timings still need a label
+  if (fAllRW[type]->fCalcName.empty()) {
+    fAllRW[type]->fCalcName = "rwtype" + std::to_string(type);
+  }
+  fPipelines.clear();
+  fChangeCount++;
 }
 
 WeightEngineBase *FitWeight::GetRWEngine(int type) {
   if (HasRWEngine(type)) {
+    // The caller may set dials on it directly
+    fPipelines.clear();
+    fChangeCount++;
     return fAllRW[type];
   }
   NUIS_ABORT("CANNOT get RW Engine for dial type: " << type);
@@ -189,6 +200,10 @@ void FitWeight::IncludeDial(std::string name, int dialtype, double val) {
   fNameList.push_back(name);
   fEnumList.push_back(nuisenum);
   fValueList.push_back(val);
+
+  // A new dial can take an engine off its identity fast path
+  fPipelines.clear();
+  fChangeCount++;
 }
 
 void FitWeight::Reconfigure(bool silent) {
@@ -197,6 +212,8 @@ void FitWeight::Reconfigure(bool silent) {
        iter != fAllRW.end(); iter++) {
     (*iter).second->Reconfigure(silent);
   }
+  fPipelines.clear();
+  fChangeCount++;
 }
 
 void FitWeight::SetDialValue(std::string name, double val) {
@@ -228,6 +245,8 @@ void FitWeight::SetDialValue(int nuisenum, double val) {
   // Get RW Engine for this dial
   fAllRW[dialtype]->SetDialValue(nuisenum, val);
   fAllValues[nuisenum] = val;
+  fPipelines.clear();
+  fChangeCount++;
 
   // Update ValueList
   for (size_t i = 0; i < fEnumList.size(); i++) {
@@ -275,14 +294,76 @@ bool FitWeight::DialIncluded(int rwenum) {
   return (fAllValues.find(rwenum) != fAllValues.end());
 }
 
+std::vector<FitWeight::WeightStep> const &FitWeight::GetPipeline(int evttype) {
+  std::map<int, std::vector<WeightStep> >::iterator it =
+      fPipelines.find(evttype);
+  if (it != fPipelines.end()) {
+    return it->second;
+  }
+
+  std::vector<WeightStep> &pipeline = fPipelines[evttype];
+  std::string names;
+  for (std::map<int, WeightEngineBase *>::iterator iter = fAllRW.begin();
+       iter != fAllRW.end(); iter++) {
+    WeightEngineBase *rw = (*iter).second;
+    if (!rw->AppliesToEvent(evttype) || rw->IsIdentity()) {
+      continue;
+    }
+
+    WeightStep step;
+    step.Engine = rw;
+
+    // The custom engine is a list of calcs, most of them off in any one fit
+    NUISANCEWeightEngine *nuisrw = dynamic_cast<NUISANCEWeightEngine *>(rw);
+    if (nuisrw) {
+      for (size_t i = 0; i < nuisrw->fWeightCalculators.size(); i++) {
+        NUISANCEWeightCalc *calc = nuisrw->fWeightCalculators[i];
+        if (calc->AppliesToEvent(evttype) && !calc->IsIdentity()) {
+          step.Calcs.push_back(calc);
+        }
+      }
+      if (step.Calcs.empty()) {
+        continue;
+      }
+    }
+
+    pipeline.push_back(step);
+    names += " " + rw->fCalcName;
+  }
+
+  NUIS_LOG(DEB, "Weight engines for event type " << evttype << ":" << names);
+  return pipeline;
+}
+
 double FitWeight::CalcWeight(BaseFitEvt *evt) {
+  std::vector<WeightStep> const &pipeline = GetPipeline(evt->fType);
+
   double rwweight = 1.0;
+  for (size_t i = 0; i < pipeline.size(); i++) {
+    WeightStep const &step = pipeline[i];
+    WeightEngineBase *rw = step.Engine;
+    TimingUtils::ScopedTimer timer(rw->fTimingID, "WeightEngine",
+                                   rw->fCalcName, TimingUtils::kCalcWeight);
+    if (step.Calcs.empty()) {
+      rwweight *= rw->CalcWeight(evt);
+      continue;
+    }
+    for (size_t j = 0; j < step.Calcs.size(); j++) {
+      rwweight *= step.Calcs[j]->CalcWeight(evt);
+    }
+  }
+  return rwweight;
+}
+
+bool FitWeight::NeedsGeneratorEvent(int evttype) {
   for (std::map<int, WeightEngineBase *>::iterator iter = fAllRW.begin();
        iter != fAllRW.end(); iter++) {
-    double w = (*iter).second->CalcWeight(evt);
-    rwweight *= w;
+    if ((*iter).second->NeedsGeneratorEvent() &&
+        (*iter).second->AppliesToEvent(evttype)) {
+      return true;
+    }
   }
-  return rwweight;
+  return false;
 }
 
 void FitWeight::UpdateWeightEngine(const double *x) {
@@ -9,9 +9,11 @@
 #include <map>
 #include <vector>
 
+class NUISANCEWeightCalc;
+
 class FitWeight {
 public:
-  FitWeight(std::string name = "") {(void)name;};
+  FitWeight(std::string name = "") : fChangeCount(0) {(void)name;};
 
   // Add a new RW engine given type
   void AddRWEngine(int rwtype);
@@ -39,6 +41,9 @@ public:
 
   double CalcWeight(BaseFitEvt* evt);
   bool HasRWDialChanged(const double* x) { (void)x; return true; };
+  /// True if any engine that can reweight events of this generator type
+  /// needs more than the converted FitEvent.
+  bool NeedsGeneratorEvent(int evttype);
   // bool NeedsEventReWeight(const double* x);
 
   void SetAllDials(const double* x, int n);
@@ -62,6 +67,25 @@ public:
   std::map<int, double> fAllValues;
   std::map<int, WeightEngineBase*> fAllRW;
 
+  /// One factor of the event weight: an engine, or only those calcs of the
+  /// NUISANCE engine that can change the weight.
+  struct WeightStep {
+    WeightEngineBase* Engine;
+    std::vector<NUISANCEWeightCalc*> Calcs;
+  };
+
+  /// Engines and calcs that can change the weight of events of this
+  /// generator type at the current dial values. Built on first use and
+  /// dropped whenever a dial is set or the engines are reconfigured.
+  std::vector<WeightStep> const& GetPipeline(int evttype);
+  std::map<int, std::vector<WeightStep> > fPipelines;
+
+  /// Bumped whenever a dial, the dial list or an engine may have changed,
+  /// including any engine handed out by GetRWEngine, so callers caching
+  /// results at some dial values can tell when to drop them.
+  inline unsigned long GetChangeCount() const { return fChangeCount; };
+  unsigned long fChangeCount;
+
 };
 
 #endif
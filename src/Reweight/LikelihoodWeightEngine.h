@@ -19,6 +19,8 @@ class LikelihoodWeightEngine : public WeightEngineBase {
 		void Reconfigure(bool silent = false);
 		inline double CalcWeight(BaseFitEvt* evt) { (void)evt; return 1.0;};
 		inline bool NeedsEventReWeight(){ return false; };
+		inline bool NeedsGeneratorEvent(){ return false; };
+		inline bool IsIdentity(){ return true; };
 
 		double GetDialValue(std::string name);
 };
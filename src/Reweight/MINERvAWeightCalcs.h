@@ -25,6 +25,8 @@ namespace nuisance {
         void SetDialValue(std::string name, double val);
         void SetDialValue(int rwenum, double val);
         bool IsHandled(int rwenum);
+        bool AppliesToEvent(int evttype) { return evttype == kGENIE; };
+        bool IsIdentity() { return fCur_NormCCQE == 1.0; };
 
         double fTwk_NormCCQE;
         double fCur_NormCCQE;
@@ -44,6 +46,8 @@ namespace nuisance {
         void SetDialValue(std::string name, double val);
         void SetDialValue(int rwenum, double val);
         bool IsHandled(int rwenum);
+        bool AppliesToEvent(int evttype) { return evttype == kGENIE; };
+        bool IsIdentity() { return fCur_NormCCMEC == 1.0; };
 
         double fTwk_NormCCMEC;
         double fCur_NormCCMEC;
@@ -62,6 +66,8 @@ namespace nuisance {
         void SetDialValue(std::string name, double val);
         void SetDialValue(int rwenum, double val);
         bool IsHandled(int rwenum);
+        bool AppliesToEvent(int evttype) { return evttype == kGENIE; };
+        bool IsIdentity() { return fCur_NormCCRES == 1.0; };
 
         double fTwk_NormCCRES;
         double fCur_NormCCRES;
@@ -82,6 +88,7 @@ namespace nuisance {
         void SetDialValue(int rwenum, double val);
         bool IsHandled(int rwenum);
 
+        bool IsIdentity() { return !fTweaked; };
         void SetupRPACalculator(int calcenum);
         int GetRPACalcEnum(int bpdg, int tpdg);
 
@@ -138,6 +145,8 @@ namespace nuisance {
         void SetDialValue(std::string name, double val);
         void SetDialValue(int rwenum, double val);
         bool IsHandled(int rwenum);
+        bool AppliesToEvent(int evttype) { return evttype == kGENIE; };
+        bool IsIdentity() { return !fApply_COHNorm; };
 
         bool fApply_COHNorm;
 
@@ -161,6 +170,8 @@ namespace nuisance {
         void SetDialValue(std::string name, double val);
         void SetDialValue(int rwenum, double val);
         bool IsHandled(int rwenum);
+        bool AppliesToEvent(int evttype) { return evttype == kGENIE; };
+        bool IsIdentity() { return !fApply_Enhancement; };
 
         bool fTweaked;
 
@@ -51,6 +51,15 @@ public:
     return fDialValues[fDialEnumIndex[mode]];
   };
   bool NeedsEventReWeight() { return false; };
+  bool NeedsGeneratorEvent() { return false; };
+  bool IsIdentity() {
+    for (size_t i = 0; i < fDialValues.size(); i++) {
+      if (fDialValues[i] != 1) {
+        return false;
+      }
+    }
+    return true;
+  };
 
   double GetDialValue(std::string name) {
     int rwenum = Reweight::ConvDial(name, kMODENORM);
@@ -30,6 +30,7 @@ public:
   double CalcWeight(BaseFitEvt *evt);
 
   inline bool NeedsEventReWeight() { return true; };
+  inline bool AppliesToEvent(int evttype) { return evttype == kNEUT; };
 
 #ifdef NEUTReWeight_LEGACY_API_ENABLED
   std::vector<neut::rew::NSyst_t> fNEUTSysts;
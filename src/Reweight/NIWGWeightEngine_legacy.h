@@ -51,6 +51,7 @@ public:
 	double CalcWeight(BaseFitEvt* evt);
 
 	inline bool NeedsEventReWeight() { return true; };
+	inline bool AppliesToEvent(int evttype) { return evttype == kNEUT; };
 
 	std::vector<niwg::rew::NIWGSyst_t> fNIWGSysts;
 	niwg::rew::NIWGEvent* GetNIWGEventLocal(NeutVect* nvect);
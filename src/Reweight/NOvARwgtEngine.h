@@ -35,6 +35,7 @@ public:
 
   double CalcWeight(BaseFitEvt *evt);
   bool NeedsEventReWeight() { return true; }
+  bool AppliesToEvent(int evttype) { return evttype == kGENIE; }
 
   std::map<size_t, size_t> fTuneEnums;
   std::vector<novarwgt::Tune const *> fTunes;
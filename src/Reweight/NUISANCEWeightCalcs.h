@@ -34,6 +34,12 @@ class NUISANCEWeightCalc {
     virtual void SetDialValue(int rwenum, double val) = 0;
     virtual bool IsHandled(int rwenum) = 0;
 
+    /// Whether CalcWeight can return anything other than 1 for events of
+    /// this generator type.
+    virtual bool AppliesToEvent(int evttype) { (void)evttype; return true; };
+    /// Whether CalcWeight returns 1 for every event at the current dials.
+    virtual bool IsIdentity() { return false; };
+
     virtual void Print(){};
 
     std::map<std::string, int> fDialNameIndex;
@@ -52,6 +58,7 @@ class ModeNormCalc : public NUISANCEWeightCalc {
     void SetDialValue(std::string name, double val);
     void SetDialValue(int rwenum, double val);
     bool IsHandled(int rwenum);
+    bool IsIdentity() { return fNormRES == 1.0; };
 
     double fNormRES;
 };
@@ -68,6 +75,7 @@ class MINOSRPA : public NUISANCEWeightCalc {
     bool IsHandled(int rwenum);
 
     double GetRPAWeight(double Q2);
+    bool IsIdentity() { return !fTweaked || !fApply_MINOSRPA; };
 
     bool fTweaked;
 
@@ -95,6 +103,7 @@ class LagrangeRPA : public NUISANCEWeightCalc {
     bool IsHandled(int rwenum);
 
     double GetRPAWeight(double Q2);
+    bool IsIdentity() { return !fTweaked || !fApplyRPA; };
 
     bool fTweaked;
 
@@ -115,6 +124,7 @@ class BeRPACalc : public NUISANCEWeightCalc {
     void SetDialValue(std::string name, double val);
     void SetDialValue(int rwenum, double val);
     bool IsHandled(int rwenum);
+    bool IsIdentity() { return nParams == 0; };
 
   private:
     // Parameter values
@@ -139,6 +149,7 @@ class SBLOscWeightCalc : public NUISANCEWeightCalc {
     bool IsHandled(int rwenum);
 
     double GetSBLOscWeight(double E);
+    bool IsIdentity() { return fSin2Theta == 0.0; };
 
     double fDistance;
     double fMassSplitting;
@@ -159,6 +170,10 @@ class GaussianModeCorr : public NUISANCEWeightCalc {
     double GetGausWeight(double q0, double q3, double vals[]);
     // Set the Gaussian method (tilt-shift or normal Gaussian parameters)
     void SetMethod(bool method);
+    bool IsIdentity() {
+      return !fApply_CCQE && !fApply_2p2h && !fApply_2p2h_PPandNN &&
+             !fApply_2p2h_NP && !fApply_CC1pi;
+    };
 
     // 5 pars describe the Gaussain
     // 0 norm.
@@ -21,8 +21,12 @@
 
 #include "OscWeightEngine.h"
 
+#include <algorithm>
 #include <limits>
 
+// Largest change in oscillation phase across one probability cache bin
+static const double kMaxPhaseStep = 0.1;
+
 enum nuTypes {
   kNuebarType = -1,
   kNumubarType = -2,
@@ -62,7 +66,15 @@ OscWeightEngine::OscWeightEngine()
       dcp(0.0),
       LengthParam(0xdeadbeef),
       TargetNuType(0),
-      ForceFromNuPDG(0) {
+      ForceFromNuPDG(0),
+      UseProbCache(false),
+      ProbCacheNBins(0),
+      ProbCacheAutoNBins(true),
+      ProbCacheMaxNBins(0),
+      ProbCacheLogEMin(0),
+      ProbCacheLogEMax(0),
+      ProbCacheDLogE(0),
+      ProbCacheBaselineKm(0) {
   Config();
 }
 
@@ -118,6 +130,32 @@ void OscWeightEngine::Config() {
                        ? GetNuType(OscParam[0].GetI("ForceFromNuPDG"))
                        : 0;
 
+  // Atmospheric baselines reach the Earth's diameter, where no reasonably
+  // sized grid resolves the low energy oscillations, so only cache there
+  // when asked to.
+  UseProbCache = OscParam[0].Has("exact_prob")
+                     ? !OscParam[0].GetB("exact_prob")
+                     : !LengthParamIsZenith;
+  ProbCacheAutoNBins = !OscParam[0].Has("prob_cache_nbins");
+  ProbCacheNBins = ProbCacheAutoNBins ? 1 : OscParam[0].GetI("prob_cache_nbins");
+  ProbCacheMaxNBins = OscParam[0].Has("prob_cache_max_nbins")
+                          ? OscParam[0].GetI("prob_cache_max_nbins")
+                          : 1000000;
+  double cache_emin = OscParam[0].Has("prob_cache_emin_GeV")
+                          ? OscParam[0].GetD("prob_cache_emin_GeV")
+                          : 0.01;
+  double cache_emax = OscParam[0].Has("prob_cache_emax_GeV")
+                          ? OscParam[0].GetD("prob_cache_emax_GeV")
+                          : 100.0;
+  if ((ProbCacheNBins < 1) || (cache_emin <= 0) || (cache_emax <= cache_emin)) {
+    NUIS_ABORT("Invalid oscillation probability cache: "
+               << ProbCacheNBins << " bins between " << cache_emin << " and "
+               << cache_emax << " GeV.");
+  }
+  ProbCacheLogEMin = log(cache_emin);
+  ProbCacheLogEMax = log(cache_emax);
+  ProbCacheDLogE = (ProbCacheLogEMax - ProbCacheLogEMin) / ProbCacheNBins;
+
   NUIS_LOG(FIT, "Configured oscillation weighter:");
 
   if (LengthParamIsZenith) {
@@ -159,6 +197,73 @@ void OscWeightEngine::Config() {
 
   if (LengthParamIsZenith) {
     NUIS_LOG(FIT, "\tBaseline   : " << (bp.GetBaseline() / 100.0) << " km.");
+
+    // Chord from a production height of 15 km to the detector, negative
+    // cos(zenith) is up-going.
+    static const double kEarthRadiusKm = 6371.0;
+    static const double kProductionHeightKm = 15.0;
+    double sinsqz = 1 - LengthParam * LengthParam;
+    ProbCacheBaselineKm =
+        sqrt(pow(kEarthRadiusKm + kProductionHeightKm, 2) -
+             kEarthRadiusKm * kEarthRadiusKm * sinsqz) -
+        kEarthRadiusKm * LengthParam;
+  } else {
+    ProbCacheBaselineKm = LengthParam;
+  }
+
+  if (UseProbCache) {
+    SizeProbCache();
+  }
+  if (UseProbCache) {
+    NUIS_LOG(FIT, "\tProbability cache: "
+                      << ProbCacheNBins << " log bins between " << cache_emin
+                      << " and " << cache_emax << " GeV, "
+                      << GetProbCachePhaseStep()
+                      << " rad maximum phase step per bin.");
+    if (GetProbCachePhaseStep() > kMaxPhaseStep) {
+      NUIS_ERR(WRN, "Oscillation probability cache of "
+                        << ProbCacheNBins << " bins steps the phase by more "
+                        << "than " << kMaxPhaseStep
+                        << " rad per bin and will alias, remove "
+                           "prob_cache_nbins to size it automatically.");
+    }
+  } else {
+    NUIS_LOG(FIT, "\tExact probabilities for every event.");
+  }
+}
+
+double OscWeightEngine::GetProbCachePhaseStep() {
+  // The vacuum phase 1.267 dm2 L/E [eV^2 km/GeV] changes by itself times
+  // dlnE across a bin, most at the lowest energy. Matter effects are not
+  // included.
+  double dm2 = std::max(fabs(params[dm23_idx]), fabs(params[dm12_idx]));
+  return 1.267 * dm2 * ProbCacheBaselineKm * exp(-ProbCacheLogEMin) *
+         ProbCacheDLogE;
+}
+
+void OscWeightEngine::SizeProbCache() {
+  if (!ProbCacheAutoNBins) {
+    return;
+  }
+
+  int nbins = ProbCacheNBins;
+  ProbCacheDLogE = (ProbCacheLogEMax - ProbCacheLogEMin);
+  double needed = GetProbCachePhaseStep() / kMaxPhaseStep;
+  if (needed > ProbCacheMaxNBins) {
+    NUIS_ERR(WRN, "Oscillation probability cache would need "
+                      << ceil(needed) << " bins to keep the phase step below "
+                      << kMaxPhaseStep << " rad, more than prob_cache_max_nbins "
+                      << ProbCacheMaxNBins
+                      << ". Using exact probabilities for every event.");
+    UseProbCache = false;
+    ProbCache.clear();
+    return;
+  }
+
+  ProbCacheNBins = std::max(int(ceil(needed)), 1);
+  ProbCacheDLogE = (ProbCacheLogEMax - ProbCacheLogEMin) / ProbCacheNBins;
+  if (ProbCacheNBins != nbins) {
+    ProbCache.clear();
   }
 }
 
@@ -253,14 +358,64 @@ double OscWeightEngine::CalcWeight(double ENu, int PDGNu, int TargetPDGNu) {
     return 1;
   }
   int NuType = (ForceFromNuPDG != 0) ? ForceFromNuPDG : GetNuType(PDGNu);
+  TargetPDGNu = (TargetPDGNu == -1) ? (TargetNuType ? TargetNuType : NuType)
+                                    : GetNuType(TargetPDGNu);
+
+  if (UseProbCache) {
+    return GetCachedProb(ENu, NuType, TargetPDGNu);
+  }
+  return CalcProb(ENu, NuType, TargetPDGNu);
+}
+
+double OscWeightEngine::GetCachedProb(double ENu, int NuType,
+                                      int TargetType) {
+  double x = (log(ENu) - ProbCacheLogEMin) / ProbCacheDLogE;
+  if (!(x >= 0) || (x >= ProbCacheNBins)) {
+    return CalcProb(ENu, NuType, TargetType);
+  }
+
+  // Any parameter change invalidates every grid
+  bool changed = ProbCache.empty();
+  for (int i = 0; i < 6; ++i) {
+    changed = changed || (ProbCacheParams[i] != params[i]);
+    ProbCacheParams[i] = params[i];
+  }
+  if (changed) {
+    // A larger mass splitting needs a finer grid
+    SizeProbCache();
+    if (!UseProbCache) {
+      return CalcProb(ENu, NuType, TargetType);
+    }
+    x = std::min((log(ENu) - ProbCacheLogEMin) / ProbCacheDLogE,
+                 ProbCacheNBins - 1E-9);
+    ProbCache.assign(49, std::vector<double>());
+  }
+
+  std::vector<double> &grid = ProbCache[(NuType + 3) * 7 + (TargetType + 3)];
+  if (grid.empty()) {
+    grid.assign(ProbCacheNBins + 1, -1);
+  }
+
+  int bin = int(x);
+  double frac = x - bin;
+  for (int node = bin; node < bin + 2; ++node) {
+    if (grid[node] < 0) {
+      grid[node] =
+          CalcProb(exp(ProbCacheLogEMin + node * ProbCacheDLogE), NuType,
+                   TargetType);
+    }
+  }
+
+  return (1 - frac) * grid[bin] + frac * grid[bin + 1];
+}
+
+double OscWeightEngine::CalcProb(double ENu, int NuType, int TargetPDGNu) {
   bp.SetMNS(params[theta12_idx], params[theta13_idx], params[theta23_idx],
             params[dm12_idx], params[dm23_idx], params[dcp_idx], ENu, true,
             NuType);
 
   int pmt = 0;
   double prob_weight = 1;
-  TargetPDGNu = (TargetPDGNu == -1) ? (TargetNuType ? TargetNuType : NuType)
-                                    : GetNuType(TargetPDGNu);
 
   if (LengthParamIsZenith) {  // Use earth density
     bp.DefinePath(LengthParam, 0);
@@ -28,6 +28,7 @@
 #include "BargerPropagator.h"
 
 #include <cmath>
+#include <vector>
 
 class BG : public BargerPropagator {
  public:
@@ -92,6 +93,38 @@ class OscWeightEngine : public WeightEngineBase {
   /// the incoming events.
   int ForceFromNuPDG;
 
+  /// Whether to look probabilities up from the cache below.
+  bool UseProbCache;
+  /// Number of log-spaced Enu bins in the cache.
+  int ProbCacheNBins;
+  /// Whether ProbCacheNBins is sized from the oscillation phase rather than
+  /// given by prob_cache_nbins.
+  bool ProbCacheAutoNBins;
+  /// Above this many bins exact probabilities are used instead.
+  int ProbCacheMaxNBins;
+  double ProbCacheLogEMin;
+  double ProbCacheLogEMax;
+  double ProbCacheDLogE;
+  /// Longest baseline the cached probabilities are used for [km]
+  double ProbCacheBaselineKm;
+  /// Parameter values the cached probabilities were calculated with.
+  double ProbCacheParams[6];
+  /// Cached probabilities at each grid node, one grid per flavour pair.
+  ///
+  /// Nodes are calculated on first use and all grids are dropped whenever an
+  /// oscillation parameter changes.
+  std::vector<std::vector<double> > ProbCache;
+
+  /// Exact oscillation probability, ENu [GeV]
+  double CalcProb(double ENu, int NuType, int TargetType);
+  /// Interpolated probability from the cache, ENu [GeV]
+  double GetCachedProb(double ENu, int NuType, int TargetType);
+  /// Largest change in vacuum oscillation phase across one cache bin [rad]
+  double GetProbCachePhaseStep();
+  /// Size an automatic cache to keep the phase step below 0.1 rad at the
+  /// current parameters, falling back to exact probabilities if too large.
+  void SizeProbCache();
+
  public:
   OscWeightEngine();
 
@@ -110,6 +143,14 @@ class OscWeightEngine : public WeightEngineBase {
   /// If none are present, a vacuum oscillation is calculated.
   /// If TargetNuPDG is unspecified, oscillation will default to
   /// disappearance probability.
+  ///
+  /// Probabilities are interpolated from a grid in log(Enu) per flavour pair,
+  /// configured with prob_cache_emin_GeV="XX" prob_cache_emax_GeV="XX".
+  /// Unless prob_cache_nbins="XX" is given, the grid is sized so the vacuum
+  /// phase moves by at most 0.1 rad per bin, using exact probabilities if
+  /// that needs more than prob_cache_max_nbins="XX". Events outside the
+  /// grid, or every event if exact_prob="1", use the full calculation. With
+  /// detection_zenith_deg, exact_prob defaults to "1".
   void Config();
 
   // Functions requiring Override
@@ -127,6 +168,7 @@ class OscWeightEngine : public WeightEngineBase {
   void Reconfigure(bool silent);
 
   bool NeedsEventReWeight();
+  bool NeedsGeneratorEvent() { return false; };
 
   double CalcWeight(BaseFitEvt* evt);
   /// ENu [GeV]
@@ -76,7 +76,11 @@ double SplineWeightEngine::CalcWeight(BaseFitEvt *evt) {
     evt->fSplineRead->Reconfigure(fSplineValueMap);
   }
 
-  double rw_weight = evt->fSplineRead->CalcWeight(evt->fSplineCoeff);
+  double rw_weight =
+      evt->fSplineMask
+          ? evt->fSplineRead->CalcWeightPacked(evt->fSplineMask,
+                                               evt->fSplineCoeff)
+          : evt->fSplineRead->CalcWeight(evt->fSplineCoeff);
   if (rw_weight < 0.0)
     rw_weight = 0.0;
 
@@ -30,6 +30,7 @@ public:
   double CalcWeight(BaseFitEvt *evt);
 
   inline bool NeedsEventReWeight() { return true; };
+  inline bool AppliesToEvent(int evttype) { return evttype == kNEUT; };
 
 #ifdef T2KReWeight_LEGACY_API_ENABLED
   std::vector<t2krew::T2KSyst_t> fT2KSysts;
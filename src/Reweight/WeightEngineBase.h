@@ -22,7 +22,7 @@
 
 class WeightEngineBase {
  public:
-  WeightEngineBase(){};
+  WeightEngineBase() : fTimingID(-1){};
   virtual ~WeightEngineBase(){};
 
   // Functions requiring Override
@@ -41,6 +41,17 @@ class WeightEngineBase {
 
   virtual double CalcWeight(BaseFitEvt* evt) = 0;
   virtual bool NeedsEventReWeight() = 0;
+  /// Whether CalcWeight reads generator-level event information, rather than
+  /// only the converted FitEvent.
+  virtual bool NeedsGeneratorEvent() { return true; };
+  /// Whether CalcWeight can return anything other than 1 for events of this
+  /// generator type (BaseFitEvt::fType).
+  virtual bool AppliesToEvent(int evttype) {
+    (void)evttype;
+    return true;
+  };
+  /// Whether CalcWeight returns 1 for every event at the current dial values.
+  virtual bool IsIdentity() { return false; };
 
   std::string GetNameFromEnum(int nuisenum);
 
@@ -52,6 +63,7 @@ class WeightEngineBase {
   std::map<std::string, std::vector<size_t> > fNameIndex;
 
   std::string fCalcName;
+  int fTimingID; ///< TimingUtils id, registered on first timed call
 };
 
 #endif
@@ -134,6 +134,7 @@ ComparisonRoutines::ComparisonRoutines(int argc, char *argv[]) {
   std::cout << "[ NUISANCE ]: Setting ERROR=" << errorcount << std::endl;
   SETVERBOSITY(verbocount);
   SETTRACE(trace);
+  SETLOGBUFFER(Config::GetParB("LOGBUFFER"));
 
   // Comparison Setup ========================================
 
@@ -19,8 +19,11 @@
 
 #include "MinimizerRoutines.h"
 
+#include "FCNWorkers.h"
 #include "Simple_MH_Sampler.h"
 
+#include <algorithm>
+
 /*
   Constructor/Destructor
 */
@@ -53,13 +56,14 @@ void MinimizerRoutines::Init() {
   fMinimizer = NULL;
   fMinimizerFCN = NULL;
   fCallFunctor = NULL;
+  fCallGradFunctor = NULL;
 
   fAllowedRoutines = ("Migrad,Simplex,Combined,"
                       "Brute,Fumili,ConjugateFR,"
                       "ConjugatePR,BFGS,BFGS2,"
                       "SteepDesc,GSLSimAn,FixAtLim,FixAtLimBreak,"
                       "Chi2Scan1D,Chi2Scan2D,Contours,ErrorBands,"
-                      "DataToys,MCMC");
+                      "DataToys,DataToyFits,MCMC");
 };
 
 //*************************************
@@ -160,6 +164,7 @@ MinimizerRoutines::MinimizerRoutines(int argc, char *argv[]) {
   std::cout << "[ NUISANCE ]: Setting ERROR=" << errorcount << std::endl;
   SETVERBOSITY(verbocount);
   SETTRACE(trace);
+  SETLOGBUFFER(Config::GetParB("LOGBUFFER"));
 
   // Minimizer Setup ========================================
   fOutputRootFile = new TFile(fCompKey.GetS("outputfile").c_str(), "RECREATE");
@@ -403,6 +408,8 @@ void MinimizerRoutines::SetupFCN() {
 
   fMinimizerFCN = new MinimizerFCN(fSampleFCN);
   fCallFunctor = new ROOT::Math::Functor(*fMinimizerFCN, fParams.size());
+  fCallGradFunctor =
+      new ROOT::Math::GradFunctor(*fMinimizerFCN, fParams.size());
 
   fSampleFCN->CreateIterationTree("fit_iterations", FitBase::GetRW());
 
@@ -478,7 +485,18 @@ void MinimizerRoutines::SetupFitter(std::string routine) {
   fMinimizer->SetMaxIterations(FitPar::Config().GetParI("MAXITERATIONS"));
   fMinimizer->SetTolerance(FitPar::Config().GetParD("TOLERANCE"));
   fMinimizer->SetStrategy(FitPar::Config().GetParI("STRATEGY"));
-  fMinimizer->SetFunction(*fCallFunctor);
+
+  // Spline only fits can take the weight derivatives from the spline
+  // coefficients and refill the affected samples once per dial, instead of
+  // finite differences in the minimizer.
+  if (!UseMCMC && fittype.compare("Scan") &&
+      FitPar::Config().GetParB("AnalyticGradients") &&
+      fSampleFCN->HasAnalyticGradient()) {
+    NUIS_LOG(FIT, "Using analytic spline gradients for " << routine);
+    fMinimizer->SetFunction(*fCallGradFunctor);
+  } else {
+    fMinimizer->SetFunction(*fCallFunctor);
+  }
 
   int ipar = 0;
   // Add Fit Parameters
@@ -618,6 +636,8 @@ void MinimizerRoutines::Run() {
       fitstate = FixAtLimit();
     else if (routine.find("ErrorBands") != std::string::npos)
       GenerateErrorBands();
+    else if (routine == "DataToyFits")
+      RunDataToyFits();
     else if (routine.find("DataToys") != std::string::npos)
       ThrowDataToys();
     else if (!routine.compare("Chi2Scan1D"))
@@ -634,6 +654,7 @@ void MinimizerRoutines::Run() {
     }
   }
 
+  fSampleFCN->PrintEvalCacheStats();
   return;
 }
 
@@ -828,6 +849,9 @@ void MinimizerRoutines::Create1DScans() {
   // Steps through all free parameters about nominal using the step size
   // Creates a graph for each free parameter
 
+  // Scans can run before any fit has told the FCN its parameter count
+  fSampleFCN->SetNParams(fParams.size());
+
   // At the current point create a 1D Scan for all parametes (Uncorrelated)
   for (UInt_t i = 0; i < fParams.size(); i++) {
     if (fFixVals[fParams[i]])
@@ -851,18 +875,24 @@ void MinimizerRoutines::Create1DScans() {
                  ("Chi2Scan1D_" + fParams[i] + ";" + fParams[i]).c_str(),
                  npoints, limlow, limhigh);
 
-    // Fill bins
+    // Scan points
+    std::vector<double> points;
     for (int x = 0; x < contour->GetNbinsX(); x++) {
       // Set X Val
       fCurVals[fParams[i]] = contour->GetXaxis()->GetBinCenter(x + 1);
 
-      // Run Eval
       double *vals = FitUtils::GetArrayFromMap(fParams, fCurVals);
-      double chi2 = fSampleFCN->DoEval(vals);
-      delete vals;
+      points.insert(points.end(), vals, vals + fParams.size());
+      delete[] vals;
+    }
 
-      // Fill Contour
-      contour->SetBinContent(x + 1, chi2);
+    // Run Eval
+    std::vector<double> chi2;
+    fSampleFCN->DoEvalPoints(points, chi2);
+
+    // Fill bins
+    for (int x = 0; x < contour->GetNbinsX(); x++) {
+      contour->SetBinContent(x + 1, chi2[x]);
     }
 
     // Save contour
@@ -886,6 +916,9 @@ void MinimizerRoutines::Chi2Scan2D() {
   // Creates a 2D chi2 scan by stepping through all free parameters
   // Works for all pairwise combos of free parameters
 
+  // Scans can run before any fit has told the FCN its parameter count
+  fSampleFCN->SetNParams(fParams.size());
+
   // Scan I
   for (UInt_t i = 0; i < fParams.size(); i++) {
     if (fFixVals[fParams[i]])
@@ -924,7 +957,8 @@ void MinimizerRoutines::Chi2Scan2D() {
       // Begin Scan
       NUIS_LOG(FIT, "Running scan for " << fParams[i] << " " << fParams[j]);
 
-      // Fill bins
+      // Scan points
+      std::vector<double> points;
       for (int x = 0; x < contour->GetNbinsX(); x++) {
         // Set X Val
         fCurVals[fParams[i]] = contour->GetXaxis()->GetBinCenter(x + 1);
@@ -934,13 +968,9 @@ void MinimizerRoutines::Chi2Scan2D() {
           // Set Y Val
           fCurVals[fParams[j]] = contour->GetYaxis()->GetBinCenter(y + 1);
 
-          // Run Eval
           double *vals = FitUtils::GetArrayFromMap(fParams, fCurVals);
-          double chi2 = fSampleFCN->DoEval(vals);
-          delete vals;
-
-          // Fill Contour
-          contour->SetBinContent(x + 1, y + 1, chi2);
+          points.insert(points.end(), vals, vals + fParams.size());
+          delete[] vals;
 
           fCurVals[fParams[j]] = scanmid_j;
         }
@@ -949,6 +979,18 @@ void MinimizerRoutines::Chi2Scan2D() {
         fCurVals[fParams[j]] = scanmid_j;
       }
 
+      // Run Eval
+      std::vector<double> chi2;
+      fSampleFCN->DoEvalPoints(points, chi2);
+
+      // Fill Contour
+      int ipoint = 0;
+      for (int x = 0; x < contour->GetNbinsX(); x++) {
+        for (int y = 0; y < contour->GetNbinsY(); y++) {
+          contour->SetBinContent(x + 1, y + 1, chi2[ipoint++]);
+        }
+      }
+
       // Save contour
       contour->Write();
 
@@ -1544,10 +1586,13 @@ void MinimizerRoutines::ThrowDataToys() {
   SETVERBOSITY(FIT);
 
   int nthrows = FitPar::Config().GetParI("NToyThrows");
+  fSampleFCN->SetToySeed(FitPar::Config().GetParI("ToyThrowSeed"),
+                         FitPar::Config().GetParI("ToyThrowBatch"));
+
   double maxlike = -1.0;
   double minlike = -1.0;
   std::vector<double> values;
-  for (int i = 0; i < 1.E4; i++) {
+  for (int i = 0; i < nthrows; i++) {
     fSampleFCN->ThrowDataToy();
     double like = fSampleFCN->GetLikelihood();
     values.push_back(like);
@@ -1570,3 +1615,152 @@ void MinimizerRoutines::ThrowDataToys() {
   fOutputRootFile->cd();
   likes->Write();
 }
+
+void MinimizerRoutines::RunDataToyFits() {
+  int ntoys = FitPar::Config().GetParI("NToyFits");
+  int nworkers = std::max(1, FitPar::Config().GetParI("ToyFitWorkers"));
+  std::string routine = FitPar::Config().GetParS("ToyFitRoutine");
+  if (ntoys <= 0) {
+    return;
+  }
+  nworkers = std::min(nworkers, ntoys);
+
+  bool anyfree = false;
+  for (size_t i = 0; i < fParams.size(); i++) {
+    anyfree = anyfree || !fFixVals[fParams[i]];
+  }
+  if (!anyfree) {
+    NUIS_ABORT("DataToyFits needs at least one free parameter.");
+  }
+
+  // Forked toy fits would share the sockets of any FCN workers
+  if (FitPar::Config().GetParI("DistributedNWorkers") > 1 ||
+      FitPar::Config().GetParI("DistributedNRemote") > 0) {
+    NUIS_ABORT("DataToyFits can not be combined with distributed FCN "
+               "workers, use ToyFitWorkers instead.");
+  }
+
+  // Refitting the unfluctuated data of some samples would bias every toy
+  std::list<MeasurementBase *> samples = fSampleFCN->GetSampleList();
+  std::vector<std::string> unthrown;
+  for (std::list<MeasurementBase *>::iterator iter = samples.begin();
+       iter != samples.end(); iter++) {
+    if (!(*iter)->CanThrowCovariance()) {
+      unthrown.push_back((*iter)->GetName());
+    }
+  }
+  if (!unthrown.empty()) {
+    for (size_t i = 0; i < unthrown.size(); i++) {
+      NUIS_ERR(FTL, "Sample " << unthrown[i]
+                              << " can not throw its data covariance.");
+    }
+    NUIS_ABORT("DataToyFits needs every sample to throw its data, remove the "
+               << unthrown.size() << " sample(s) above.");
+  }
+
+  // Every toy has its own stream, so results don't depend on nworkers
+  UInt_t seed = FitPar::Config().GetParI("ToyThrowSeed");
+  if (!seed) {
+    seed = 1 + gRandom->Integer(kMaxUInt - 1);
+  }
+
+  // Fill the MC caches once here, the workers share them copy-on-write.
+  double *vals = FitUtils::GetArrayFromMap(fParams, fCurVals);
+  fSampleFCN->DoEval(vals);
+  delete[] vals;
+
+  NUIS_LOG(FIT, "Fitting " << ntoys << " data toys with " << routine << " in "
+                           << nworkers << " processes, seed " << seed);
+  FCNWorkerPool pool;
+  int slice = 0;
+  int fd = pool.ForkLocal(nworkers, slice);
+  if (fd >= 0) {
+    FitDataToySlice(fd, slice, nworkers, ntoys, seed, routine);
+  }
+
+  std::vector<std::vector<double> > results;
+  pool.Gather(kFCNWorkerToyFits, results);
+  pool.Stop();
+
+  // Each result is toy, status, likelihood, edm, values, errors
+  size_t npars = fParams.size();
+  size_t width = 4 + 2 * npars;
+  std::vector<double const *> rows(ntoys, (double const *)NULL);
+  for (size_t w = 0; w < results.size(); w++) {
+    for (size_t r = 0; r + width <= results[w].size(); r += width) {
+      rows[int(results[w][r])] = &results[w][r];
+    }
+  }
+
+  int toy = 0;
+  int status = 0;
+  double CHI2 = 0.0;
+  double EDM = 0.0;
+  std::vector<std::string> nameVect = fParams;
+  std::vector<double> valVect(npars);
+  std::vector<double> errVect(npars);
+
+  fOutputRootFile->cd();
+  TTree *toy_tree = new TTree("toy_fits", "toy_fits");
+  toy_tree->Branch("toy", &toy, "toy/I");
+  toy_tree->Branch("status", &status, "status/I");
+  toy_tree->Branch("CHI2", &CHI2, "CHI2/D");
+  toy_tree->Branch("EDM", &EDM, "EDM/D");
+  toy_tree->Branch("parameter_names", &nameVect);
+  toy_tree->Branch("parameter_values", &valVect);
+  toy_tree->Branch("parameter_errors", &errVect);
+
+  int nfitted = 0;
+  for (int t = 0; t < ntoys; t++) {
+    if (!rows[t]) {
+      continue;
+    }
+    toy = t;
+    status = rows[t][1];
+    CHI2 = rows[t][2];
+    EDM = rows[t][3];
+    std::copy(rows[t] + 4, rows[t] + 4 + npars, valVect.begin());
+    std::copy(rows[t] + 4 + npars, rows[t] + width, errVect.begin());
+    toy_tree->Fill();
+    nfitted++;
+  }
+
+  NUIS_LOG(FIT, "Writing " << nfitted << " toy fits");
+  toy_tree->Write();
+  delete toy_tree;
+}
+
+void MinimizerRoutines::FitDataToySlice(int fd, int slice, int nslices,
+                                        int ntoys, UInt_t seed,
+                                        std::string const &routine) {
+  // Each minimisation rereads events alongside the other workers
+  fSampleFCN->ReopenInputs();
+  SETVERBOSITY(QUIET);
+
+  std::map<std::string, double> startvals = fCurVals;
+  UInt_t seedstride = fSampleFCN->GetSubSampleList().size();
+
+  std::vector<double> results;
+  for (int toy = slice; toy < ntoys; toy += nslices) {
+    fSampleFCN->SetToySeed(seed + toy * seedstride, 1);
+    fSampleFCN->ThrowDataCovariance();
+
+    fCurVals = startvals;
+    SetupFitter(routine);
+    fMinimizer->Minimize();
+
+    results.push_back(toy);
+    results.push_back(fMinimizer->Status());
+    results.push_back(fMinimizer->MinValue());
+    results.push_back(fMinimizer->Edm());
+    for (size_t i = 0; i < fParams.size(); i++) {
+      results.push_back(fMinimizer->X()[i]);
+    }
+    for (size_t i = 0; i < fParams.size(); i++) {
+      results.push_back(fMinimizer->Errors()[i]);
+    }
+  }
+
+  FCNWorkers::Send(fd, kFCNWorkerToyFits, results);
+  FCNWorkers::Exit(fd);
+}
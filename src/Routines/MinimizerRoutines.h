@@ -211,6 +211,16 @@ void SetupMinimizerFromXML();
   /// Makes a histogram of likelihoods when throwing the data according to its statistics
   void ThrowDataToys();
 
+  //! Refit NToyFits data toys, thrown from each sample's covariance, with
+  //! ToyFitRoutine. The fits run in ToyFitWorkers forked processes that
+  //! share the MC caches filled here, and are saved to the toy_fits tree.
+  void RunDataToyFits();
+
+  //! Worker side of RunDataToyFits: fit toys slice, slice + nslices, ...
+  //! and send the results back over fd. Exits the process when done.
+  void FitDataToySlice(int fd, int slice, int nslices, int ntoys, UInt_t seed,
+                       std::string const &routine);
+
 protected:
 
   //! Our Custom ReWeight Object
@@ -231,6 +241,7 @@ protected:
   JointFCN* fSampleFCN;
   MinimizerFCN* fMinimizerFCN;
   ROOT::Math::Functor* fCallFunctor;
+  ROOT::Math::GradFunctor* fCallGradFunctor;
 
   int nfreepars;
 
@@ -994,7 +994,8 @@ void SplineRoutines::GenerateEventSplines() {
     outputfile->cd();
     TTree *splinetree = new TTree("spline_tree", "spline_tree");
 
-    splinetree->Branch("SplineCoeff", coeff, Form("SplineCoeff[%d]/F", npar));
+    SplineCoeffTree splcoeffs(splwrite);
+    splcoeffs.Branch(splinetree);
 
     std::cout << "Saving to the allcoeff" << std::endl;
     for (int k = 0; k < nevents; k++) {
@@ -1003,6 +1004,7 @@ void SplineRoutines::GenerateEventSplines() {
       }
       std::cout << "Coeff 0, 1, 2 = " << coeff[0] << " " << coeff[1] << " "
                 << coeff[2] << std::endl;
+      splcoeffs.SetCoefficients(coeff);
       splinetree->Fill();
     }
 
@@ -1132,7 +1134,8 @@ void SplineRoutines::BuildEventSplines(int procchunk) {
     TTree *splinetree = new TTree("spline_tree", "spline_tree");
 
     float *coeff = new float[npar];
-    splinetree->Branch("SplineCoeff", coeff, Form("SplineCoeff[%d]/F", npar));
+    SplineCoeffTree splcoeffs(splwrite);
+    splcoeffs.Branch(splinetree);
 
     // Load N Chunks of the Weights into Memory
     // Split into N processing chunks
@@ -1206,6 +1209,7 @@ void SplineRoutines::BuildEventSplines(int procchunk) {
         }
         // std::cout << "Coeff 0, 1, 2 = " << coeff[0] << " " << coeff[1] << " "
         // << coeff[2] << std::endl;
+        splcoeffs.SetCoefficients(coeff);
         splinetree->Fill();
       }
 
@@ -1309,7 +1313,8 @@ void SplineRoutines::MergeEventSplinesChunks() {
     TTree *splinetree = new TTree("spline_tree", "spline_tree");
 
     float *coeff = new float[npar];
-    splinetree->Branch("SplineCoeff", coeff, Form("SplineCoeff[%d]/F", npar));
+    SplineCoeffTree splcoeffs(splwrite);
+    splcoeffs.Branch(splinetree);
 
     // Load N Chunks of the Weights into Memory
     // Split into N processing chunks
@@ -1330,22 +1335,20 @@ void SplineRoutines::MergeEventSplinesChunks() {
       // Get TTree for spline coeffchunk
       TTree *splinetreechunk = (TTree *)chunkfile->Get("spline_tree");
 
-      // Set Branch Address to coeffchunk
-      float *coeffchunk = new float[npar];
-      splinetreechunk->SetBranchAddress("SplineCoeff", coeffchunk);
+      // Chunks may be dense or sparse
+      SplineCoeffTree chunkcoeffs(splwrite);
+      chunkcoeffs.SetBranchAddress(splinetreechunk);
 
       // Loop over nevents in chunk
       for (int k = 0; k < neventsinchunk; k++) {
         splinetreechunk->GetEntry(k);
-        for (int j = 0; j < npar; j++) {
-          coeff[j] = coeffchunk[j];
-        }
+        chunkcoeffs.GetCoefficients(coeff);
+        splcoeffs.SetCoefficients(coeff);
         splinetree->Fill();
       }
 
       // Close up
       chunkfile->Close();
-      delete coeffchunk;
 
       std::cout << "Merged chunk " << ichunk << std::endl;
     }
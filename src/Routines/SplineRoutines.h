@@ -48,6 +48,7 @@
 #include "NuisConfig.h"
 #include "NuisKey.h"
 #include "SplineReader.h"
+#include "SplineCoeffs.h"
 #include "SplineWriter.h"
 #include "SplineMerger.h"
 #include "ParserUtils.h"
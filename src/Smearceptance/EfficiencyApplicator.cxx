@@ -82,9 +82,6 @@ TH1 *GetEffHist(TFile *inputFile, std::string const &HistName) {
 ///   <VisThreshold PDG="2212" VisThresholdKE_MeV="10" Contrib="K" />
 /// </EfficiencyApplicator>
 void EfficiencyApplicator::SpecifcSetup(nuiskey &nk) {
-  rand.~TRandom3();
-  new (&rand) TRandom3();
-
   std::vector<nuiskey> effDescriptors =
       nk.GetListOfChildNodes("EfficiencyCurve");
 
@@ -167,8 +164,9 @@ void EfficiencyApplicator::SpecifcSetup(nuiskey &nk) {
   SlaveTA.Setup(nk);
 }
 
-RecoInfo *EfficiencyApplicator::Smearcept(FitEvent *fe) {
-  RecoInfo *ri = new RecoInfo();
+void EfficiencyApplicator::Smearcept(FitEvent *fe, RecoInfo *ri,
+                                     TRandom3 *rng) {
+  ri->Reset();
 
   for (size_t p_it = 0; p_it < fe->NParticles(); ++p_it) {
     FitParticle *fp = fe->GetParticle(p_it);
@@ -196,7 +194,7 @@ RecoInfo *EfficiencyApplicator::Smearcept(FitEvent *fe) {
       continue;
     }
 
-    EffMap &em = Efficiencies[fp->PDG()];
+    EffMap const &em = Efficiencies.find(fp->PDG())->second;
 
     double kineProps[3];
     for (Int_t dim_it = 0; dim_it < em.NDims; ++dim_it) {
@@ -352,7 +350,7 @@ RecoInfo *EfficiencyApplicator::Smearcept(FitEvent *fe) {
       }
     }
 
-    bool accepted = (rand.Uniform() < effProb);
+    bool accepted = (rng->Uniform() < effProb);
 
     if (accepted) {
 #ifdef DEBUG_EFFAPP
@@ -384,5 +382,11 @@ RecoInfo *EfficiencyApplicator::Smearcept(FitEvent *fe) {
   std::cout << "Reconstructed " << ri->RecObjMom.size() << " particles. "
             << std::endl;
 #endif
-  return ri;
+}
+
+EfficiencyApplicator::~EfficiencyApplicator() {
+  for (std::map<int, EffMap>::iterator em_it = Efficiencies.begin();
+       em_it != Efficiencies.end(); ++em_it) {
+    delete em_it->second.EffCurve;
+  }
 }
@@ -44,12 +44,11 @@ private:
 
   void SpecifcSetup(nuiskey &);
 
-  TRandom3 rand;
-
   ThresholdAccepter SlaveTA;
 
  public:
-  RecoInfo *Smearcept(FitEvent *);
+  using ISmearcepter::Smearcept;
+  void Smearcept(FitEvent *, RecoInfo *, TRandom3 *rng);
   ~EfficiencyApplicator();
 };
 
@@ -85,9 +85,6 @@ std::string GetKineTypeName(GaussianSmearer::DependVar dv) {
 ///   gaus(1/{V}),<lowlim>,<highlim>") (AllowNeg="0") />
 /// </GaussianSmearer>
 void GaussianSmearer::SpecifcSetup(nuiskey &nk) {
-  rand.~TRandom3();
-  new (&rand) TRandom3();
-
   std::vector<nuiskey> smearDescriptors = nk.GetListOfChildNodes("Smear");
 
   for (size_t t_it = 0; t_it < smearDescriptors.size(); ++t_it) {
@@ -191,7 +188,8 @@ void GaussianSmearer::SpecifcSetup(nuiskey &nk) {
   }
 }
 
-void GaussianSmearer::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
+void GaussianSmearer::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp,
+                                           TRandom3 *rng
 #ifdef DEBUG_GAUSSSMEAR
                                            ,
                                            size_t p_it
@@ -219,11 +217,13 @@ void GaussianSmearer::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
     return;
   }
 
-  if (TrackedGausSmears.count(fp->PDG())) {
+  // Only const lookups, the smear maps are shared between threads
+  std::map<int, std::vector<GSmear> >::const_iterator tracked =
+      TrackedGausSmears.find(fp->PDG());
+  if (tracked != TrackedGausSmears.end()) {
     TVector3 ThreeMom = fp->P3();
-    for (size_t sm_it = 0; sm_it < TrackedGausSmears[fp->PDG()].size();
-         ++sm_it) {
-      GSmear &sm = TrackedGausSmears[fp->PDG()][sm_it];
+    for (size_t sm_it = 0; sm_it < tracked->second.size(); ++sm_it) {
+      GSmear const &sm = tracked->second[sm_it];
 
       double kineProp = 0;
 
@@ -252,10 +252,9 @@ void GaussianSmearer::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
       bool ok = false;
       while (!ok) {
         if (sm.type == GaussianSmearer::kFunction) {
-          sm.func->SetParameter(0, kineProp);
-          Smeared = sm.func->GetRandom();
+          Smeared = SmearceptanceUtils::ThrowFromTF1(sm.func, kineProp, rng);
         } else {
-          double sThrow = rand.Gaus(
+          double sThrow = rng->Gaus(
               0, sm.width *
                      ((sm.type == GaussianSmearer::kAbsolute) ? 1 : kineProp));
           Smeared = kineProp + sThrow;
@@ -319,7 +318,7 @@ void GaussianSmearer::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
     ri->RecObjClass.push_back(fp->PDG());
   } else {  // Smear to EVis
 
-    GSmear &sm = VisGausSmears[fp->PDG()];
+    GSmear const &sm = VisGausSmears.find(fp->PDG())->second;
 
     double kineProp = 0;
 
@@ -337,10 +336,9 @@ void GaussianSmearer::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
 
     double Smeared;
     if (sm.type == GaussianSmearer::kFunction) {
-      sm.func->SetParameter(0, kineProp);
-      Smeared = sm.func->GetRandom();
+      Smeared = SmearceptanceUtils::ThrowFromTF1(sm.func, kineProp, rng);
     } else {
-      double sThrow = rand.Gaus(
+      double sThrow = rng->Gaus(
           0, sm.width *
                  ((sm.type == GaussianSmearer::kAbsolute) ? 1.0 : kineProp));
       Smeared = kineProp + sThrow;
@@ -359,32 +357,31 @@ void GaussianSmearer::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
 #endif
 }
 
-RecoInfo *GaussianSmearer::Smearcept(FitEvent *fe) {
-  RecoInfo *ri = new RecoInfo();
+void GaussianSmearer::Smearcept(FitEvent *fe, RecoInfo *ri, TRandom3 *rng) {
+  ri->Reset();
 
   for (size_t p_it = 0; p_it < fe->NParticles(); ++p_it) {
     FitParticle *fp = fe->GetParticle(p_it);
-    SmearceptOneParticle(ri, fp
+    SmearceptOneParticle(ri, fp, rng
 #ifdef DEBUG_GAUSSSMEAR
                          ,
                          p_it
 #endif
                          );
   }
-
-  return ri;
 }
 
 void GaussianSmearer::SmearceptOneParticle(TVector3 &RecObjMom,
-                                           int RecObjClass) {
-  if (!TrackedGausSmears.count(RecObjClass)) {
+                                           int RecObjClass, TRandom3 *rng) {
+  std::map<int, std::vector<GSmear> >::const_iterator tracked =
+      TrackedGausSmears.find(RecObjClass);
+  if (tracked == TrackedGausSmears.end()) {
     return;
   }
   TVector3 ThreeMom = RecObjMom;
   TVector3 OriginalKP = ThreeMom;
-  for (size_t sm_it = 0; sm_it < TrackedGausSmears[RecObjClass].size();
-       ++sm_it) {
-    GSmear &sm = TrackedGausSmears[RecObjClass][sm_it];
+  for (size_t sm_it = 0; sm_it < tracked->second.size(); ++sm_it) {
+    GSmear const &sm = tracked->second[sm_it];
 
     double kineProp = 0;
 
@@ -414,10 +411,9 @@ void GaussianSmearer::SmearceptOneParticle(TVector3 &RecObjMom,
     int attempt = 0;
     while (!ok) {
       if (sm.type == GaussianSmearer::kFunction) {
-        sm.func->SetParameter(0, kineProp);
-        Smeared = sm.func->GetRandom();
+        Smeared = SmearceptanceUtils::ThrowFromTF1(sm.func, kineProp, rng);
       } else {
-        double sThrow = rand.Gaus(
+        double sThrow = rng->Gaus(
             0, sm.width *
                    ((sm.type == GaussianSmearer::kAbsolute) ? 1.0 : kineProp));
         Smeared = kineProp + sThrow;
@@ -486,19 +482,20 @@ void GaussianSmearer::SmearceptOneParticle(TVector3 &RecObjMom,
 }
 
 void GaussianSmearer::SmearceptOneParticle(double &RecVisibleEnergy,
-                                           int TrueContribPDG) {
-  if (!VisGausSmears.count(TrueContribPDG)) {
+                                           int TrueContribPDG, TRandom3 *rng) {
+  std::map<int, GSmear>::const_iterator vis =
+      VisGausSmears.find(TrueContribPDG);
+  if (vis == VisGausSmears.end()) {
     return;
   }
-  GSmear &sm = VisGausSmears[TrueContribPDG];
+  GSmear const &sm = vis->second;
   double kineProp = RecVisibleEnergy;
 
   double Smeared;
   if (sm.type == GaussianSmearer::kFunction) {
-    sm.func->SetParameter(0, kineProp);
-    Smeared = sm.func->GetRandom();
+    Smeared = SmearceptanceUtils::ThrowFromTF1(sm.func, kineProp, rng);
   } else {
-    double sThrow = rand.Gaus(
+    double sThrow = rng->Gaus(
         0,
         sm.width * ((sm.type == GaussianSmearer::kAbsolute) ? 1.0 : kineProp));
     Smeared = kineProp + sThrow;
@@ -512,15 +509,15 @@ void GaussianSmearer::SmearceptOneParticle(double &RecVisibleEnergy,
   RecVisibleEnergy = Smeared;
 }
 
-void GaussianSmearer::SmearRecoInfo(RecoInfo *ri) {
+void GaussianSmearer::SmearRecoInfo(RecoInfo *ri, TRandom3 *rng) {
   // Smear tracked particles
   for (size_t p_it = 0; p_it < ri->RecObjMom.size(); ++p_it) {
-    SmearceptOneParticle(ri->RecObjMom[p_it], ri->RecObjClass[p_it]);
+    SmearceptOneParticle(ri->RecObjMom[p_it], ri->RecObjClass[p_it], rng);
   }
 
   for (size_t ve_it = 0; ve_it < ri->RecVisibleEnergy.size(); ++ve_it) {
     SmearceptOneParticle(ri->RecVisibleEnergy[ve_it],
-                         ri->TrueContribPDGs[ve_it]);
+                         ri->TrueContribPDGs[ve_it], rng);
   }
 
 #ifdef DEBUG_GAUSSSMEAR
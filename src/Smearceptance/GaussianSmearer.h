@@ -21,6 +21,7 @@
 #define GAUSSIANSMEARER_HXX_SEEN
 
 #include "ISmearcepter.h"
+#include "SmearceptanceUtils.h"
 
 #include <map>
 
@@ -42,14 +43,15 @@ class GaussianSmearer : public ISmearcepter {
   std::map<int, std::vector<GSmear> > TrackedGausSmears;
   std::map<int, GSmear> VisGausSmears;
 
-  TRandom3 rand;
-
   void SpecifcSetup(nuiskey &);
 
  public:
-  RecoInfo *Smearcept(FitEvent *);
+  using ISmearcepter::Smearcept;
+  using ISmearcepter::SmearRecoInfo;
+
+  void Smearcept(FitEvent *, RecoInfo *, TRandom3 *rng);
 
-  void SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
+  void SmearceptOneParticle(RecoInfo *ri, FitParticle *fp, TRandom3 *rng
 #ifdef DEBUG_GAUSSSMEAR
                             ,
                             size_t p_it
@@ -57,11 +59,13 @@ class GaussianSmearer : public ISmearcepter {
                             );
   /// Helper method for using this class as a component in a more complex
   /// smearer
-  void SmearRecoInfo(RecoInfo *);
+  void SmearRecoInfo(RecoInfo *, TRandom3 *rng);
 
-  void SmearceptOneParticle(TVector3 &RecObjMom, int RecObjClass);
+  void SmearceptOneParticle(TVector3 &RecObjMom, int RecObjClass,
+                            TRandom3 *rng);
 
-  void SmearceptOneParticle(double &RecVisibleEnergy, int TrueContribPDGs);
+  void SmearceptOneParticle(double &RecVisibleEnergy, int TrueContribPDGs,
+                            TRandom3 *rng);
 };
 
 #endif
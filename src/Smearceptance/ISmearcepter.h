@@ -23,13 +23,14 @@
 #include "FitEvent.h"
 #include "NuisKey.h"
 
+#include "TRandom3.h"
 #include "TVector3.h"
 
 #include <string>
 #include <vector>
 
 /// Base reconstructed information that a smearcepter should fill.
-/// Smearcepters may allocate and return instances of RecoInfo subclasses.
+/// Callers own the instance and should reuse it between events, see Reset.
 struct RecoInfo {
   RecoInfo()
       : RecObjMom(),
@@ -50,6 +51,16 @@ struct RecoInfo {
   std::vector<int> TrueContribPDGs;
 
   double Weight;
+
+  /// Empties the reconstructed objects but keeps the allocated storage, so
+  /// that filling a reused instance does not allocate once warmed up.
+  void Reset() {
+    RecObjMom.clear();
+    RecObjClass.clear();
+    RecVisibleEnergy.clear();
+    TrueContribPDGs.clear();
+    Weight = 1;
+  }
 };
 
 class ISmearcepter {
@@ -57,6 +68,9 @@ class ISmearcepter {
   std::string ElementName;
   std::string InstanceName;
 
+  /// Stream used by the single-argument convenience overloads.
+  TRandom3 DefaultRNG;
+
  public:
   void Setup(nuiskey &);
   virtual void SpecifcSetup(nuiskey &) = 0;
@@ -64,14 +78,31 @@ class ISmearcepter {
   std::string GetName() { return InstanceName; }
   std::string GetElementName() { return ElementName; }
 
-  virtual RecoInfo *Smearcept(FitEvent *) = 0;
+  /// Fills the caller-owned RecoInfo (after resetting it) for this event.
+  ///
+  /// Every random number must be drawn from rng and the smearcepter must not
+  /// modify its own state, so that one instance can be shared by several
+  /// threads that each hold their own RecoInfo and TRandom3 stream.
+  virtual void Smearcept(FitEvent *, RecoInfo *, TRandom3 *rng) = 0;
+
+  /// Convenience overload that allocates the returned RecoInfo, which the
+  /// caller must delete, and throws from DefaultRNG. Not thread-safe.
+  RecoInfo *Smearcept(FitEvent *fe) {
+    RecoInfo *ri = new RecoInfo();
+    Smearcept(fe, ri, &DefaultRNG);
+    return ri;
+  }
+
   /// Helper method for using this class as a component in a more complex
   /// smearer
-  virtual void SmearRecoInfo(RecoInfo *) {
+  virtual void SmearRecoInfo(RecoInfo *, TRandom3 *) {
     NUIS_ABORT("Smearcepter: " << ElementName
                           << " doesn't implement SmearRecoInfo.");
     ;
   }
+  void SmearRecoInfo(RecoInfo *ri) { SmearRecoInfo(ri, &DefaultRNG); }
+
+  virtual ~ISmearcepter() {}
 };
 
 template <typename T>
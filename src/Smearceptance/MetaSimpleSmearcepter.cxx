@@ -58,17 +58,17 @@ void MetaSimpleSmearcepter::SpecifcSetup(nuiskey &nk) {
   }
   NSmearcepters = Smearcepters.size();
 }
-RecoInfo *MetaSimpleSmearcepter::Smearcept(FitEvent *fe) {
+void MetaSimpleSmearcepter::Smearcept(FitEvent *fe, RecoInfo *ri,
+                                      TRandom3 *rng) {
   if (ES) {
     ES->DoTheShuffle(fe);
   }
-  RecoInfo *ri = NULL;
+  ri->Reset();
   for (size_t sm_it = 0; sm_it < NSmearcepters; ++sm_it) {
     if (!sm_it) {
-      ri = Smearcepters[sm_it]->Smearcept(fe);
+      Smearcepters[sm_it]->Smearcept(fe, ri, rng);
     } else {
-      Smearcepters[sm_it]->SmearRecoInfo(ri);
+      Smearcepters[sm_it]->SmearRecoInfo(ri, rng);
     }
   }
-  return ri;
 }
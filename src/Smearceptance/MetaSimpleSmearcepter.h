@@ -37,7 +37,10 @@ class MetaSimpleSmearcepter : public ISmearcepter {
   void SpecifcSetup(nuiskey &);
 
  public:
-  RecoInfo *Smearcept(FitEvent *);
+  MetaSimpleSmearcepter() : NSmearcepters(0), ES(NULL) {}
+
+  using ISmearcepter::Smearcept;
+  void Smearcept(FitEvent *, RecoInfo *, TRandom3 *rng);
 };
 
 #endif
@@ -23,8 +23,119 @@
 
 #include "FitLogger.h"
 
+#include <algorithm>
+
 namespace SmearceptanceUtils {
 
+BinnedSampler::BinnedSampler(TH1 const *h) : Integral(0) { SetFromHist(h); }
+
+void BinnedSampler::SetFromHist(TH1 const *h) {
+  Int_t NBins = h->GetXaxis()->GetNbins();
+
+  LowEdges.resize(NBins);
+  Widths.resize(NBins);
+  Prob.resize(NBins);
+  Alias.resize(NBins);
+
+  Integral = 0;
+  for (Int_t bi_it = 0; bi_it < NBins; ++bi_it) {
+    LowEdges[bi_it] = h->GetXaxis()->GetBinLowEdge(bi_it + 1);
+    Widths[bi_it] = h->GetXaxis()->GetBinWidth(bi_it + 1);
+    // Negative bins can never be thrown by TH1::GetRandom either.
+    Prob[bi_it] = std::max(h->GetBinContent(bi_it + 1), 0.0);
+    Integral += Prob[bi_it];
+  }
+
+  if (Integral <= 0) {
+    return;
+  }
+
+  // Vose's construction: scale to mean 1, then pair each under-full bin with
+  // an over-full one.
+  std::vector<int> Small, Large;
+  for (Int_t bi_it = 0; bi_it < NBins; ++bi_it) {
+    Prob[bi_it] *= double(NBins) / Integral;
+    Alias[bi_it] = bi_it;
+    (Prob[bi_it] < 1 ? Small : Large).push_back(bi_it);
+  }
+
+  while (Small.size() && Large.size()) {
+    int s = Small.back();
+    Small.pop_back();
+    int l = Large.back();
+
+    Alias[s] = l;
+    Prob[l] -= (1 - Prob[s]);
+    if (Prob[l] < 1) {
+      Large.pop_back();
+      Small.push_back(l);
+    }
+  }
+
+  // Anything left over is 1 up to rounding.
+  for (size_t i = 0; i < Small.size(); ++i) {
+    Prob[Small[i]] = 1;
+  }
+  for (size_t i = 0; i < Large.size(); ++i) {
+    Prob[Large[i]] = 1;
+  }
+}
+
+double BinnedSampler::Throw(TRandom3 *rng) const {
+  if (Integral <= 0) {
+    NUIS_ABORT("Attempted to throw from an empty BinnedSampler.");
+  }
+  size_t NBins = Prob.size();
+  double u = rng->Rndm() * NBins;
+  size_t bin = std::min(size_t(u), NBins - 1);
+  if ((u - bin) >= Prob[bin]) {
+    bin = Alias[bin];
+  }
+  return LowEdges[bin] + Widths[bin] * rng->Rndm();
+}
+
+double ThrowFromTF1(TF1 *f, double V, TRandom3 *rng) {
+  static int const kMaxPoints = 1000;
+
+  int NPoints = std::min(std::max(f->GetNpx(), 2), kMaxPoints);
+  double cdf[kMaxPoints + 1];
+  // Only the first parameter is set per throw, the rest keep their values.
+  // Per thread scratch, so throwing doesn't allocate.
+  static thread_local std::vector<double> params;
+  params.assign(std::max(f->GetNpar(), 1), 0.0);
+  if (f->GetNpar() > 0) {
+    std::copy(f->GetParameters(), f->GetParameters() + f->GetNpar(),
+              params.begin());
+  }
+  params[0] = V;
+
+  double xmin = f->GetXmin();
+  double step = (f->GetXmax() - xmin) / double(NPoints);
+
+  cdf[0] = 0;
+  double x = xmin;
+  double flow = std::max(f->EvalPar(&x, params.data()), 0.0);
+  for (int p_it = 0; p_it < NPoints; ++p_it) {
+    x = xmin + (p_it + 1) * step;
+    double fhigh = std::max(f->EvalPar(&x, params.data()), 0.0);
+    cdf[p_it + 1] = cdf[p_it] + 0.5 * (flow + fhigh) * step;
+    flow = fhigh;
+  }
+
+  if (cdf[NPoints] <= 0) {
+    NUIS_ABORT("Function: " << f->GetName()
+                            << " has no positive integral for V = " << V);
+  }
+
+  double r = rng->Rndm() * cdf[NPoints];
+  int bin = std::upper_bound(cdf, cdf + NPoints + 1, r) - cdf - 1;
+  bin = std::min(std::max(bin, 0), NPoints - 1);
+
+  double width = cdf[bin + 1] - cdf[bin];
+  double frac = (width > 0) ? ((r - cdf[bin]) / width) : 0.5;
+  return xmin + (bin + frac) * step;
+}
+
 double Smear1DProp(TH2D *mapping, double TrueProp, TRandom3 *rnjesus) {
   (void)mapping;
   (void)TrueProp;
@@ -17,13 +17,42 @@
 *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
 *******************************************************************************/
 
+#include "TF1.h"
 #include "TH2D.h"
 #include "TMatrixD.h"
 #include "TRandom3.h"
 #include "TVectorD.h"
 
+#include <vector>
+
 namespace SmearceptanceUtils {
 
+/// Walker alias table built from the in-range bins of a TH1.
+///
+/// Throw reproduces the distribution of TH1::GetRandom (a bin is chosen with
+/// probability proportional to its content and the value is thrown flat
+/// within it) in constant time, without allocating or touching gRandom.
+class BinnedSampler {
+  std::vector<double> LowEdges;
+  std::vector<double> Widths;
+  std::vector<double> Prob;
+  std::vector<int> Alias;
+  double Integral;
+
+ public:
+  BinnedSampler() : Integral(0) {}
+  explicit BinnedSampler(TH1 const *);
+
+  void SetFromHist(TH1 const *);
+  double GetIntegral() const { return Integral; }
+  double Throw(TRandom3 *rng) const;
+};
+
+/// Throws from f over its range, with parameter 0 set to V, by numerically
+/// inverting its cumulative distribution sampled at f->GetNpx() points.
+/// Replaces SetParameter+TF1::GetRandom so that a shared TF1 is never modified.
+double ThrowFromTF1(TF1 *f, double V, TRandom3 *rng);
+
 double Smear1DProp(TH2D *, double TrueProp, TRandom3 *rand = NULL);
 
 TVectorD SVDInverseSolve(TVectorD *inp, TMatrixD *mapping);
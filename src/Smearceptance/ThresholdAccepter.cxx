@@ -311,8 +311,8 @@ void ThresholdAccepter::SmearceptOneParticle(RecoInfo *ri, FitParticle *fp
   }
 }
 
-RecoInfo *ThresholdAccepter::Smearcept(FitEvent *fe) {
-  RecoInfo *ri = new RecoInfo();
+void ThresholdAccepter::Smearcept(FitEvent *fe, RecoInfo *ri, TRandom3 *) {
+  ri->Reset();
 
   for (size_t p_it = 0; p_it < fe->NParticles(); ++p_it) {
     FitParticle *fp = fe->GetParticle(p_it);
@@ -326,5 +326,4 @@ RecoInfo *ThresholdAccepter::Smearcept(FitEvent *fe) {
 #ifdef DEBUG_THRESACCEPT
   std::cout << std::endl;
 #endif
-  return ri;
 }
@@ -60,7 +60,9 @@ class ThresholdAccepter : public ISmearcepter {
   , size_t p_it
 #endif
     );
-  RecoInfo *Smearcept(FitEvent *);
+
+  using ISmearcepter::Smearcept;
+  void Smearcept(FitEvent *, RecoInfo *, TRandom3 *);
 };
 
 #endif
@@ -32,21 +32,22 @@ TrackedMomentumMatrixSmearer::DependVar GetVarType(std::string const &axisvar) {
 }
 }
 
-TH1D const *TrackedMomentumMatrixSmearer::SmearMap::GetRecoSlice(double val) {
+int TrackedMomentumMatrixSmearer::SmearMap::GetRecoSliceIndex(
+    double val) const {
   if ((val < RecoSlices.front().first.first) ||
       (val > RecoSlices.back().first.second)) {
     NUIS_ERR(WRN,
           "Kinematic property: " << val << ", not within smearable range: ["
                                  << RecoSlices.front().first.first << " -- "
                                  << RecoSlices.back().first.second << "].");
-    return NULL;
+    return -1;
   }
 
   int L = 0, U = RecoSlices.size();
 
   while (true) {
     if (U == L) {
-      return RecoSlices[L].second;
+      return L;
     }
     int R = (U - L);
     int m = L + (R / 2);
@@ -61,7 +62,7 @@ TH1D const *TrackedMomentumMatrixSmearer::SmearMap::GetRecoSlice(double val) {
     }
     if ((val > RecoSlices[m].first.first) &&
         (val <= RecoSlices[m].first.second)) {
-      return RecoSlices[m].second;
+      return m;
     }
     NUIS_ABORT("Binary smearing search failed. Check logic.");
   }
@@ -145,10 +146,19 @@ void TrackedMomentumMatrixSmearer::SmearMap::SetSlicesFromMap(TH2D *map,
     TH1D *slice = GetMapSlice(map, TrueSlice_it, TruthIsY);
 
     RecoSlices.push_back(std::make_pair(BinEdges, slice));
+    RecoSamplers.push_back(SmearceptanceUtils::BinnedSampler(slice));
   }
   NUIS_LOG(FIT, "\tAdded " << RecoSlices.size() << " reco slices.");
 }
 
+void TrackedMomentumMatrixSmearer::SmearMap::DeleteSlices() {
+  for (size_t sl_it = 0; sl_it < RecoSlices.size(); ++sl_it) {
+    delete RecoSlices[sl_it].second;
+  }
+  RecoSlices.clear();
+  RecoSamplers.clear();
+}
+
 /// Reads particle efficiency nodes
 ///
 /// Nodes look like:
@@ -207,8 +217,9 @@ void TrackedMomentumMatrixSmearer::SpecifcSetup(nuiskey &nk) {
   SlaveGS.Setup(nk);
 }
 
-RecoInfo *TrackedMomentumMatrixSmearer::Smearcept(FitEvent *fe) {
-  RecoInfo *ri = new RecoInfo();
+void TrackedMomentumMatrixSmearer::Smearcept(FitEvent *fe, RecoInfo *ri,
+                                             TRandom3 *rng) {
+  ri->Reset();
 
   for (size_t p_it = 0; p_it < fe->NParticles(); ++p_it) {
     FitParticle *fp = fe->GetParticle(p_it);
@@ -227,7 +238,7 @@ RecoInfo *TrackedMomentumMatrixSmearer::Smearcept(FitEvent *fe) {
     }
 
     if (!ParticleMappings.count(fp->PDG())) {
-      SlaveGS.SmearceptOneParticle(ri, fp
+      SlaveGS.SmearceptOneParticle(ri, fp, rng
 #ifdef DEBUG_GAUSSSMEAR
                                    ,
                                    p_it
@@ -236,7 +247,7 @@ RecoInfo *TrackedMomentumMatrixSmearer::Smearcept(FitEvent *fe) {
       continue;
     }
 
-    SmearMap &sm = ParticleMappings[fp->PDG()];
+    SmearMap const &sm = ParticleMappings.find(fp->PDG())->second;
     double kineProp = 0;
 
     switch (sm.SmearVar) {
@@ -255,7 +266,16 @@ RecoInfo *TrackedMomentumMatrixSmearer::Smearcept(FitEvent *fe) {
       default: { NUIS_ABORT("Trying to find particle value for a kNoAxis."); }
     }
 
-    TH1 const *recoDistrib = sm.GetRecoSlice(kineProp / sm.UnitsScale);
+    int sliceIdx = sm.GetRecoSliceIndex(kineProp / sm.UnitsScale);
+
+    if (sliceIdx < 0) {
+#ifdef DEBUG_MATSMEAR
+      std::cout << " -- outside smearable range." << std::flush;
+#endif
+      continue;
+    }
+
+    TH1 const *recoDistrib = sm.GetRecoSlice(sliceIdx);
 
 #ifdef DEBUG_MATSMEAR
     std::cout << " -- Got slice spanning ["
@@ -265,19 +285,12 @@ RecoInfo *TrackedMomentumMatrixSmearer::Smearcept(FitEvent *fe) {
               << "]" << std::endl;
 #endif
 
-    if (!recoDistrib) {
-#ifdef DEBUG_MATSMEAR
-      std::cout << " -- outside smearable range." << std::flush;
-#endif
-      continue;
-    }
-
-    if (recoDistrib->Integral() == 0) {
+    if (sm.GetRecoSampler(sliceIdx).GetIntegral() == 0) {
       NUIS_ERR(WRN, "True slice has no reconstructed events. Not smearing.")
       continue;
     }
 
-    double Smeared = recoDistrib->GetRandom() * sm.UnitsScale;
+    double Smeared = sm.GetRecoSampler(sliceIdx).Throw(rng) * sm.UnitsScale;
 #ifdef DEBUG_MATSMEAR
     std::cout << "GotRandom: " << Smeared << ", MPV: "
               << recoDistrib->GetXaxis()->GetBinCenter(
@@ -350,16 +363,16 @@ RecoInfo *TrackedMomentumMatrixSmearer::Smearcept(FitEvent *fe) {
 #ifdef DEBUG_MATSMEAR
   std::cout << std::endl;
 #endif
-  return ri;
 }
 
-void TrackedMomentumMatrixSmearer::SmearRecoInfo(RecoInfo *ri) {
+void TrackedMomentumMatrixSmearer::SmearRecoInfo(RecoInfo *ri, TRandom3 *rng) {
   for (size_t p_it = 0; p_it < ri->RecObjMom.size(); ++p_it) {
     if (!ParticleMappings.count(ri->RecObjClass[p_it])) {
-      SlaveGS.SmearceptOneParticle(ri->RecObjMom[p_it], ri->RecObjClass[p_it]);
+      SlaveGS.SmearceptOneParticle(ri->RecObjMom[p_it], ri->RecObjClass[p_it],
+                                   rng);
       continue;
     }
-    SmearMap &sm = ParticleMappings[ri->RecObjClass[p_it]];
+    SmearMap const &sm = ParticleMappings.find(ri->RecObjClass[p_it])->second;
     double kineProp = 0;
 
     switch (sm.SmearVar) {
@@ -379,17 +392,17 @@ void TrackedMomentumMatrixSmearer::SmearRecoInfo(RecoInfo *ri) {
       }
       default: { NUIS_ABORT("Trying to find particle value for a kNoAxis."); }
     }
-    TH1 const *recoDistrib = sm.GetRecoSlice(kineProp / sm.UnitsScale);
-    if (!recoDistrib) {
+    int sliceIdx = sm.GetRecoSliceIndex(kineProp / sm.UnitsScale);
+    if (sliceIdx < 0) {
       continue;
     }
 
-    if (recoDistrib->Integral() == 0) {
+    if (sm.GetRecoSampler(sliceIdx).GetIntegral() == 0) {
       NUIS_ERR(WRN, "True slice has no reconstructed events. Not smearing.")
       continue;
     }
 
-    double Smeared = recoDistrib->GetRandom() * sm.UnitsScale;
+    double Smeared = sm.GetRecoSampler(sliceIdx).Throw(rng) * sm.UnitsScale;
 
     switch (sm.SmearVar) {
       case kMomentum: {
@@ -414,3 +427,10 @@ void TrackedMomentumMatrixSmearer::SmearRecoInfo(RecoInfo *ri) {
     }
   }
 }
+
+TrackedMomentumMatrixSmearer::~TrackedMomentumMatrixSmearer() {
+  for (std::map<int, SmearMap>::iterator sm_it = ParticleMappings.begin();
+       sm_it != ParticleMappings.end(); ++sm_it) {
+    sm_it->second.DeleteSlices();
+  }
+}
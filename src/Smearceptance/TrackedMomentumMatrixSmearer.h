@@ -23,6 +23,7 @@
 #include "ISmearcepter.h"
 
 #include "GaussianSmearer.h"
+#include "SmearceptanceUtils.h"
 
 #include "TRandom3.h"
 #include "TH2D.h"
@@ -41,10 +42,19 @@ class TrackedMomentumMatrixSmearer : public ISmearcepter {
   class SmearMap {
     /// Input True -> Reco mapping.
     std::vector<std::pair<std::pair<double, double>, TH1D *> > RecoSlices;
+    /// Alias tables built from RecoSlices so that throwing is O(1) and does
+    /// not touch gRandom.
+    std::vector<SmearceptanceUtils::BinnedSampler> RecoSamplers;
 
    public:
-    TH1D const *GetRecoSlice(double val);
+    /// Returns the index of the slice containing val, or -1 if outside.
+    int GetRecoSliceIndex(double val) const;
+    TH1D const *GetRecoSlice(int idx) const { return RecoSlices[idx].second; }
+    SmearceptanceUtils::BinnedSampler const &GetRecoSampler(int idx) const {
+      return RecoSamplers[idx];
+    }
     void SetSlicesFromMap(TH2D *, bool TruthIsY);
+    void DeleteSlices();
     /// Particle variable to smear: Momentum/KE
     ///
     /// In the future should be able to smear multi-kinematic property
@@ -61,11 +71,14 @@ class TrackedMomentumMatrixSmearer : public ISmearcepter {
   void SpecifcSetup(nuiskey &);
 
  public:
+  using ISmearcepter::Smearcept;
+  using ISmearcepter::SmearRecoInfo;
+
   /// Will reject any particle that is not known about.
-  RecoInfo *Smearcept(FitEvent *);
+  void Smearcept(FitEvent *, RecoInfo *, TRandom3 *rng);
   /// Helper method for using this class as a component in a more complex
   /// smearer
-  void SmearRecoInfo(RecoInfo *);
+  void SmearRecoInfo(RecoInfo *, TRandom3 *rng);
   ~TrackedMomentumMatrixSmearer();
 };
 
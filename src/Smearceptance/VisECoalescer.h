@@ -30,13 +30,16 @@ class VisECoalescer : public ISmearcepter {
   void SpecifcSetup(nuiskey &) {}
 
  public:
-  RecoInfo *Smearcept(FitEvent *) {
+  using ISmearcepter::Smearcept;
+  using ISmearcepter::SmearRecoInfo;
+
+  void Smearcept(FitEvent *, RecoInfo *, TRandom3 *) {
     NUIS_ABORT("VisECoalescer cannot act as an accepter");
   }
 
   /// Helper method for using this class as a component in a more complex
   /// smearer
-  void SmearRecoInfo(RecoInfo *ri) {
+  void SmearRecoInfo(RecoInfo *ri, TRandom3 *) {
     std::map<Int_t, double> TotalSpeciesVisE;
 
     for (size_t ve_it = 0; ve_it < ri->RecVisibleEnergy.size(); ++ve_it) {
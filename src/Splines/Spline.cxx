@@ -1,4 +1,7 @@
 #include "Spline.h"
+
+#include <algorithm>
+
 using namespace SplineUtils;
 
 // Setup Functions
@@ -35,6 +38,7 @@ Spline::Spline(std::string splname, std::string form, std::string points) {
     }
 
     fVal.push_back(0.0);
+    fValClamped.push_back(false);
     fValMin.push_back(xmin);
     fValMax.push_back(xmax);
 
@@ -45,6 +49,22 @@ Spline::Spline(std::string splname, std::string form, std::string points) {
       iter_high++;
       off = 0;
     }
+
+    // Unique knots for grid splines
+    std::vector<float> knots;
+    for (size_t j = 0; j < gridvals.size(); j++) {
+      knots.push_back(gridvals[j][i]);
+    }
+    std::sort(knots.begin(), knots.end());
+    knots.erase(std::unique(knots.begin(), knots.end()), knots.end());
+    fGridKnots.push_back(knots);
+  }
+
+  int ngridknots = 1;
+  fGridStride.resize(fGridKnots.size(), 1);
+  for (int i = int(fGridKnots.size()) - 1; i >= 0; i--) {
+    fGridStride[i] = ngridknots;
+    ngridknots *= fGridKnots[i].size();
   }
 
   // Set form from list
@@ -68,6 +88,12 @@ Spline::Spline(std::string splname, std::string form, std::string points) {
     Setup(k2DGaus, 2, 8);
   } else if (!fForm.compare("2DTSpline3")) {
     Setup(k2DTSpline3, 2, fXScan.size() * fYScan.size() * 8);
+  } else if (!fForm.compare("1DLinearGrid")) {
+    Setup(k1DLinearGrid, 1, ngridknots);
+  } else if (!fForm.compare("1DMonoGrid")) {
+    Setup(k1DMonoGrid, 1, ngridknots);
+  } else if (!fForm.compare("NDLinearGrid")) {
+    Setup(kNDLinearGrid, fSplitNames.size(), ngridknots);
   } else {
     NUIS_ABORT("Unknown spline form : " << fForm);
   }
@@ -77,6 +103,15 @@ Spline::Spline(std::string splname, std::string form, std::string points) {
     NUIS_ABORT("Spline Dim:Names mismatch!");
   }
 
+  // Grid splines need every knot of the grid to have been generated
+  if (IsGridType() && (size_t)ngridknots != gridvals.size()) {
+    NUIS_ABORT("Grid spline " << fName << " points " << fPoints
+                              << " do not form a full grid!");
+  }
+  if (fType == kNDLinearGrid && fNDim > 16) {
+    NUIS_ABORT("Grid spline " << fName << " has too many dials!");
+  }
+
   NUIS_LOG(SAM, "Setup Spline " << fForm << " = " << fType << " " << fNPar);
 };
 
@@ -86,6 +121,16 @@ void Spline::Setup(int type, int ndim, int npar) {
   fNPar = npar;
 }
 
+bool Spline::IsGridType() const {
+  switch (fType) {
+  case k1DLinearGrid:
+  case k1DMonoGrid:
+  case kNDLinearGrid:
+    return true;
+  }
+  return false;
+}
+
 // Reconfigure Functions
 // ----------------------------------------------
 void Spline::Reconfigure(float x, int index) {
@@ -93,11 +138,16 @@ void Spline::Reconfigure(float x, int index) {
   // " << x << " " << index << std::endl;
   fVal[index] = x;
   fOutsideLimits = false;
+  fValClamped[index] = false;
 
-  if (fVal[index] > fValMax[index])
+  if (fVal[index] > fValMax[index]) {
     fVal[index] = fValMax[index];
-  if (fVal[index] < fValMin[index])
+    fValClamped[index] = true;
+  }
+  if (fVal[index] < fValMin[index]) {
     fVal[index] = fValMin[index];
+    fValClamped[index] = true;
+  }
   // std::cout << "Set at edge = " << fVal[index] << " " << index << std::endl;
 }
 
@@ -240,12 +290,52 @@ float Spline::DoEval(const Float_t *par, bool checkresponse) const {
   case k2DTSpline3: {
     return Spline2DTSpline3(par);
   }
+  case k1DLinearGrid:
+  case kNDLinearGrid: {
+    return SplineNDLinearGrid(par);
+  }
+  case k1DMonoGrid: {
+    return Spline1DMonoGrid(par);
+  }
   }
 
   // Return nominal weight
   return 1.0;
 };
 
+float Spline::DoEvalDerivative(const Float_t *par, int dim) const {
+
+  if (!par || fValClamped[dim])
+    return 0.0;
+
+  // DoEval returns a flat 1.0 without any response
+  bool hasresponse = false;
+  for (int i = 0; i < fNPar; i++) {
+    if (par[i] != 0.0) {
+      hasresponse = true;
+      break;
+    }
+  }
+  if (!hasresponse)
+    return 0.0;
+
+  switch (fType) {
+  case k1DPol1:
+  case k1DPol2:
+  case k1DPol3:
+  case k1DPol4:
+  case k1DPol5:
+  case k1DPol6: {
+    return Spline1DPolDerivative(par);
+  }
+  case k1DTSpline3: {
+    return Spline1DTSpline3Derivative(par);
+  }
+  }
+
+  return NumericDerivative(par, dim);
+}
+
 // Spline Functions
 // ----------------------------------------------
 
@@ -313,6 +403,158 @@ float Spline::Spline1DTSpline3(const Float_t *par) const {
   return weight;
 };
 
+float Spline::Spline1DPolDerivative(const Float_t *par) const {
+  float xp = fVal[0];
+
+  // Only the first fNPar coefficients are used by each polynomial form
+  float w = 0.0;
+  for (int i = fNPar - 1; i > 1; i--) {
+    w = xp * (i * par[i] + w);
+  }
+  w += par[1];
+  return w;
+}
+
+float Spline::Spline1DTSpline3Derivative(const Float_t *par) const {
+
+  // Same knot search as Spline1DTSpline3
+  iter_low = fXScan.begin();
+  iter_high = fXScan.begin();
+  iter_high++;
+  off = 0;
+  fX = fVal[0];
+
+  while (iter_high != fXScan.end() and
+         (fX < (*iter_low) or fX >= (*iter_high))) {
+    off += 4;
+    iter_low++;
+    iter_high++;
+  }
+
+  float dx = fX - (*iter_low);
+  return par[off + 1] + dx * (2.0 * par[off + 2] + dx * 3.0 * par[off + 3]);
+}
+
+float Spline::NumericDerivative(const Float_t *par, int dim) const {
+
+  // Central difference inside the spline limits
+  float val = fVal[dim];
+  float step = 1E-3 * (fValMax[dim] - fValMin[dim]);
+  if (step <= 0.0)
+    return 0.0;
+
+  float high = std::min(val + step, fValMax[dim]);
+  float low = std::max(val - step, fValMin[dim]);
+  if (high <= low)
+    return 0.0;
+
+  fVal[dim] = high;
+  float whigh = DoEval(par, false);
+  fVal[dim] = low;
+  float wlow = DoEval(par, false);
+  fVal[dim] = val;
+
+  return (whigh - wlow) / (high - low);
+}
+
+// Grid Functions
+// ----------------------------------------------
+float Spline::SplineNDLinearGrid(const Float_t *par) const {
+
+  // Lower knot and fraction of the way to the next in each dial
+  int base = 0;
+  int stride[16];
+  float frac[16];
+  for (int d = 0; d < fNDim; d++) {
+    std::vector<float> const &knots = fGridKnots[d];
+    stride[d] = fGridStride[d];
+    frac[d] = 0.0;
+    if (knots.size() < 2)
+      continue;
+
+    int low = std::upper_bound(knots.begin() + 1, knots.end() - 1, fVal[d]) -
+              knots.begin() - 1;
+    frac[d] = (fVal[d] - knots[low]) / (knots[low + 1] - knots[low]);
+    base += low * stride[d];
+  }
+
+  // Sum over the corners of the enclosing cell
+  float w = 0.0;
+  for (int corner = 0; corner < (1 << fNDim); corner++) {
+    float cw = 1.0;
+    int index = base;
+    for (int d = 0; d < fNDim && cw != 0.0; d++) {
+      if (corner & (1 << d)) {
+        cw *= frac[d];
+        index += stride[d];
+      } else {
+        cw *= 1.0 - frac[d];
+      }
+    }
+    if (cw != 0.0)
+      w += cw * par[index];
+  }
+
+  return 1.0 + w;
+}
+
+float Spline::Spline1DMonoGrid(const Float_t *par) const {
+
+  std::vector<float> const &knots = fGridKnots[0];
+  int n = knots.size();
+  if (n < 2)
+    return 1.0 + par[0];
+
+  int low = std::upper_bound(knots.begin() + 1, knots.end() - 1, fVal[0]) -
+            knots.begin() - 1;
+  float h = knots[low + 1] - knots[low];
+  float delta = (par[low + 1] - par[low]) / h;
+
+  // Fritsch-Butland tangents, flat where the neighbouring secants change
+  // sign, so the curve never overshoots the knot weights.
+  float m[2];
+  for (int k = 0; k < 2; k++) {
+    int i = low + k;
+    if (i == 0 || i == n - 1) {
+      m[k] = delta;
+      continue;
+    }
+    float hl = knots[i] - knots[i - 1];
+    float hr = knots[i + 1] - knots[i];
+    float dl = (par[i] - par[i - 1]) / hl;
+    float dr = (par[i + 1] - par[i]) / hr;
+    if (dl * dr <= 0.0) {
+      m[k] = 0.0;
+    } else {
+      float wl = 2.0 * hr + hl;
+      float wr = hr + 2.0 * hl;
+      m[k] = (wl + wr) / (wl / dl + wr / dr);
+    }
+  }
+
+  // Cubic Hermite on the interval
+  float t = (fVal[0] - knots[low]) / h;
+  float t2 = t * t;
+  float t3 = t2 * t;
+  float w = (2 * t3 - 3 * t2 + 1) * par[low] + (t3 - 2 * t2 + t) * h * m[0] +
+            (-2 * t3 + 3 * t2) * par[low + 1] + (t3 - t2) * h * m[1];
+
+  return 1.0 + w;
+}
+
+int Spline::GetGridIndex(std::vector<double> const &x) const {
+  int index = 0;
+  for (size_t d = 0; d < fGridKnots.size(); d++) {
+    std::vector<float> const &knots = fGridKnots[d];
+    std::vector<float>::const_iterator it =
+        std::lower_bound(knots.begin(), knots.end(), float(x[d]));
+    if (it == knots.end() || *it != float(x[d]))
+      return -1;
+    index += (it - knots.begin()) * fGridStride[d];
+  }
+  return index;
+}
+
 // 2D Functions
 // ----------------------------------------------
 float Spline::Spline2DPol(const Float_t *par, int n) const {
@@ -60,6 +60,10 @@ public:
   float DoEval(const Float_t* x, const Float_t* par) const;
   float DoEval(const Float_t* par, bool checkresponse = true) const;
 
+  /// Derivative of DoEval(par) with respect to the value of dimension dim.
+  /// Zero if the dial was clamped to the spline's limits.
+  float DoEvalDerivative(const Float_t* par, int dim) const;
+
   //  void FitCoeff(int n, double* x, double* y, double* par, bool draw);
   void FitCoeff(std::vector< std::vector<double> > v, std::vector<double> w, float* coeff, bool draw);
 
@@ -69,6 +73,9 @@ public:
   inline int GetNPar(void) { return fNPar;  };
   inline std::string GetForm() {return fForm;};
 
+  /// Whether the coefficients are grid knot weights rather than a fit.
+  bool IsGridType() const;
+
   //void Reconfigure(double x);
   void Reconfigure(float x, int index = 0);
   void Reconfigure(std::string name, float x);
@@ -86,6 +93,20 @@ public:
   float Spline1DTSpline3(const Float_t* par) const;
   float Spline2DTSpline3(const Float_t* par) const;
 
+  /// Grid splines store each knot's weight minus one, so no response is
+  /// still all zero coefficients, and interpolate between them directly.
+  /// Knots are ordered row-major, the last dial varying fastest.
+  float SplineNDLinearGrid(const Float_t* par) const;
+  float Spline1DMonoGrid(const Float_t* par) const;
+
+  /// Coefficient index of the grid knot at x, -1 if x is not a knot.
+  int GetGridIndex(std::vector<double> const& x) const;
+
+  // Analytic derivatives where available
+  float Spline1DPolDerivative(const Float_t* par) const;
+  float Spline1DTSpline3Derivative(const Float_t* par) const;
+  float NumericDerivative(const Float_t* par, int dim) const;
+
 
   std::string fName;
   int fType;
@@ -101,6 +122,7 @@ public:
   mutable std::vector<float> fVal;
   mutable std::vector<float> fValMin;
   mutable std::vector<float> fValMax;
+  std::vector<bool> fValClamped;
 
   mutable std::vector< std::vector<float> > fSplitScan;
 
@@ -116,6 +138,10 @@ public:
 
   int  fSplineOffset;
 
+  // Grid spline knots of each dial, sorted, and their coefficient strides.
+  std::vector< std::vector<float> > fGridKnots;
+  std::vector<int> fGridStride;
+
   // TSpline3 Objects.
   mutable std::vector<float>::iterator iter_low;
   mutable std::vector<float>::iterator iter_high;
@@ -160,7 +186,10 @@ enum spline_types {
   k1DPol25,
   k2DPol6,
   k2DGaus,
-  k2DTSpline3
+  k2DTSpline3,
+  k1DLinearGrid,
+  k1DMonoGrid,
+  kNDLinearGrid
 };
 
 }
@@ -0,0 +1,181 @@
+#include "SplineCoeffs.h"
+
+#include <algorithm>
+#include <cmath>
+
+SplineCoeffTree::SplineCoeffTree(SplineReader *reader)
+    : fReader(reader), fSparse(false), fHalfTolerance(0.0), fNPacked(0),
+      fNHalf(0) {
+  int npar = fReader->GetNPar();
+  int nmask = fReader->GetNMaskWords();
+
+  // Branch addresses point into these, so they are never resized
+  fDense.resize(npar, 0.0);
+  fPacked.resize(npar, 0.0);
+  fHalf.resize(npar, 0);
+  fMask.resize(nmask, 0);
+  fHalfMask.resize(nmask, 0);
+}
+
+void SplineCoeffTree::Branch(TTree *tr) {
+  fSparse = FitPar::Config().GetParB("SplineSparseStorage");
+  fHalfTolerance =
+      fSparse ? FitPar::Config().GetParD("SplineHalfTolerance") : 0.0;
+
+  int npar = fDense.size();
+  int nmask = fMask.size();
+  NUIS_LOG(FIT, "Saving " << (fSparse ? "sparse" : "dense") << " coefficients"
+                          << " for " << npar << " spline parameters"
+                          << (fHalfTolerance > 0 ? ", half precision" : ""));
+
+  if (!fSparse) {
+    tr->Branch("SplineCoeff", &fDense[0], Form("SplineCoeff[%d]/F", npar));
+    return;
+  }
+
+  if (fHalfTolerance > 0) {
+    fKnots.clear();
+    for (size_t i = 0; i < fReader->fPoints.size(); i++) {
+      fKnots.push_back(SplineUtils::GetSplitDialPoints(fReader->fPoints[i]));
+    }
+  }
+
+  tr->Branch("SplineMask", &fMask[0], Form("SplineMask[%d]/i", nmask));
+  tr->Branch("SplineHalfMask", &fHalfMask[0],
+             Form("SplineHalfMask[%d]/i", nmask));
+  tr->Branch("NSplineCoeff", &fNPacked, "NSplineCoeff/I");
+  tr->Branch("SplineCoeffPacked", &fPacked[0],
+             "SplineCoeffPacked[NSplineCoeff]/F");
+  tr->Branch("NSplineHalf", &fNHalf, "NSplineHalf/I");
+  tr->Branch("SplineCoeffHalf", &fHalf[0], "SplineCoeffHalf[NSplineHalf]/s");
+}
+
+bool SplineCoeffTree::HalfIsAccurate(int i, float const *par) {
+  Spline &spl = fReader->fAllSplines[i];
+  int npar = spl.GetNPar();
+  int ndim = spl.GetNDim();
+
+  std::vector<float> halfpar(npar);
+  bool halfresponse = false;
+  for (int j = 0; j < npar; j++) {
+    halfpar[j] = SplineUtils::HalfToFloat(SplineUtils::FloatToHalf(par[j]));
+    halfresponse = halfresponse || (halfpar[j] != 0.0);
+  }
+
+  // Evaluating at a knot moves the spline's dial values, put them back after.
+  std::vector<float> saved = spl.fVal;
+  std::vector<float> x(ndim);
+  bool accurate = true;
+  for (size_t k = 0; accurate && k < fKnots[i].size(); k++) {
+    for (int d = 0; d < ndim; d++) {
+      x[d] = fKnots[i][k][d];
+    }
+    double w = spl(&x[0], par);
+    // Splines with no coefficients left are skipped as having no response
+    double whalf = halfresponse ? spl(&x[0], &halfpar[0]) : 1.0;
+    accurate = (std::fabs(whalf - w) < fHalfTolerance);
+  }
+  spl.fVal = saved;
+
+  return accurate;
+}
+
+void SplineCoeffTree::SetCoefficients(float const *coeffs) {
+  if (!fSparse) {
+    std::copy(coeffs, coeffs + fDense.size(), fDense.begin());
+    return;
+  }
+
+  std::fill(fMask.begin(), fMask.end(), 0);
+  std::fill(fHalfMask.begin(), fHalfMask.end(), 0);
+  fNPacked = 0;
+  fNHalf = 0;
+
+  for (size_t i = 0; i < fReader->fAllSplines.size(); i++) {
+    if (!fReader->HasResponse(i, coeffs)) {
+      continue;
+    }
+    UInt_t bit = (UInt_t(1) << (i % 32));
+    fMask[i / 32] |= bit;
+
+    int npar = fReader->fAllSplines[i].GetNPar();
+    float const *par = &coeffs[fReader->fCoeffOffsets[i]];
+    if (fHalfTolerance > 0 && HalfIsAccurate(i, par)) {
+      fHalfMask[i / 32] |= bit;
+      for (int j = 0; j < npar; j++) {
+        fHalf[fNHalf++] = SplineUtils::FloatToHalf(par[j]);
+      }
+    } else {
+      std::copy(par, par + npar, &fPacked[fNPacked]);
+      fNPacked += npar;
+    }
+  }
+}
+
+void SplineCoeffTree::SetBranchAddress(TTree *tr) {
+  fSparse = (tr->GetBranch("SplineMask") != NULL);
+  if (!fSparse) {
+    tr->SetBranchAddress("SplineCoeff", &fDense[0]);
+    return;
+  }
+
+  tr->SetBranchAddress("SplineMask", &fMask[0]);
+  tr->SetBranchAddress("SplineHalfMask", &fHalfMask[0]);
+  tr->SetBranchAddress("NSplineCoeff", &fNPacked);
+  tr->SetBranchAddress("SplineCoeffPacked", &fPacked[0]);
+  tr->SetBranchAddress("NSplineHalf", &fNHalf);
+  tr->SetBranchAddress("SplineCoeffHalf", &fHalf[0]);
+}
+
+void SplineCoeffTree::GetCoefficients(float *coeffs) {
+  if (!fSparse) {
+    std::copy(fDense.begin(), fDense.end(), coeffs);
+    return;
+  }
+
+  float const *packed = fPacked.data();
+  UShort_t const *half = fHalf.data();
+  for (size_t i = 0; i < fReader->fAllSplines.size(); i++) {
+    int npar = fReader->fAllSplines[i].GetNPar();
+    float *par = &coeffs[fReader->fCoeffOffsets[i]];
+    UInt_t bit = (UInt_t(1) << (i % 32));
+
+    if (!(fMask[i / 32] & bit)) {
+      std::fill(par, par + npar, 0.0);
+    } else if (fHalfMask[i / 32] & bit) {
+      for (int j = 0; j < npar; j++) {
+        par[j] = SplineUtils::HalfToFloat(*half++);
+      }
+    } else {
+      std::copy(packed, packed + npar, par);
+      packed += npar;
+    }
+  }
+}
+
+void SparseSplineCoeffs::Clear() {
+  fMasks.clear();
+  fMaskStart.clear();
+  fCoeffs.clear();
+  fCoeffStart.clear();
+}
+
+void SparseSplineCoeffs::Release() {
+  std::vector<UInt_t>().swap(fMasks);
+  std::vector<size_t>().swap(fMaskStart);
+  std::vector<float>().swap(fCoeffs);
+  std::vector<size_t>().swap(fCoeffStart);
+}
+
+size_t SparseSplineCoeffs::Add(SplineReader *reader, float const *coeffs) {
+  fMaskStart.push_back(fMasks.size());
+  fCoeffStart.push_back(fCoeffs.size());
+  reader->PackCoefficients(coeffs, fMasks, fCoeffs);
+  return fMaskStart.size() - 1;
+}
+
+size_t SparseSplineCoeffs::GetMemoryBytes() const {
+  return fMasks.capacity() * sizeof(UInt_t) +
+         (fMaskStart.capacity() + fCoeffStart.capacity()) * sizeof(size_t) +
+         fCoeffs.capacity() * sizeof(float);
+}
@@ -0,0 +1,94 @@
+#ifndef SPLINECOEFFS_H
+#define SPLINECOEFFS_H
+
+#include "SplineReader.h"
+#include "TTree.h"
+
+#include <vector>
+
+/// Reads or writes the per-event coefficients of a spline_tree for the
+/// splines of a SplineReader.
+///
+/// Dense trees have a single SplineCoeff[NPar]/F branch. Sparse trees only
+/// keep the coefficients of splines that respond:
+///  - SplineMask[NMask]/i : bit i%32 of word i/32 set if spline i responds
+///  - SplineHalfMask[NMask]/i : set if spline i is stored in half precision
+///  - NSplineCoeff/I and SplineCoeffPacked[NSplineCoeff]/F
+///  - NSplineHalf/I and SplineCoeffHalf[NSplineHalf]/s
+/// with each responding spline's block in spline order in one of the two.
+class SplineCoeffTree {
+public:
+  SplineCoeffTree(SplineReader* reader);
+  ~SplineCoeffTree() {};
+
+  /// Add coefficient branches to tr for writing. Sparse unless
+  /// SplineSparseStorage is off. With SplineHalfTolerance > 0 a spline is
+  /// stored in half precision if that changes its weight at every knot by
+  /// less than the tolerance.
+  void Branch(TTree* tr);
+
+  /// Set the branches from GetNPar dense coefficients before TTree::Fill.
+  void SetCoefficients(float const* coeffs);
+
+  /// Point tr's coefficient branches, dense or sparse, at this object.
+  void SetBranchAddress(TTree* tr);
+
+  /// Dense coefficients of the entry last read from the tree.
+  void GetCoefficients(float* coeffs);
+
+private:
+  /// Whether spline i's coefficients survive half precision.
+  bool HalfIsAccurate(int i, float const* par);
+
+  SplineReader* fReader;
+  bool fSparse;
+  double fHalfTolerance;
+
+  /// Knot points of each spline, where half precision is checked
+  std::vector<std::vector<std::vector<double> > > fKnots;
+
+  std::vector<float> fDense;
+  std::vector<UInt_t> fMask;
+  std::vector<UInt_t> fHalfMask;
+  Int_t fNPacked;
+  std::vector<float> fPacked;
+  Int_t fNHalf;
+  std::vector<UShort_t> fHalf;
+};
+
+/// Spline coefficients of many events in memory, keeping only the blocks of
+/// splines that respond, as SplineReader::PackCoefficients. Events are
+/// numbered in the order they are added.
+class SparseSplineCoeffs {
+public:
+  SparseSplineCoeffs() {};
+  ~SparseSplineCoeffs() {};
+
+  /// Drop all events, keeping the memory for refilling.
+  void Clear();
+
+  /// Drop all events and free their memory.
+  void Release();
+
+  /// Pack the dense coefficients of reader's splines, returns the event number.
+  size_t Add(SplineReader* reader, float const* coeffs);
+
+  inline size_t size() const { return fMaskStart.size(); };
+  inline bool empty() const { return fMaskStart.empty(); };
+
+  /// Response mask of event i, for SplineReader::CalcWeightPacked
+  inline UInt_t* GetMask(size_t i) { return fMasks.data() + fMaskStart[i]; };
+
+  /// Packed coefficients of event i, for SplineReader::CalcWeightPacked
+  inline float* GetCoeffs(size_t i) { return fCoeffs.data() + fCoeffStart[i]; };
+
+  /// Approximate heap usage in bytes.
+  size_t GetMemoryBytes() const;
+
+  std::vector<UInt_t> fMasks;
+  std::vector<size_t> fMaskStart;
+  std::vector<float> fCoeffs;
+  std::vector<size_t> fCoeffStart;
+};
+
+#endif
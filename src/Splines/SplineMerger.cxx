@@ -1,56 +1,47 @@
 #include "SplineMerger.h"
 
+SplineMerger::~SplineMerger() {
+  for (size_t i = 0; i < fInputCoeffTrees.size(); i++) {
+    delete fInputCoeffTrees[i];
+    delete fInputReaders[i];
+  }
+  delete fOutCoeffTree;
+  delete[] fCoEffStorer;
+}
+
 void SplineMerger::AddSplineSetFromFile(TFile* file){
 
   TTree* tr = (TTree*) file->Get("spline_reader");
-  std::vector<std::string>* tempspline = 0;
-  std::vector<std::string>* temptype = 0;
-  std::vector<std::string>* tempform = 0;
-  std::vector<std::string>* temppoints = 0;
-
-
-  // Loop over all splines and add a TString in the TTree for its inputs                                                                                            
-  tr->SetBranchAddress("Spline", &tempspline);
-  tr->SetBranchAddress("Type",   &temptype);
-  tr->SetBranchAddress("Form",   &tempform);
-  tr->SetBranchAddress("Points", &temppoints);
-  tr->GetEntry(0);
-
-  // Copy over                                                                                                                                                                                                                             
-  for (size_t i = 0; i < tempspline->size(); i++){
-    fSpline.push_back(tempspline->at(i));
-    fType.push_back(temptype->at(i));
-    fForm.push_back(tempform->at(i));
-    fPoints.push_back(temppoints->at(i));
-  }
-
+  SplineReader* reader = new SplineReader();
+  reader->Read(tr);
   delete tr;
 
+  // Copy over, the merged coefficients are each file's in turn
+  fInputOffsets.push_back(GetNPar());
+  for (size_t i = 0; i < reader->fSpline.size(); i++){
+    fCoeffOffsets.push_back(GetNPar());
+    fAllSplines.push_back(reader->fAllSplines[i]);
+    fSpline.push_back(reader->fSpline[i]);
+    fType.push_back(reader->fType[i]);
+    fForm.push_back(reader->fForm[i]);
+    fPoints.push_back(reader->fPoints[i]);
+  }
+  fInputReaders.push_back(reader);
 
   // Now Get the coefficients setup.
-  //size_t index = fSplineTreeList.size();
   fSplineTreeList.push_back( (TTree*) file->Get("spline_tree") );
-
+  fInputCoeffTrees.push_back(new SplineCoeffTree(reader));
 }
 
 void SplineMerger::SetupSplineSet(){
 
-  // Define NCoEff
-  fNCoEff = 0;
-  for (size_t i = 0; i < fSplineSizeList.size(); i++){
-    fNCoEff += fSplineSizeList[i];
-  }
-
   // Define Storer
+  fNCoEff = GetNPar();
   fCoEffStorer = new float[fNCoEff];
 
-  // Loop over each TTree and set spline address
-  int off = 0;
-  for (size_t i = 0; i < fSplineSizeList.size(); i++){
-    float* add = &(fCoEffStorer[off]);
-    TTree* tree = (fSplineTreeList[i]);
-    tree->SetBranchAddress("SplineCoeff", add);
-    off += fSplineSizeList[i];
+  // Loop over each TTree and set its coefficient addresses
+  for (size_t i = 0; i < fSplineTreeList.size(); i++){
+    fInputCoeffTrees[i]->SetBranchAddress(fSplineTreeList[i]);
   }
 
 }
@@ -59,6 +50,7 @@ void SplineMerger::SetupSplineSet(){
 void SplineMerger::GetEntry(int entry){
   for (size_t i = 0; i < fSplineTreeList.size(); i++){
     fSplineTreeList[i]->GetEntry(entry);
+    fInputCoeffTrees[i]->GetCoefficients(&fCoEffStorer[fInputOffsets[i]]);
   }
 }
 
@@ -79,18 +71,13 @@ void SplineMerger::Write(std::string name){
 }
 
 void SplineMerger::AddCoefficientsToTree(TTree* tree){
-  tree->Branch("SplineCoeff", fCoEffStorer, Form("SplineCoeff[%d]/F", fNCoEff));
+  delete fOutCoeffTree;
+  fOutCoeffTree = new SplineCoeffTree(this);
+  fOutCoeffTree->Branch(tree);
 }
 
 void SplineMerger::FillMergedSplines(int entry){
   GetEntry(entry);
-
-  size_t count = 0;
-  for (size_t i = 0; i < fSplineSizeList.size(); i++){
-    for (size_t j = 0; j < (UInt_t)fSplineSizeList[i]; j++){
-      fCoEffStorer[count] = fSplineAddressList[i][j];
-      count++;
-    }
-  }
+  fOutCoeffTree->SetCoefficients(fCoEffStorer);
 }
 
@@ -5,11 +5,12 @@
 #include "Spline.h"
 
 #include "SplineReader.h"
+#include "SplineCoeffs.h"
 
 class SplineMerger : public SplineReader {
  public:
-  SplineMerger(){};
-  ~SplineMerger(){};
+  SplineMerger() : fCoEffStorer(NULL), fNCoEff(0), fOutCoeffTree(NULL){};
+  ~SplineMerger();
 
   void AddSplineSetFromFile(TFile* file); 
   void SetupSplineSet();
@@ -23,10 +24,17 @@ class SplineMerger : public SplineReader {
   float* fCoEffStorer;
   int fNCoEff;
 
-  std::vector< float[1000] > fSplineAddressList;
-  std::vector< int > fSplineSizeList;
   std::vector< TTree* > fSplineTreeList;
 
+  /// Splines of each input file, the coefficient branches of its
+  /// spline_tree, dense or sparse, and where its block starts in fCoEffStorer
+  std::vector< SplineReader* > fInputReaders;
+  std::vector< SplineCoeffTree* > fInputCoeffTrees;
+  std::vector< int > fInputOffsets;
+
+  /// Coefficient branches of the merged tree
+  SplineCoeffTree* fOutCoeffTree;
+
   std::vector< std::vector<double> > fParVect;
   std::vector< int > fSetIndex;
   std::vector< double > fWeightList;
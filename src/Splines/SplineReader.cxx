@@ -1,5 +1,7 @@
 #include "SplineReader.h"
 
+#include <algorithm>
+
 // Spline reader should have access to every spline.
 // Should know when reconfigure is called what its limits are and adjust
 // accordingly. Then should pass it the index required in the stack as
@@ -18,6 +20,10 @@ void SplineReader::AddSpline(nuiskey splinekey) {
   //  << points << std::endl;
 
   // Add the spline to the list of all forms
+  int off = fCoeffOffsets.empty()
+                ? 0
+                : fCoeffOffsets.back() + fAllSplines.back().GetNPar();
+  fCoeffOffsets.push_back(off);
   fAllSplines.push_back(Spline(splname, form, points));
   fSpline.push_back(splname);
   fType.push_back(type);
@@ -53,6 +59,13 @@ void SplineReader::Read(TTree *tr) {
                                           << " " << fPoints[i]);
     fAllSplines.push_back(Spline(fSpline[i], fForm[i], fPoints[i]));
   }
+
+  int off = 0;
+  fCoeffOffsets.clear();
+  for (size_t i = 0; i < fAllSplines.size(); i++) {
+    fCoeffOffsets.push_back(off);
+    off += fAllSplines[i].GetNPar();
+  }
 }
 
 void SplineReader::Reconfigure(std::map<std::string, double> &vals) {
@@ -82,15 +95,8 @@ void SplineReader::SetNeedsReconfigure(bool val) { fNeedsReconfigure = val; }
 
 double SplineReader::CalcWeight(float *coeffs) {
 
-  int off = 0;
   double rw_weight = 1.0;
-
-  // Form Offset list
-  std::vector<int> offsets;
-  for (size_t i = 0; i < fAllSplines.size(); i++) {
-    offsets.push_back(off);
-    off += fAllSplines[i].GetNPar();
-  }
+  std::vector<int> const &offsets = fCoeffOffsets;
 
   // #pragma omp parrallel for
   for (size_t i = 0; i < fAllSplines.size(); i++) {
@@ -121,3 +127,122 @@ int SplineReader::GetNPar() {
   }
   return n;
 }
+
+int SplineReader::GetNDim() {
+  int n = 0;
+  for (size_t i = 0; i < fAllSplines.size(); i++) {
+    n += fAllSplines[i].GetNDim();
+  }
+  return n;
+}
+
+std::vector<std::string> SplineReader::GetDimNames() {
+  std::vector<std::string> names;
+  for (size_t i = 0; i < fAllSplines.size(); i++) {
+    for (int j = 0; j < fAllSplines[i].GetNDim(); j++) {
+      names.push_back(fAllSplines[i].fSplitNames[j]);
+    }
+  }
+  return names;
+}
+
+double SplineReader::CalcWeightGradient(float *coeffs, double *dwdx) {
+
+  size_t nspl = fAllSplines.size();
+
+  // Per spline weights, then products of every spline before and after each
+  // one so the product rule never divides by a spline weight.
+  std::vector<double> w(nspl);
+  int off = 0;
+  for (size_t i = 0; i < nspl; i++) {
+    w[i] = fAllSplines[i].DoEval(&coeffs[off]);
+    off += fAllSplines[i].GetNPar();
+  }
+
+  std::vector<double> after(nspl + 1, 1.0);
+  for (size_t i = nspl; i > 0; i--) {
+    after[i - 1] = after[i] * w[i - 1];
+  }
+
+  double rw_weight = after[0];
+  bool flat = (rw_weight <= 0.0);
+  if (flat)
+    rw_weight = 1.0;
+
+  double before = 1.0;
+  int dim = 0;
+  off = 0;
+  for (size_t i = 0; i < nspl; i++) {
+    Spline &spl = fAllSplines[i];
+    for (int j = 0; j < spl.GetNDim(); j++) {
+      dwdx[dim++] = flat ? 0.0
+                         : before * after[i + 1] *
+                               spl.DoEvalDerivative(&coeffs[off], j);
+    }
+    before *= w[i];
+    off += spl.GetNPar();
+  }
+
+  return rw_weight;
+}
+
+int SplineReader::GetNMaskWords() { return (fAllSplines.size() + 31) / 32; }
+
+bool SplineReader::HasResponse(int i, float const *coeffs) {
+  float const *par = &coeffs[fCoeffOffsets[i]];
+  for (int j = 0; j < fAllSplines[i].GetNPar(); j++) {
+    if (par[j] != 0.0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SplineReader::PackCoefficients(float const *coeffs,
+                                    std::vector<UInt_t> &mask,
+                                    std::vector<float> &packed) {
+  size_t first = mask.size();
+  mask.resize(first + GetNMaskWords(), 0);
+
+  for (size_t i = 0; i < fAllSplines.size(); i++) {
+    if (!HasResponse(i, coeffs)) {
+      continue;
+    }
+    mask[first + i / 32] |= (UInt_t(1) << (i % 32));
+    float const *par = &coeffs[fCoeffOffsets[i]];
+    packed.insert(packed.end(), par, par + fAllSplines[i].GetNPar());
+  }
+}
+
+void SplineReader::UnpackCoefficients(UInt_t const *mask, float const *packed,
+                                      float *coeffs) {
+  for (size_t i = 0; i < fAllSplines.size(); i++) {
+    int npar = fAllSplines[i].GetNPar();
+    float *par = &coeffs[fCoeffOffsets[i]];
+    if ((mask[i / 32] >> (i % 32)) & 1) {
+      std::copy(packed, packed + npar, par);
+      packed += npar;
+    } else {
+      std::fill(par, par + npar, 0.0);
+    }
+  }
+}
+
+double SplineReader::CalcWeightPacked(UInt_t const *mask,
+                                      float const *packed) {
+  double rw_weight = 1.0;
+
+  // Splines without a response have a weight of 1.0 and nothing packed
+  for (size_t i = 0; i < fAllSplines.size(); i++) {
+    if (!((mask[i / 32] >> (i % 32)) & 1)) {
+      continue;
+    }
+    rw_weight *= fAllSplines[i].DoEval(packed, false);
+    packed += fAllSplines[i].GetNPar();
+  }
+
+  if (rw_weight <= 0.0)
+    rw_weight = 1.0;
+
+  return rw_weight;
+}
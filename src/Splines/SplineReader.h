@@ -24,6 +24,39 @@ public:
   int GetNPar();
   double CalcWeight(float* coeffs);
 
+  /// Total number of spline dimensions, the length of CalcWeightGradient's
+  /// dwdx array.
+  int GetNDim();
+
+  /// Single dial name of each spline dimension, in dwdx order.
+  std::vector<std::string> GetDimNames();
+
+  /// Same weight as CalcWeight, also filling dwdx with the weight's derivative
+  /// with respect to each spline dimension's dial value.
+  double CalcWeightGradient(float* coeffs, double* dwdx);
+
+  /// Number of 32 bit words in a response mask, one bit per spline.
+  int GetNMaskWords();
+
+  /// Whether spline i has any non-zero coefficient in the dense coeffs.
+  bool HasResponse(int i, float const* coeffs);
+
+  /// Append the response mask of the dense coeffs to mask, and the
+  /// coefficients of every spline with a response to packed.
+  void PackCoefficients(float const* coeffs, std::vector<UInt_t>& mask,
+                        std::vector<float>& packed);
+
+  /// Expand a response mask and packed coefficients into GetNPar dense ones.
+  void UnpackCoefficients(UInt_t const* mask, float const* packed,
+                          float* coeffs);
+
+  /// Same weight as CalcWeight of the unpacked coefficients. Splines without
+  /// a response are skipped rather than evaluated.
+  double CalcWeightPacked(UInt_t const* mask, float const* packed);
+
+  /// Offset of each spline's coefficients in the dense array
+  std::vector<int> fCoeffOffsets;
+
   std::vector<Spline> fAllSplines;
   std::vector<std::string> fSpline;
   std::vector<std::string> fType;
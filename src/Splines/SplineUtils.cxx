@@ -1,5 +1,8 @@
 #include "SplineUtils.h"
 
+#include <stdint.h>
+#include <cstring>
+
 
 // std::vector<int> SplineUtils::GetSplitDialPositions(FitWeight* rw, std::string names) {
 // 	std::vector<std::string> splitnames = GeneralUtils::ParseToStr(names, ";");
@@ -109,3 +112,72 @@ std::vector< std::vector<double> > SplineUtils::GetSplitDialPoints(std::string p
 	}
 	return gridpoints;
 }
+
+UShort_t SplineUtils::FloatToHalf(float f) {
+	uint32_t x;
+	memcpy(&x, &f, sizeof(x));
+
+	uint32_t sign = (x >> 16) & 0x8000;
+	uint32_t fexp = (x >> 23) & 0xff;
+	uint32_t mant = x & 0x7fffff;
+	int exp = int(fexp) - 127 + 15;
+
+	// Inf and NaN, and anything too big for a half
+	if (fexp == 0xff) {
+		return sign | 0x7c00 | (mant ? 0x200 : 0);
+	}
+	if (exp >= 0x1f) {
+		return sign | 0x7c00;
+	}
+
+	// Subnormal halves, or zero if even those are too big
+	if (exp <= 0) {
+		if (exp < -10) {
+			return sign;
+		}
+		mant |= 0x800000;
+		int shift = 14 - exp;
+		uint32_t half = mant >> shift;
+		uint32_t rem = mant & ((1u << shift) - 1);
+		uint32_t mid = 1u << (shift - 1);
+		if (rem > mid || (rem == mid && (half & 1))) {
+			half++;
+		}
+		return sign | half;
+	}
+
+	// A carry out of the mantissa correctly bumps the exponent
+	uint32_t half = sign | (exp << 10) | (mant >> 13);
+	uint32_t rem = mant & 0x1fff;
+	if (rem > 0x1000 || (rem == 0x1000 && (half & 1))) {
+		half++;
+	}
+	return half;
+}
+
+float SplineUtils::HalfToFloat(UShort_t h) {
+	uint32_t sign = uint32_t(h & 0x8000) << 16;
+	uint32_t exp = (h >> 10) & 0x1f;
+	uint32_t mant = h & 0x3ff;
+	uint32_t x;
+
+	if (exp == 0x1f) {
+		x = sign | 0x7f800000 | (mant << 13);
+	} else if (exp) {
+		x = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+	} else if (mant) {
+		// Normalise the subnormal
+		exp = 127 - 15 + 1;
+		while (!(mant & 0x400)) {
+			mant <<= 1;
+			exp--;
+		}
+		x = sign | (exp << 23) | ((mant & 0x3ff) << 13);
+	} else {
+		x = sign;
+	}
+
+	float f;
+	memcpy(&f, &x, sizeof(f));
+	return f;
+}
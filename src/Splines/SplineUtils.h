@@ -3,10 +3,17 @@
 
 //#include "FitWeight.h"
 #include "GeneralUtils.h"
+#include "Rtypes.h"
 
 namespace SplineUtils {
 	//std::vector<int> GetSplitDialPositions(FitWeight* rw, std::string names);
 	std::vector< std::vector<double> > GetSplitDialPoints(std::string points);
+
+	/// IEEE 754 half precision bits of f, rounded to nearest even.
+	UShort_t FloatToHalf(float f);
+
+	/// Float value of IEEE 754 half precision bits.
+	float HalfToFloat(UShort_t h);
 };
 
 #endif
@@ -413,6 +413,12 @@ void SplineWriter::FitCoeff(Spline *spl, std::vector<std::vector<double> > &v,
     FitCoeff2DGraph(spl, v.size(), &x[0], &y[0], &w[0], coeff, draw);
     break;
 
+  case k1DLinearGrid:
+  case k1DMonoGrid:
+  case kNDLinearGrid:
+    GetCoeffGrid(spl, v, w, coeff);
+    break;
+
   default:
     break;
   }
@@ -760,6 +766,25 @@ void SplineWriter::FitCoeffNDGraph(Spline *spl,
 }
 
 // Spline extraction Functions
+void SplineWriter::GetCoeffGrid(Spline *spl,
+                                std::vector<std::vector<double> > &v,
+                                std::vector<double> &w, float *coeff) {
+
+  // Nothing to fit, the knot weights are the coefficients
+  for (int i = 0; i < spl->GetNPar(); i++) {
+    coeff[i] = 0.0;
+  }
+
+  for (size_t i = 0; i < v.size(); i++) {
+    int index = spl->GetGridIndex(v[i]);
+    if (index < 0) {
+      NUIS_ABORT("Grid spline " << spl->GetName() << " has no knot for point "
+                                << i);
+    }
+    coeff[index] = w[i] - 1.0;
+  }
+}
+
 void SplineWriter::GetCoeff1DTSpline3(Spline *spl, int n, double *x, double *y,
                                       float *coeff, bool draw) {
 
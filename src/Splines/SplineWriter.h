@@ -86,6 +86,7 @@ public:
   void FitCoeff(Spline* spl, std::vector< std::vector<double> >& v, std::vector<double>& w, float* coeff, bool draw);
   void FitCoeff1DGraph(Spline* spl, int n, double* x, double* y, float* coeff, bool draw);
   void GetCoeff1DTSpline3(Spline* spl, int n, double* x, double* y, float* coeff, bool draw);
+  void GetCoeffGrid(Spline* spl, std::vector< std::vector<double> >& v, std::vector<double>& w, float* coeff);
   // void FitCoeff2DGraph(Spline* spl, std::vector< std::vector<double> >& v, std::vector<double>& w, float* coeff, bool draw);
   void FitCoeffNDGraph(Spline* spl, std::vector< std::vector<double> >& v, std::vector<double>& w, float* coeff, bool draw);
   void FitCoeff2DGraph(Spline* spl,  int n,  double* x,  double* y,  double* w, float* coeff, bool draw);
@@ -0,0 +1,139 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+
+#include "MatrixCache.h"
+
+#include "FitLogger.h"
+#include "NuisConfig.h"
+
+#include "TSystem.h"
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <unistd.h>
+
+namespace {
+const char kMagic[8] = {'N', 'U', 'I', 'S', 'M', 'A', 'T', 'C'};
+const uint32_t kVersion = 1;
+
+std::string GetCachePath(uint64_t key) {
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.nuismat", (unsigned long long)key);
+  return MatrixCache::GetCacheDir() + "/" + name;
+}
+} // namespace
+
+std::string MatrixCache::GetCacheDir() {
+  return FitPar::Config().GetParS("MatrixCacheDir");
+}
+
+uint64_t MatrixCache::Hash(void const *data, size_t nbytes, uint64_t seed) {
+  unsigned char const *bytes = static_cast<unsigned char const *>(data);
+  uint64_t hash = seed;
+  for (size_t i = 0; i < nbytes; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+TMatrixD *MatrixCache::Read(uint64_t key) {
+  if (GetCacheDir().empty()) {
+    return NULL;
+  }
+
+  std::string path = GetCachePath(key);
+  FILE *f = fopen(path.c_str(), "rb");
+  if (!f) {
+    return NULL;
+  }
+
+  char magic[8];
+  uint32_t version = 0;
+  int32_t dims[2] = {0, 0};
+  bool ok = (fread(magic, 1, 8, f) == 8) && !memcmp(magic, kMagic, 8) &&
+            (fread(&version, sizeof(version), 1, f) == 1) &&
+            (version == kVersion) && (fread(dims, sizeof(int32_t), 2, f) == 2) &&
+            (dims[0] > 0) && (dims[1] > 0);
+
+  // The dimensions must account for exactly the rest of the file before
+  // anything is allocated for them
+  size_t n = ok ? size_t(dims[0]) * size_t(dims[1]) : 0;
+  if (ok) {
+    long start = ftell(f);
+    ok = (start >= 0) && !fseek(f, 0, SEEK_END);
+    long end = ok ? ftell(f) : -1;
+    ok = ok && (end >= start) && !fseek(f, start, SEEK_SET) &&
+         (size_t(end - start) / sizeof(double) == n) &&
+         (size_t(end - start) % sizeof(double) == 0);
+  }
+
+  TMatrixD *mat = NULL;
+  if (ok) {
+    mat = new TMatrixD(dims[0], dims[1]);
+    if (fread(mat->GetMatrixArray(), sizeof(double), n, f) != n) {
+      delete mat;
+      mat = NULL;
+    }
+  }
+  fclose(f);
+
+  if (!mat) {
+    NUIS_ERR(WRN, "Ignoring unreadable matrix cache file: " << path);
+    return NULL;
+  }
+
+  NUIS_LOG(DEB, "Read cached " << dims[0] << "x" << dims[1] << " matrix from "
+                               << path);
+  return mat;
+}
+
+void MatrixCache::Write(uint64_t key, TMatrixD const &mat) {
+  std::string dir = GetCacheDir();
+  if (dir.empty()) {
+    return;
+  }
+  gSystem->mkdir(dir.c_str(), true);
+
+  // Write under a temporary name, so that concurrent jobs never read a
+  // partial file
+  std::string path = GetCachePath(key);
+  std::stringstream tmppath;
+  tmppath << path << "." << getpid();
+
+  FILE *f = fopen(tmppath.str().c_str(), "wb");
+  if (!f) {
+    NUIS_ERR(WRN, "Cannot write matrix cache file: " << tmppath.str());
+    return;
+  }
+
+  int32_t dims[2] = {mat.GetNrows(), mat.GetNcols()};
+  size_t n = size_t(dims[0]) * size_t(dims[1]);
+  bool ok = (fwrite(kMagic, 1, 8, f) == 8) &&
+            (fwrite(&kVersion, sizeof(kVersion), 1, f) == 1) &&
+            (fwrite(dims, sizeof(int32_t), 2, f) == 2) &&
+            (fwrite(mat.GetMatrixArray(), sizeof(double), n, f) == n);
+  ok = (fclose(f) == 0) && ok;
+
+  if (!ok || rename(tmppath.str().c_str(), path.c_str())) {
+    NUIS_ERR(WRN, "Failed to write matrix cache file: " << path);
+    remove(tmppath.str().c_str());
+  }
+}
@@ -0,0 +1,55 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+
+#ifndef MATRIXCACHE_H
+#define MATRIXCACHE_H
+
+#include "TMatrixD.h"
+
+#include <stdint.h>
+#include <string>
+
+/*!
+ *  \addtogroup Statistical
+ *  @{
+ */
+
+//! On-disk cache of parsed and inverted matrices, keyed by a hash of whatever
+//! the matrix was made from. Enabled by setting the MatrixCacheDir config.
+namespace MatrixCache {
+
+static const uint64_t kHashSeed = 14695981039346656037ULL;
+
+//! Cache directory, empty if the cache is disabled.
+std::string GetCacheDir();
+
+//! 64 bit FNV-1a hash of nbytes at data, chain calls by passing the last hash
+//! as the seed.
+uint64_t Hash(void const *data, size_t nbytes, uint64_t seed = kHashSeed);
+
+//! Returns the matrix stored under key, or NULL if there is none.
+TMatrixD *Read(uint64_t key);
+
+//! Stores mat under key. Failures are warned about and otherwise ignored.
+void Write(uint64_t key, TMatrixD const &mat);
+
+} // namespace MatrixCache
+
+/*! @} */
+#endif
@@ -19,9 +19,11 @@
 
 #include "StatUtils.h"
 #include "GeneralUtils.h"
+#include "MatrixCache.h"
 #include "NuisConfig.h"
 #include "TH1D.h"
 #include "TVector.h"
+#include <iterator>
 #include <limits>
 
 //*******************************************************************
@@ -315,6 +317,151 @@ Double_t StatUtils::GetChi2FromCov(TH2D *data, TH2D *mc, TMatrixDSym *invcov,
   return Chi2;
 }
 
+//*******************************************************************
+Double_t StatUtils::GetChi2FromDiag(std::vector<double> const &data,
+                                    std::vector<double> const &mc,
+                                    std::vector<double> const &dataerr,
+                                    std::vector<double> const &mcerr) {
+  //*******************************************************************
+
+  static bool first = true;
+  static bool AddMCError = false;
+  if (first) {
+    AddMCError = FitPar::Config().GetParB("addmcerror");
+    first = false;
+  }
+
+  Double_t Chi2 = 0.0;
+  for (size_t i = 0; i < data.size(); i++) {
+    double err = dataerr[i];
+
+    // Add MC Error to data if required
+    if (AddMCError && err > 0.0) {
+      err = sqrt(err * err + mcerr[i] * mcerr[i]);
+    }
+
+    // Ignore bins with zero data or zero bin error
+    if (err <= 0.0 || data[i] == 0.0)
+      continue;
+
+    double diff = data[i] - mc[i];
+    Chi2 += (diff * diff) / (err * err);
+  }
+
+  return Chi2;
+}
+
+//*******************************************************************
+Double_t StatUtils::GetChi2FromCov(std::vector<double> const &data,
+                                   std::vector<double> const &mc,
+                                   TMatrixDSym *invcov, double covar_scale,
+                                   bool SkipEmptyBin) {
+  //*******************************************************************
+
+  static bool first = true;
+  static bool UseSVDDecomp = false;
+  if (first) {
+    UseSVDDecomp = FitPar::Config().GetParB("UseSVDInverse");
+    first = false;
+  }
+
+  int nbins = data.size();
+  if (nbins != invcov->GetNcols() || mc.size() != data.size()) {
+    NUIS_ERR(WRN, "Inconsistent matrix and data arrays passed to "
+                  "StatUtils::GetChi2FromCov!");
+    NUIS_ABORT("data has " << nbins << " entries, mc has " << mc.size()
+                           << ", matrix has " << invcov->GetNcols()
+                           << " bins");
+  }
+
+  // Row-major element array, read as the matrix was filled so that a
+  // non-symmetric SVD inverse is used as-is.
+  const double *cov = invcov->GetMatrixArray();
+
+  Double_t Chi2 = 0.0;
+  for (int i = 0; i < nbins; i++) {
+    if (SkipEmptyBin && ((data[i] == 0) || (mc[i] == 0)))
+      continue;
+
+    double idiff = data[i] - mc[i];
+    const double *covrow = cov + i * nbins;
+    for (int j = 0; j < nbins; j++) {
+      double covij = covrow[j] * covar_scale;
+      if (covij == 0)
+        continue;
+
+      double bin_cont = (idiff * covij * (data[j] - mc[j]));
+
+      if (!UseSVDDecomp && (i == j) && (covij < 0)) {
+        NUIS_ABORT("Found negative diagonal covariance element: Covar("
+                   << i << ", " << j << ") = " << covij
+                   << ", data = " << data[i] << ", mc = " << mc[i]
+                   << " would contribute: " << bin_cont
+                   << " on top of: " << Chi2);
+      }
+
+      Chi2 += bin_cont;
+    }
+  }
+
+  return Chi2;
+}
+
+//*******************************************************************
+void StatUtils::GetChi2GradientFromDiag(std::vector<double> const &data,
+                                        std::vector<double> const &mc,
+                                        std::vector<double> const &dataerr,
+                                        std::vector<double> &dchi2) {
+  //*******************************************************************
+
+  dchi2.assign(data.size(), 0.0);
+  for (size_t i = 0; i < data.size(); i++) {
+    double err = dataerr[i];
+    if (err <= 0.0 || data[i] == 0.0)
+      continue;
+
+    dchi2[i] = -2.0 * (data[i] - mc[i]) / (err * err);
+  }
+}
+
+//*******************************************************************
+void StatUtils::GetChi2GradientFromCov(std::vector<double> const &data,
+                                       std::vector<double> const &mc,
+                                       TMatrixDSym *invcov,
+                                       std::vector<double> &dchi2,
+                                       double covar_scale, bool SkipEmptyBin) {
+  //*******************************************************************
+
+  int nbins = data.size();
+  if (nbins != invcov->GetNcols() || mc.size() != data.size()) {
+    NUIS_ABORT("data has " << nbins << " entries, mc has " << mc.size()
+                           << ", matrix has " << invcov->GetNcols()
+                           << " bins");
+  }
+
+  // Same element order as GetChi2FromCov, which need not be symmetric
+  const double *cov = invcov->GetMatrixArray();
+
+  // chi2 = sum_i sum_j d_i C_ij d_j over the rows i that are kept, with
+  // d = data - mc, so each mc_k appears in its own row and its column.
+  dchi2.assign(nbins, 0.0);
+  for (int i = 0; i < nbins; i++) {
+    if (SkipEmptyBin && ((data[i] == 0) || (mc[i] == 0)))
+      continue;
+
+    double idiff = data[i] - mc[i];
+    const double *covrow = cov + i * nbins;
+    for (int j = 0; j < nbins; j++) {
+      double covij = covrow[j] * covar_scale;
+      if (covij == 0)
+        continue;
+
+      dchi2[i] -= covij * (data[j] - mc[j]);
+      dchi2[j] -= idiff * covij;
+    }
+  }
+}
+
 //*******************************************************************
 Double_t StatUtils::GetChi2FromSVD(TH1D *data, TH1D *mc, TMatrixDSym *cov,
                                    TH1I *mask) {
@@ -716,17 +863,14 @@ TH1D *StatUtils::ThrowHistogram(TH1D *hist, TMatrixDSym *cov, bool throwdiag,
     calc_hist = ApplyHistogramMasking(calc_hist, mask);
   }
 
-  // If a covariance is provided we need a preset random vector and a decomp
-  std::vector<Double_t> rand_val;
+  // If a covariance is provided we need a decomp and a correlated throw
   TMatrixDSym *decomp_cov = NULL;
+  TMatrixD throws;
 
   if (cov) {
-    for (int i = 0; i < hist->GetNbinsX(); i++) {
-      rand_val.push_back(gRandom->Gaus(0.0, 1.0));
-    }
-
-    // Decomp the matrix
     decomp_cov = StatUtils::GetDecomp(calc_cov);
+    throws.ResizeTo(1, decomp_cov->GetNrows());
+    throws = StatUtils::ThrowCorrelated(decomp_cov, 1, gRandom);
   }
 
   // iterate over bins
@@ -742,11 +886,7 @@ TH1D *StatUtils::ThrowHistogram(TH1D *hist, TMatrixDSym *cov, bool throwdiag,
 
     // If a covariance is provided that is also thrown
     if (cov) {
-      correl_val = 0.0;
-
-      for (int j = 0; j < hist->GetNbinsX(); j++) {
-        correl_val += rand_val[j] * (*decomp_cov)(j, i);
-      }
+      correl_val = throws(0, i);
       calc_hist->SetBinContent(
           i + 1, (calc_hist->GetBinContent(i + 1) + correl_val * 1E-38));
     }
@@ -759,6 +899,23 @@ TH1D *StatUtils::ThrowHistogram(TH1D *hist, TMatrixDSym *cov, bool throwdiag,
   return calc_hist;
 };
 
+//*******************************************************************
+TMatrixD StatUtils::ThrowCorrelated(TMatrixDSym *decomp, int ntoys,
+                                    TRandom *rng) {
+  //*******************************************************************
+
+  int nbins = decomp->GetNrows();
+  TMatrixD rand_val(ntoys, nbins);
+  for (int k = 0; k < ntoys; k++) {
+    for (int i = 0; i < nbins; i++) {
+      rand_val(k, i) = rng->Gaus(0.0, 1.0);
+    }
+  }
+
+  // decomp is U = L^T, so row k is (L z_k)^T for unit Gaussian z_k
+  return TMatrixD(rand_val, TMatrixD::kMult, *decomp);
+}
+
 //*******************************************************************
 TH2D *StatUtils::ThrowHistogram(TH2D *hist, TMatrixDSym *cov, TH2I *map,
                                 bool throwdiag, TH2I *mask) {
@@ -777,7 +934,8 @@ TH2D *StatUtils::ThrowHistogram(TH2D *hist, TMatrixDSym *cov, TH2I *map,
   // Throw the covariance for a 1D plot
   // Unmap back to 2D Histogram
 
-  return hist;
+  // Callers own the returned histogram, so never hand back hist itself
+  return (TH2D *)hist->Clone((std::string(hist->GetName()) + "_THROW").c_str());
 }
 
 //*******************************************************************
@@ -968,7 +1126,8 @@ bool StatUtils::IsMatrixWellBehaved(TMatrixDSym *mat) {
 //*******************************************************************
 // bool rescale rescales the matrix when using Cholesky decomp to ensure good
 // decomposition
-TMatrixDSym *StatUtils::GetInvert(TMatrixDSym *mat, bool rescale) {
+TMatrixDSym *StatUtils::GetInvert(TMatrixDSym *mat, bool rescale,
+                                  bool usecache) {
   //*******************************************************************
 
   TMatrixDSym *new_mat = (TMatrixDSym *)mat->Clone();
@@ -1009,6 +1168,27 @@ TMatrixDSym *StatUtils::GetInvert(TMatrixDSym *mat, bool rescale) {
     }
   }
 
+  // Reuse the inverse of an identical matrix from a previous job
+  int nrows = new_mat->GetNrows();
+  usecache = usecache && !MatrixCache::GetCacheDir().empty();
+  uint64_t cachekey = 0;
+  if (usecache) {
+    char settings[2] = {rescale ? '1' : '0', UseSVDDecomp ? '1' : '0'};
+    cachekey = MatrixCache::Hash(settings, sizeof(settings));
+    cachekey = MatrixCache::Hash(&nrows, sizeof(nrows), cachekey);
+    cachekey = MatrixCache::Hash(new_mat->GetMatrixArray(),
+                                 sizeof(double) * nrows * nrows, cachekey);
+    TMatrixD *cached = MatrixCache::Read(cachekey);
+    if (cached && (cached->GetNrows() == nrows) &&
+        (cached->GetNcols() == nrows)) {
+      delete new_mat;
+      new_mat = new TMatrixDSym(nrows, cached->GetMatrixArray(), "");
+      delete cached;
+      return new_mat;
+    }
+    delete cached;
+  }
+
   // Check if this matrix is singular/positive-definite
   bool isWellBehaved = StatUtils::IsMatrixWellBehaved(new_mat);
 
@@ -1034,7 +1214,6 @@ TMatrixDSym *StatUtils::GetInvert(TMatrixDSym *mat, bool rescale) {
       NUIS_ERR(WRN, "Problem with rescaled matrix");
     }
     TDecompChol mat_decomp(*new_mat);
-    int nrows = new_mat->GetNrows();
     delete new_mat;
     new_mat = new TMatrixDSym(nrows, mat_decomp.Invert().GetMatrixArray(), "");
 
@@ -1058,11 +1237,13 @@ TMatrixDSym *StatUtils::GetInvert(TMatrixDSym *mat, bool rescale) {
       NUIS_ABORT("SVD decomposition failed, something strange has happened");
     }
 
-    int nrows = new_mat->GetNrows();
     delete new_mat;
     new_mat = new TMatrixDSym(nrows, mat_decomp.Invert().GetMatrixArray(), "");
   }
 
+  if (usecache) {
+    MatrixCache::Write(cachekey, *new_mat);
+  }
   return new_mat;
 }
 
@@ -1671,6 +1852,62 @@ TH1I *StatUtils::MapToMask(TH2I *hist, TH2I *map) {
   return newhist;
 }
 
+//*******************************************************************
+void StatUtils::GetFlatBinIndex(TH2 *hist, TH2I *map, std::vector<int> &index) {
+  //*******************************************************************
+
+  // Same 1D binning as MapToTH1D
+  int nskip = 0;
+  for (int i = 0; i < map->GetNbinsX(); i++) {
+    for (int j = 0; j < map->GetNbinsY(); j++) {
+      if (map->GetBinContent(i + 1, j + 1) <= 0)
+        nskip++;
+    }
+  }
+
+  Int_t Nbins =
+      map->GetXaxis()->GetNbins() * map->GetYaxis()->GetNbins() - nskip;
+
+  index.assign(Nbins, -1);
+
+  // Later map entries overwrite earlier ones, as in MapToTH1D. Entries
+  // beyond Nbins would land in the 1D overflow and are dropped.
+  for (int i = 0; i < map->GetNbinsX(); i++) {
+    for (int j = 0; j < map->GetNbinsY(); j++) {
+      int gb = map->GetBinContent(i + 1, j + 1);
+      if (gb <= 0 || gb > Nbins)
+        continue;
+      index[gb - 1] = hist->GetBin(i + 1, j + 1);
+    }
+  }
+}
+
+//*******************************************************************
+void StatUtils::FillFlatArray(TH2 *hist, std::vector<int> const &index,
+                              std::vector<double> &vals,
+                              std::vector<double> *errs) {
+  //*******************************************************************
+
+  vals.resize(index.size());
+  if (errs) {
+    errs->resize(index.size());
+  }
+
+  for (size_t i = 0; i < index.size(); i++) {
+    if (index[i] < 0) {
+      vals[i] = 0.0;
+      if (errs) {
+        (*errs)[i] = 0.0;
+      }
+      continue;
+    }
+    vals[i] = hist->GetBinContent(index[i]);
+    if (errs) {
+      (*errs)[i] = hist->GetBinError(index[i]);
+    }
+  }
+}
+
 TMatrixDSym *StatUtils::GetCovarFromCorrel(TMatrixDSym *correl, TH1D *data) {
   int nbins = correl->GetNrows();
   TMatrixDSym *covar = new TMatrixDSym(nbins);
@@ -1690,33 +1927,45 @@ TMatrixD *StatUtils::GetMatrixFromTextFile(std::string covfile, int dimx,
                                            int dimy) {
   //*******************************************************************
 
-  // Determine dim
-  if (dimx == -1 and dimy == -1) {
-    std::string line;
-    std::ifstream covar(covfile.c_str(), std::ifstream::in);
-
-    int row = 0;
-    while (std::getline(covar >> std::ws, line, '\n')) {
-      int column = 0;
-
-      std::vector<double> entries = GeneralUtils::ParseToDbl(line, " ");
+  // Read the whole file once
+  std::ifstream covar(covfile.c_str(), std::ifstream::in);
+  std::string contents((std::istreambuf_iterator<char>(covar)),
+                       std::istreambuf_iterator<char>());
+
+  // Reuse the parsed matrix if this file has been read before
+  bool usecache = !contents.empty() && !MatrixCache::GetCacheDir().empty();
+  uint64_t cachekey = 0;
+  if (usecache) {
+    cachekey = MatrixCache::Hash(&dimx, sizeof(dimx));
+    cachekey = MatrixCache::Hash(&dimy, sizeof(dimy), cachekey);
+    cachekey = MatrixCache::Hash(contents.data(), contents.size(), cachekey);
+    TMatrixD *cached = MatrixCache::Read(cachekey);
+    if (cached) {
+      return cached;
+    }
+  }
 
-      if (entries.size() <= 1) {
-        NUIS_ERR(WRN, "StatUtils::GetMatrixFromTextFile, matrix only has <= 1 "
-                      "entries on this line: "
-                          << row);
-      }
-      for (std::vector<double>::iterator iter = entries.begin();
-           iter != entries.end(); iter++) {
-        column++;
+  std::vector<std::vector<double> > rows;
+  std::istringstream lines(contents);
+  std::string line;
+  while (std::getline(lines >> std::ws, line, '\n')) {
+    std::vector<double> entries = GeneralUtils::ParseToDbl(line, " ");
+    if (entries.size() <= 1) {
+      NUIS_ERR(WRN, "StatUtils::GetMatrixFromTextFile, matrix only has <= 1 "
+                    "entries on this line: "
+                        << rows.size());
+    }
+    rows.push_back(entries);
+  }
 
-        if (column > dimx)
-          dimx = column;
-      }
-      row++;
-      if (row > dimy)
-        dimy = row;
+  // Determine dim
+  if (dimx == -1 and dimy == -1) {
+    for (size_t row = 0; row < rows.size(); row++) {
+      if (int(rows[row].size()) > dimx)
+        dimx = rows[row].size();
     }
+    if (!rows.empty())
+      dimy = rows.size();
   }
 
   // Or assume symmetric
@@ -1727,34 +1976,16 @@ TMatrixD *StatUtils::GetMatrixFromTextFile(std::string covfile, int dimx,
 
   // Make new matrix
   TMatrixD *mat = new TMatrixD(dimx, dimy);
-  std::string line;
-  std::ifstream covar(covfile.c_str(), std::ifstream::in);
-
-  int row = 0;
-  while (std::getline(covar >> std::ws, line, '\n')) {
-    int column = 0;
-
-    std::vector<double> entries = GeneralUtils::ParseToDbl(line, " ");
-    if (entries.size() <= 1) {
-      NUIS_ERR(WRN, "StatUtils::GetMatrixFromTextFile, matrix only has <= 1 "
-                    "entries on this line: "
-                        << row);
-    }
-    for (std::vector<double>::iterator iter = entries.begin();
-         iter != entries.end(); iter++) {
-      // Check Rows
-      // assert(row > mat->GetNrows() && " covar rows doesn't match matrix
-      // rows.");
-      // assert(column > mat->GetNcols() && " covar cols doesn't match matrix
-      // cols.");
-
+  for (size_t row = 0; row < rows.size(); row++) {
+    for (size_t column = 0; column < rows[row].size(); column++) {
       // Fill Matrix
-      (*mat)(row, column) = (*iter);
-      column++;
+      (*mat)(row, column) = rows[row][column];
     }
-    row++;
   }
 
+  if (usecache) {
+    MatrixCache::Write(cachekey, *mat);
+  }
   return mat;
 }
 
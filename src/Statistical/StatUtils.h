@@ -30,6 +30,7 @@
 #include <sstream>
 #include <stdlib.h>
 #include <string>
+#include <vector>
 
 // Root Includes
 #include "TDecompChol.h"
@@ -40,6 +41,7 @@
 #include "TH2D.h"
 #include "TH2I.h"
 #include "TMath.h"
+#include "TMatrixD.h"
 #include "TMatrixDSym.h"
 #include "TRandom3.h"
 
@@ -80,6 +82,35 @@ Double_t GetChi2FromCov(TH2D *data, TH2D *mc, TMatrixDSym *invcov,
                         TH2I *map = NULL, TH2I *mask = NULL,
                         TH2D *outchi2perbin = NULL);
 
+//! Get Chi2 using diagonal bin errors from flat arrays in map order.
+//! Same as the 1D histogram version without a mask, but allocates nothing.
+Double_t GetChi2FromDiag(std::vector<double> const &data,
+                         std::vector<double> const &mc,
+                         std::vector<double> const &dataerr,
+                         std::vector<double> const &mcerr);
+
+//! Get Chi2 using an inverted covariance from flat arrays in covariance
+//! order. Same as the 1D histogram version without a mask or
+//! statutils.addmcerror, but allocates nothing.
+Double_t GetChi2FromCov(std::vector<double> const &data,
+                        std::vector<double> const &mc, TMatrixDSym *invcov,
+                        double covar_scale = 1E76, bool SkipEmptyBin = true);
+
+//! Derivative of the flat array GetChi2FromDiag with respect to each mc
+//! entry, holding the MC errors fixed.
+void GetChi2GradientFromDiag(std::vector<double> const &data,
+                             std::vector<double> const &mc,
+                             std::vector<double> const &dataerr,
+                             std::vector<double> &dchi2);
+
+//! Derivative of the flat array GetChi2FromCov with respect to each mc
+//! entry. Which bins SkipEmptyBin drops is taken as fixed.
+void GetChi2GradientFromCov(std::vector<double> const &data,
+                            std::vector<double> const &mc,
+                            TMatrixDSym *invcov, std::vector<double> &dchi2,
+                            double covar_scale = 1E76,
+                            bool SkipEmptyBin = true);
+
 //! Get Chi2 using an SVD method on the covariance before calculation.
 //! Method suggested by Rex at MiniBooNE. Shown that it doesn't actually work.
 Double_t GetChi2FromSVD(TH1D *data, TH1D *mc, TMatrixDSym *cov,
@@ -148,6 +179,11 @@ Int_t GetNDOF(TH2D *hist, TH2I *map = NULL, TH2I *mask = NULL);
 TH1D *ThrowHistogram(TH1D *hist, TMatrixDSym *cov, bool throwdiag = true,
                      TH1I *mask = NULL);
 
+//! Throw ntoys correlated unit Gaussian vectors from a Cholesky decomposition
+//! as returned by GetDecomp, drawing from rng. Row k of the returned
+//! ntoys x nbins matrix is throw k, all made with one matrix product.
+TMatrixD ThrowCorrelated(TMatrixDSym *decomp, int ntoys, TRandom *rng);
+
 //! Given a full covariance for a 2D data set throw the decomposition to
 //! generate fake data. Plots are converted to 1D histograms and the 1D
 //! ThrowHistogram is used, before being converted back to 2D histograms.
@@ -194,8 +230,11 @@ TMatrixDSym *ApplyMatrixMasking(TMatrixDSym *mat, TH2D *data, TH2I *mask,
 //! Check if a matrix can be inverted with cholesky method
 bool IsMatrixWellBehaved(TMatrixDSym* mat);
 
-//! Return inverted matrix of TMatrixDSym
-TMatrixDSym *GetInvert(TMatrixDSym *mat, bool rescale = false);
+//! Return inverted matrix of TMatrixDSym. If usecache is set the inverse is
+//! kept in MatrixCacheDir; only for matrices fixed at setup, it costs a hash
+//! of the whole matrix on every call.
+TMatrixDSym *GetInvert(TMatrixDSym *mat, bool rescale = false,
+                       bool usecache = false);
 
 //! Return Cholesky Decomposed matrix of TMatrixDSym
 TMatrixDSym *GetDecomp(TMatrixDSym *mat);
@@ -254,6 +293,14 @@ void MapFromTH1D(TH2 *fillhist, TH1 *fromhist, TH2I *map);
 //! Apply a map to a 2D mask convering it into a 1D mask.
 TH1I *MapToMask(TH2I *hist, TH2I *map);
 
+//! Get the global bin of hist for each 1D bin the map produces, in the same
+//! order as MapToTH1D. 1D bins that nothing maps to are set to -1.
+void GetFlatBinIndex(TH2 *hist, TH2I *map, std::vector<int> &index);
+
+//! Fill vals (and errs if given) from hist using a flat bin index.
+void FillFlatArray(TH2 *hist, std::vector<int> const &index,
+                   std::vector<double> &vals, std::vector<double> *errs = NULL);
+
 /// \brief Read TMatrixD from a text file
 ///
 /// - covfile = full path to text file
@@ -0,0 +1,103 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+
+
+#include "ToyThrower.h"
+
+#include "MatrixCache.h"
+#include "StatUtils.h"
+
+ToyThrower::ToyThrower()
+    : fDecomp(NULL), fCov(NULL), fCovHash(0), fRandom(NULL), fNBatch(0),
+      fNextToy(0) {}
+
+ToyThrower::~ToyThrower() {
+  delete fDecomp;
+  delete fRandom;
+}
+
+void ToyThrower::SetSeed(UInt_t seed, int nbatch) {
+  delete fRandom;
+  fRandom = new TRandom3(seed);
+  fNBatch = nbatch > 0 ? nbatch : 1;
+  fNextToy = fBatch.GetNrows();
+}
+
+TMatrixDSym *ToyThrower::GetDecomp(TMatrixDSym *cov) {
+  uint64_t hash = MatrixCache::Hash(cov->GetMatrixArray(),
+                                    cov->GetNoElements() * sizeof(double));
+  hash = MatrixCache::Hash(&hash, sizeof(hash), cov->GetNrows());
+  fCov = cov;
+
+  if (!fDecomp || hash != fCovHash) {
+    delete fDecomp;
+    fDecomp = StatUtils::GetDecomp(cov);
+    fCovHash = hash;
+
+    // Throws left from the old decomposition are stale
+    fNextToy = fBatch.GetNrows();
+  }
+  return fDecomp;
+}
+
+void ToyThrower::CovarianceChanged() {
+  delete fDecomp;
+  fDecomp = NULL;
+  fCov = NULL;
+  fNextToy = fBatch.GetNrows();
+}
+
+TH1D *ToyThrower::Throw(TH1D *hist, TMatrixDSym *cov) {
+  TH1D *calc_hist =
+      (TH1D *)hist->Clone((std::string(hist->GetName()) + "_THROW").c_str());
+  if (!cov) {
+    return calc_hist;
+  }
+
+  int nbins = hist->GetNbinsX();
+
+  if (!fRandom) {
+    // Each throw is its own batch here, and costs more than the hash
+    TMatrixD throws = StatUtils::ThrowCorrelated(GetDecomp(cov), 1, gRandom);
+    for (int i = 0; i < nbins; i++) {
+      calc_hist->SetBinContent(i + 1, calc_hist->GetBinContent(i + 1) +
+                                          throws(0, i) * 1E-38);
+    }
+    return calc_hist;
+  }
+
+  // Within a batch only a different covariance is noticed, the contents
+  // are checked when the next batch is drawn.
+  if ((cov != fCov) || (fNextToy >= fBatch.GetNrows())) {
+    GetDecomp(cov);
+  }
+  if (fNextToy >= fBatch.GetNrows()) {
+    fBatch.ResizeTo(fNBatch, fDecomp->GetNrows());
+    fBatch = StatUtils::ThrowCorrelated(fDecomp, fNBatch, fRandom);
+    fNextToy = 0;
+  }
+
+  for (int i = 0; i < nbins; i++) {
+    calc_hist->SetBinContent(i + 1, calc_hist->GetBinContent(i + 1) +
+                                        fBatch(fNextToy, i) * 1E-38);
+  }
+  fNextToy++;
+
+  return calc_hist;
+}
@@ -0,0 +1,77 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+
+#ifndef TOYTHROWER_H
+#define TOYTHROWER_H
+
+#include "TH1D.h"
+#include "TMatrixD.h"
+#include "TMatrixDSym.h"
+#include "TRandom3.h"
+
+#include <stdint.h>
+
+/*!
+ *  \addtogroup Statistical
+ *  @{
+ */
+
+//! Throws correlated toys of a 1D histogram from its covariance, as
+//! StatUtils::ThrowHistogram, for samples that throw many toys.
+//!
+//! The Cholesky decomposition is kept between throws and only redone when
+//! the covariance's contents change. Once SetSeed is called toys come from a
+//! private TRandom3 stream, nbatch at a time from one matrix product, rather
+//! than one gRandom->Gaus at a time. The contents are then only hashed when
+//! a batch is drawn; a covariance changed in place in the middle of a batch
+//! must be flagged with CovarianceChanged.
+class ToyThrower {
+public:
+  ToyThrower();
+  ~ToyThrower();
+
+  //! Draw toys from a stream seeded with seed, nbatch at a time.
+  void SetSeed(UInt_t seed, int nbatch);
+
+  //! Clone of hist with a correlated throw from cov added.
+  TH1D *Throw(TH1D *hist, TMatrixDSym *cov);
+
+  //! Redo the decomposition and drop any throws left from it before the
+  //! next Throw.
+  void CovarianceChanged();
+
+private:
+  ToyThrower(ToyThrower const &);
+  ToyThrower &operator=(ToyThrower const &);
+
+  //! Decomposition of cov, redone only if cov has changed.
+  TMatrixDSym *GetDecomp(TMatrixDSym *cov);
+
+  TMatrixDSym *fDecomp;
+  TMatrixDSym const *fCov; //!< Covariance fDecomp was made from
+  uint64_t fCovHash;
+
+  TRandom3 *fRandom;
+  int fNBatch;
+  TMatrixD fBatch; //!< One throw per row, unscaled
+  int fNextToy;
+};
+
+/*! @} */
+#endif
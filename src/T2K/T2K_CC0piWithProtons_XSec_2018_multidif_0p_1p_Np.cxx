@@ -116,8 +116,8 @@ void T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np::FillEventVariables(
   if (event->NumFSParticle(13) == 0)
     return;
 
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
-  TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
+  FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
 
   double pmu = Pmu.Vect().Mag()/1000.;
   double CosThetaMu = cos(Pnu.Vect().Angle(Pmu.Vect()));
@@ -127,7 +127,7 @@ void T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np::FillEventVariables(
   double CosThetaP = -999;
   // Check if we do have a proton and fill variables
   if (event->NumFSParticle(2212) > 0){
-    TLorentzVector Pp = event->GetHMFSParticle(2212)->fP;
+    FitVector4 Pp = event->GetHMFSParticle(2212)->Vec4();
     pp = Pp.Vect().Mag() / 1000.;
     CosThetaP = cos(Pnu.Vect().Angle(Pp.Vect()));
   }
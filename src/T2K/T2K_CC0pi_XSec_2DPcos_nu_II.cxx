@@ -71,8 +71,8 @@ void T2K_CC0pi_XSec_2DPcos_nu_II::FillEventVariables(FitEvent *event) {
   if (event->NumFSParticle(13) == 0)
     return;
 
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
-  TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
+  FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
 
   double pmu = Pmu.Vect().Mag() / 1000.;
   double CosThetaMu = cos(Pnu.Vect().Angle(Pmu.Vect()));
@@ -84,8 +84,8 @@ void T2K_CC0pi_XSec_H2O_2DPcos_anu::FillEventVariables(FitEvent* event){
   if (event->NumFSParticle(-13) == 0)
     return;
 
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
-  TLorentzVector Pmu = event->GetHMFSParticle(-13)->fP;
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
+  FitVector4 Pmu = event->GetHMFSParticle(-13)->Vec4();
 
   double pmu = Pmu.Vect().Mag();
   double CosThetaMu = cos(Pnu.Vect().Angle(Pmu.Vect()));
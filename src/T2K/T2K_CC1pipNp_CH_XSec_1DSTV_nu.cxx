@@ -156,10 +156,10 @@ void T2K_CC1pipNp_CH_XSec_1DSTV_nu::FillEventVariables(FitEvent *event) {
     return;
   }
 
-  // Get the TLorentzVectors from the event
-  TLorentzVector Pnu  = event->GetNeutrinoIn()->fP;
-  TLorentzVector Pmu  = event->GetHMFSParticle(13)->fP;
-  TLorentzVector Ppip = event->GetHMFSParticle(211)->fP;
+  // Get the four-vectors from the event
+  FitVector4 Pnu  = event->GetNeutrinoIn()->Vec4();
+  FitVector4 Pmu  = event->GetHMFSParticle(13)->Vec4();
+  FitVector4 Ppip = event->GetHMFSParticle(211)->Vec4();
 
   // Proton is a bit trickier (allows for multiple protons)
   std::vector<FitParticle*> protons = event->GetAllFSProton();
@@ -170,7 +170,7 @@ void T2K_CC1pipNp_CH_XSec_1DSTV_nu::FillEventVariables(FitEvent *event) {
   for (size_t i = 0; i < protons.size(); ++i) {
     if (protons[i]->fP.Vect().Mag() > protlo &&
         protons[i]->fP.Vect().Mag() < prothi &&
-        protons[i]->fP.Vect().Angle(Pnu.Vect()) < angular) {
+        protons[i]->Vec3().Angle(Pnu.Vect()) < angular) {
       if (protindex == 0) {
         protindex = i;
       } else if (protons[i]->fP.Vect().Mag() > 
@@ -179,11 +179,11 @@ void T2K_CC1pipNp_CH_XSec_1DSTV_nu::FillEventVariables(FitEvent *event) {
       }
     }
   }
-  TLorentzVector Pp = protons[protindex]->fP;
+  FitVector4 Pp = protons[protindex]->Vec4();
 
   // Make the z vector (cross between nu and mu vectors)
   // Make it unit length
-  TVector3 z = (Pnu.Vect().Cross(Pmu.Vect())).Unit();
+  FitVector3 z = (Pnu.Vect().Cross(Pmu.Vect())).Unit();
 
   // first make projection along neutrino direction
   double plmu = Pmu.Vect().Dot(  Pnu.Vect().Unit());
@@ -193,11 +193,11 @@ void T2K_CC1pipNp_CH_XSec_1DSTV_nu::FillEventVariables(FitEvent *event) {
   double plhad = (Ppip.Vect()+Pp.Vect()).Dot(Pnu.Vect().Unit());
 
   // Muon vector in the non-neutrino direction
-  TVector3 ptmuvec = Pmu.Vect() - plmu*(Pnu.Vect().Unit());
+  FitVector3 ptmuvec = Pmu.Vect() - plmu*(Pnu.Vect().Unit());
   // Hadron vector in the non-neutrino direction
-  TVector3 pthadvec = (Ppip.Vect()+Pp.Vect())-plhad*(Pnu.Vect().Unit());
+  FitVector3 pthadvec = (Ppip.Vect()+Pp.Vect())-plhad*(Pnu.Vect().Unit());
   // Sum
-  TVector3 ptvec = ptmuvec + pthadvec;
+  FitVector3 ptvec = ptmuvec + pthadvec;
 
   // Fill the variables depending on the enums
   switch (fDist) {
@@ -52,9 +52,9 @@ void T2K_CC1pip_CH_XSec_1DQ2_nu::FillEventVariables(FitEvent *event) {
   if (event->NumFSParticle(13) == 0 || event->NumFSParticle(211) == 0)
     return;
 
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
-  TLorentzVector Ppip = event->GetHMFSParticle(211)->fP;
-  TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
+  FitVector4 Ppip = event->GetHMFSParticle(211)->Vec4();
+  FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
 
   double q2 = -999;
 
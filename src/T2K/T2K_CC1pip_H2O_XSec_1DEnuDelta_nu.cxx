@@ -66,9 +66,9 @@ void T2K_CC1pip_H2O_XSec_1DEnuDelta_nu::FillEventVariables(FitEvent *event) {
     return;
 
   // Get the incoming neutrino
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
   // Get the muon
-  TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
+  FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
 
   double Enu = FitUtils::EnuCC1piprecDelta(Pnu, Pmu);
 
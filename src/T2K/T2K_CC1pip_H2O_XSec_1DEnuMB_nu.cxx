@@ -70,11 +70,11 @@ void T2K_CC1pip_H2O_XSec_1DEnuMB_nu::FillEventVariables(FitEvent *event) {
     return;
 
   // Get the incoming neutrino
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
   // Get the muon
-  TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
+  FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
   // Get the pion
-  TLorentzVector Ppip = event->GetHMFSParticle(211)->fP;
+  FitVector4 Ppip = event->GetHMFSParticle(211)->Vec4();
 
   double Enu = FitUtils::EnuCC1piprec(Pnu, Pmu, Ppip);
 
@@ -62,9 +62,9 @@ void T2K_CC1pip_H2O_XSec_1Dcosmu_nu::FillEventVariables(FitEvent *event) {
     return;
 
   // Get the incoming neutrino
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
   // Get the muon
-  TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
+  FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
 
   // Do the cos of the angle between the two
   double cos_th = cos(FitUtils::th(Pnu, Pmu));
@@ -63,9 +63,9 @@ void T2K_CC1pip_H2O_XSec_1Dcosmupi_nu::FillEventVariables(FitEvent *event) {
     return;
 
   // Get the muon
-  TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
+  FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
   // Get the pion
-  TLorentzVector Ppip = event->GetHMFSParticle(211)->fP;
+  FitVector4 Ppip = event->GetHMFSParticle(211)->Vec4();
 
   double cos_th = cos(FitUtils::th(Pmu, Ppip));
 
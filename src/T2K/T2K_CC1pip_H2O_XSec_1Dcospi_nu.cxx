@@ -60,9 +60,9 @@ void T2K_CC1pip_H2O_XSec_1Dcospi_nu::FillEventVariables(FitEvent *event) {
     return;
 
   // Get the incoming neutrino
-  TLorentzVector Pnu = event->GetNeutrinoIn()->fP;
+  FitVector4 Pnu = event->GetNeutrinoIn()->Vec4();
   // Get the pion
-  TLorentzVector Ppip = event->GetHMFSParticle(211)->fP;
+  FitVector4 Ppip = event->GetHMFSParticle(211)->Vec4();
 
   double cos_th = cos(FitUtils::th(Pnu, Ppip));
 
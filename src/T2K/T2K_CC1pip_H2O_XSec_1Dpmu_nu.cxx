@@ -61,7 +61,7 @@ void T2K_CC1pip_H2O_XSec_1Dpmu_nu::FillEventVariables(FitEvent *event) {
     return;
 
   // Get the muon
-  TLorentzVector Pmu = event->GetHMFSParticle(13)->fP;
+  FitVector4 Pmu = event->GetHMFSParticle(13)->Vec4();
 
   double p_mu = FitUtils::p(Pmu);
 
@@ -62,7 +62,7 @@ void T2K_CC1pip_H2O_XSec_1Dppi_nu::FillEventVariables(FitEvent *event) {
     return;
 
   // Get the pion
-  TLorentzVector Ppip = event->GetHMFSParticle(211)->fP;
+  FitVector4 Ppip = event->GetHMFSParticle(211)->Vec4();
 
   double p_pi = FitUtils::p(Ppip);
 
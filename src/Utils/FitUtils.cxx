@@ -42,7 +42,7 @@ double *FitUtils::GetArrayFromMap(std::vector<std::string> invals,
 
 //********************************************************************
 // Returns the kinetic energy of a particle in GeV
-double FitUtils::T(TLorentzVector part) {
+double FitUtils::T(FitVector4 const &part) {
   //********************************************************************
   double E_part = part.E() / 1000.;
   double p_part = part.Vect().Mag() / 1000.;
@@ -52,26 +52,39 @@ double FitUtils::T(TLorentzVector part) {
   return KE_part;
 };
 
+double FitUtils::T(TLorentzVector const &part) {
+  return T(FitVector4(part));
+}
+
 //********************************************************************
 // Returns the momentum of a particle in GeV
-double FitUtils::p(TLorentzVector part) {
+double FitUtils::p(FitVector4 const &part) {
   //********************************************************************
   double p_part = part.Vect().Mag() / 1000.;
   return p_part;
 };
 
-double FitUtils::p(FitParticle *part) { return FitUtils::p(part->fP); };
+double FitUtils::p(TLorentzVector const &part) {
+  return p(FitVector4(part));
+}
+
+double FitUtils::p(FitParticle *part) { return FitUtils::p(part->Vec4()); };
 
 //********************************************************************
 // Returns the angle between two particles in radians
-double FitUtils::th(TLorentzVector part1, TLorentzVector part2) {
+double FitUtils::th(FitVector4 const &part1, FitVector4 const &part2) {
   //********************************************************************
   double th = part1.Vect().Angle(part2.Vect());
   return th;
 };
 
+double FitUtils::th(TLorentzVector const &part1,
+                    TLorentzVector const &part2) {
+  return th(FitVector4(part1), FitVector4(part2));
+}
+
 double FitUtils::th(FitParticle *part1, FitParticle *part2) {
-  return FitUtils::th(part1->fP, part2->fP);
+  return FitUtils::th(part1->Vec4(), part2->Vec4());
 };
 
 // T2K CC1pi+ helper functions
@@ -81,21 +94,22 @@ double FitUtils::th(FitParticle *part1, FitParticle *part2) {
 // paper
 // Uses "MiniBooNE formula" for Enu, here called EnuCC1pip_T2K_MB
 //********************************************************************
-double FitUtils::thq3pi_CC1pip_T2K(TLorentzVector pnu, TLorentzVector pmu,
-                                   TLorentzVector ppi) {
+double FitUtils::thq3pi_CC1pip_T2K(FitVector4 const &pnu,
+                                   FitVector4 const &pmu,
+                                   FitVector4 const &ppi) {
   // Want this in GeV
-  TVector3 p_mu = pmu.Vect() * (1. / 1000.);
+  FitVector3 p_mu = pmu.Vect() * (1. / 1000.);
 
   // Get the reconstructed Enu
   // We are not using Michel e sample, so we have pion kinematic information
   double Enu = EnuCC1piprec(pnu, pmu, ppi, true);
 
   // Get neutrino unit direction, multiply by reconstructed Enu
-  TVector3 p_nu = pnu.Vect() * (1. / (pnu.Vect().Mag())) * Enu;
-  TVector3 p_pi = ppi.Vect() * (1. / 1000.);
+  FitVector3 p_nu = pnu.Vect() * (1. / (pnu.Vect().Mag())) * Enu;
+  FitVector3 p_pi = ppi.Vect() * (1. / 1000.);
 
   // This is now in GeV
-  TVector3 q3 = (p_nu - p_mu);
+  FitVector3 q3 = (p_nu - p_mu);
   // Want this in GeV
 
   double th_q3_pi = q3.Angle(p_pi);
@@ -103,12 +117,18 @@ double FitUtils::thq3pi_CC1pip_T2K(TLorentzVector pnu, TLorentzVector pmu,
   return th_q3_pi;
 }
 
+double FitUtils::thq3pi_CC1pip_T2K(TLorentzVector const &pnu,
+                                   TLorentzVector const &pmu,
+                                   TLorentzVector const &ppi) {
+  return thq3pi_CC1pip_T2K(FitVector4(pnu), FitVector4(pmu), FitVector4(ppi));
+}
+
 //********************************************************************
 // Returns the q3 defined in Raquel's CC1pi+ on CH paper
 // Uses "MiniBooNE formula" for Enu
 //********************************************************************
-double FitUtils::q3_CC1pip_T2K(TLorentzVector pnu, TLorentzVector pmu,
-                               TLorentzVector ppi) {
+double FitUtils::q3_CC1pip_T2K(FitVector4 const &pnu, FitVector4 const &pmu,
+                               FitVector4 const &ppi) {
   // Can't use the true Enu here; need to reconstruct it
   // We do have Michel e- here so reconstruct Enu by "MiniBooNE formula" without
   // pion kinematics
@@ -116,20 +136,27 @@ double FitUtils::q3_CC1pip_T2K(TLorentzVector pnu, TLorentzVector pmu,
   // Last bool refers to if we have pion kinematic information or not
   double Enu = EnuCC1piprec(pnu, pmu, ppi, false);
 
-  TVector3 p_mu = pmu.Vect() * (1. / 1000.);
-  TVector3 p_nu = pnu.Vect() * (1. / pnu.Vect().Mag()) * Enu;
+  FitVector3 p_mu = pmu.Vect() * (1. / 1000.);
+  FitVector3 p_nu = pnu.Vect() * (1. / pnu.Vect().Mag()) * Enu;
 
   double q3 = (p_nu - p_mu).Mag();
 
   return q3;
 }
 
+double FitUtils::q3_CC1pip_T2K(TLorentzVector const &pnu,
+                               TLorentzVector const &pmu,
+                               TLorentzVector const &ppi) {
+  return q3_CC1pip_T2K(FitVector4(pnu), FitVector4(pmu), FitVector4(ppi));
+}
+
 //********************************************************************
 // Returns the W reconstruction from Raquel CC1pi+ CH thesis
 // Uses the MiniBooNE formula Enu
 //********************************************************************
-double FitUtils::WrecCC1pip_T2K_MB(TLorentzVector pnu, TLorentzVector pmu,
-                                   TLorentzVector ppi) {
+double FitUtils::WrecCC1pip_T2K_MB(FitVector4 const &pnu,
+                                   FitVector4 const &pmu,
+                                   FitVector4 const &ppi) {
   double E_mu = pmu.E() / 1000.;
   double p_mu = pmu.Vect().Mag() / 1000.;
   double E_nu = EnuCC1piprec(pnu, pmu, ppi, false);
@@ -142,6 +169,12 @@ double FitUtils::WrecCC1pip_T2K_MB(TLorentzVector pnu, TLorentzVector pmu,
   return wrec;
 }
 
+double FitUtils::WrecCC1pip_T2K_MB(TLorentzVector const &pnu,
+                                   TLorentzVector const &pmu,
+                                   TLorentzVector const &ppi) {
+  return WrecCC1pip_T2K_MB(FitVector4(pnu), FitVector4(pmu), FitVector4(ppi));
+}
+
 //********************************************************
 double FitUtils::ProtonQ2QErec(double pE, double binding) {
   //********************************************************
@@ -158,7 +191,7 @@ double FitUtils::ProtonQ2QErec(double pE, double binding) {
 };
 
 //********************************************************************
-double FitUtils::EnuQErec(TLorentzVector pmu, double costh, double binding,
+double FitUtils::EnuQErec(FitVector4 const &pmu, double costh, double binding,
                           bool neutrino) {
   //********************************************************************
 
@@ -186,13 +219,24 @@ double FitUtils::EnuQErec(TLorentzVector pmu, double costh, double binding,
   return rEnu;
 };
 
+double FitUtils::EnuQErec(TLorentzVector const &pmu, double costh,
+                          double binding, bool neutrino) {
+  return EnuQErec(FitVector4(pmu), costh, binding, neutrino);
+}
+
 // Another good old helper function
-double FitUtils::EnuQErec(TLorentzVector pmu, TLorentzVector pnu,
+double FitUtils::EnuQErec(FitVector4 const &pmu, FitVector4 const &pnu,
                           double binding, bool neutrino) {
   return EnuQErec(pmu, cos(pnu.Vect().Angle(pmu.Vect())), binding, neutrino);
 }
 
-double FitUtils::Q2QErec(TLorentzVector pmu, double costh, double binding,
+double FitUtils::EnuQErec(TLorentzVector const &pmu,
+                          TLorentzVector const &pnu, double binding,
+                          bool neutrino) {
+  return EnuQErec(FitVector4(pmu), FitVector4(pnu), binding, neutrino);
+}
+
+double FitUtils::Q2QErec(FitVector4 const &pmu, double costh, double binding,
                          bool neutrino) {
   double el = pmu.E() / 1000.;
   double pl = (pmu.Vect().Mag()) / 1000.; // momentum of lepton
@@ -204,13 +248,23 @@ double FitUtils::Q2QErec(TLorentzVector pmu, double costh, double binding,
   return q2;
 };
 
-double FitUtils::Q2QErec(TLorentzVector Pmu, TLorentzVector Pnu, double binding,
-                         bool neutrino) {
+double FitUtils::Q2QErec(TLorentzVector const &pmu, double costh,
+                         double binding, bool neutrino) {
+  return Q2QErec(FitVector4(pmu), costh, binding, neutrino);
+}
+
+double FitUtils::Q2QErec(FitVector4 const &Pmu, FitVector4 const &Pnu,
+                         double binding, bool neutrino) {
   double q2qe =
       Q2QErec(Pmu, cos(Pnu.Vect().Angle(Pmu.Vect())), binding, neutrino);
   return q2qe;
 }
 
+double FitUtils::Q2QErec(TLorentzVector const &Pmu, TLorentzVector const &Pnu,
+                         double binding, bool neutrino) {
+  return Q2QErec(FitVector4(Pmu), FitVector4(Pnu), binding, neutrino);
+}
+
 double FitUtils::EnuQErec(double pl, double costh, double binding,
                           bool neutrino) {
   if (pl < 0)
@@ -250,8 +304,8 @@ double FitUtils::Q2QErec(double pl, double costh, double binding,
 //********************************************************************
 // Reconstructs Enu for CC1pi0
 // Very similar for CC1pi+ reconstruction
-double FitUtils::EnuCC1pi0rec(TLorentzVector pnu, TLorentzVector pmu,
-                              TLorentzVector ppi0) {
+double FitUtils::EnuCC1pi0rec(FitVector4 const &pnu, FitVector4 const &pmu,
+                              FitVector4 const &ppi0) {
   //********************************************************************
 
   double E_mu = pmu.E() / 1000;
@@ -277,10 +331,16 @@ double FitUtils::EnuCC1pi0rec(TLorentzVector pnu, TLorentzVector pmu,
   return rEnu;
 };
 
+double FitUtils::EnuCC1pi0rec(TLorentzVector const &pnu,
+                              TLorentzVector const &pmu,
+                              TLorentzVector const &ppi0) {
+  return EnuCC1pi0rec(FitVector4(pnu), FitVector4(pmu), FitVector4(ppi0));
+}
+
 //********************************************************************
 // Reconstruct Q2 for CC1pi0
 // Beware: uses true Enu, not reconstructed Enu
-double FitUtils::Q2CC1pi0rec(TLorentzVector pnu, TLorentzVector pmu) {
+double FitUtils::Q2CC1pi0rec(FitVector4 const &pnu, FitVector4 const &pmu) {
   //********************************************************************
 
   double E_mu = pmu.E() / 1000.;                 // energy of lepton in GeV
@@ -296,13 +356,18 @@ double FitUtils::Q2CC1pi0rec(TLorentzVector pnu, TLorentzVector pmu) {
   return q2;
 };
 
+double FitUtils::Q2CC1pi0rec(TLorentzVector const &pnu,
+                             TLorentzVector const &pmu) {
+  return Q2CC1pi0rec(FitVector4(pnu), FitVector4(pmu));
+}
+
 //********************************************************************
 // Reconstruct Enu for CC1pi+
 // pionInfo reflects if we're using pion kinematics or not
 // In T2K CC1pi+ CH the Michel tag is used for pion in which pion kinematic info
 // is lost and Enu is reconstructed without pion kinematics
-double FitUtils::EnuCC1piprec(TLorentzVector pnu, TLorentzVector pmu,
-                              TLorentzVector ppi, bool pionInfo) {
+double FitUtils::EnuCC1piprec(FitVector4 const &pnu, FitVector4 const &pmu,
+                              FitVector4 const &ppi, bool pionInfo) {
   //********************************************************************
 
   double E_mu = pmu.E() / 1000.;
@@ -349,10 +414,18 @@ double FitUtils::EnuCC1piprec(TLorentzVector pnu, TLorentzVector pmu,
   return rEnu;
 };
 
+double FitUtils::EnuCC1piprec(TLorentzVector const &pnu,
+                              TLorentzVector const &pmu,
+                              TLorentzVector const &ppi, bool pionInfo) {
+  return EnuCC1piprec(FitVector4(pnu), FitVector4(pmu), FitVector4(ppi),
+                      pionInfo);
+}
+
 //********************************************************************
 // Reconstruct neutrino energy from outgoing particles; will differ from the
 // actual neutrino energy. Here we use assumption of a Delta resonance
-double FitUtils::EnuCC1piprecDelta(TLorentzVector pnu, TLorentzVector pmu) {
+double FitUtils::EnuCC1piprecDelta(FitVector4 const &pnu,
+                                   FitVector4 const &pmu) {
   //********************************************************************
 
   const double m_Delta =
@@ -372,24 +445,30 @@ double FitUtils::EnuCC1piprecDelta(TLorentzVector pnu, TLorentzVector pmu) {
   return rEnu;
 };
 
+double FitUtils::EnuCC1piprecDelta(TLorentzVector const &pnu,
+                                   TLorentzVector const &pmu) {
+  return EnuCC1piprecDelta(FitVector4(pnu), FitVector4(pmu));
+}
+
 // MOVE TO T2K UTILS!
 //********************************************************************
 // Reconstruct Enu using "extended MiniBooNE" as defined in Raquel's T2K TN
 //
 // Supposedly includes pion direction and binding energy of target nucleon
 // I'm not convinced (yet), maybe
-double FitUtils::EnuCC1piprec_T2K_eMB(TLorentzVector pnu, TLorentzVector pmu,
-                                      TLorentzVector ppi) {
+double FitUtils::EnuCC1piprec_T2K_eMB(FitVector4 const &pnu,
+                                      FitVector4 const &pmu,
+                                      FitVector4 const &ppi) {
   //********************************************************************
 
   // Unit vector for neutrino momentum
-  TVector3 p_nu_vect_unit = pnu.Vect() * (1. / pnu.E());
+  FitVector3 p_nu_vect_unit = pnu.Vect() * (1. / pnu.E());
 
   double E_mu = pmu.E() / 1000.;
-  TVector3 p_mu_vect = pmu.Vect() * (1. / 1000.);
+  FitVector3 p_mu_vect = pmu.Vect() * (1. / 1000.);
 
   double E_pi = ppi.E() / 1000.;
-  TVector3 p_pi_vect = ppi.Vect() * (1. / 1000.);
+  FitVector3 p_pi_vect = ppi.Vect() * (1. / 1000.);
 
   double E_bind = 25. / 1000.;
   double m_p = PhysConst::mass_proton;
@@ -408,6 +487,13 @@ double FitUtils::EnuCC1piprec_T2K_eMB(TLorentzVector pnu, TLorentzVector pmu,
   return rEnu;
 }
 
+double FitUtils::EnuCC1piprec_T2K_eMB(TLorentzVector const &pnu,
+                                      TLorentzVector const &pmu,
+                                      TLorentzVector const &ppi) {
+  return EnuCC1piprec_T2K_eMB(FitVector4(pnu), FitVector4(pmu),
+                              FitVector4(ppi));
+}
+
 //********************************************************************
 // Reconstructed Q2 for CC1pi+
 //
@@ -418,8 +504,9 @@ double FitUtils::EnuCC1piprec_T2K_eMB(TLorentzVector pnu, TLorentzVector pmu,
 //        "MiniBooNE" reconstructed (EnuCC1piprec with pionInfo = false, the
 //        case for T2K when using Michel tag) (T2K CH)
 // 3 uses Delta for reconstruction (T2K CH)
-double FitUtils::Q2CC1piprec(TLorentzVector pnu, TLorentzVector pmu,
-                             TLorentzVector ppi, int enuType, bool pionInfo) {
+double FitUtils::Q2CC1piprec(FitVector4 const &pnu, FitVector4 const &pmu,
+                             FitVector4 const &ppi, int enuType,
+                             bool pionInfo) {
   //********************************************************************
 
   double E_mu = pmu.E() / 1000.;                 // energy of lepton in GeV
@@ -458,13 +545,21 @@ double FitUtils::Q2CC1piprec(TLorentzVector pnu, TLorentzVector pmu,
   return q2;
 };
 
+double FitUtils::Q2CC1piprec(TLorentzVector const &pnu,
+                             TLorentzVector const &pmu,
+                             TLorentzVector const &ppi, int enuType,
+                             bool pionInfo) {
+  return Q2CC1piprec(FitVector4(pnu), FitVector4(pmu), FitVector4(ppi),
+                     enuType, pionInfo);
+}
+
 //********************************************************************
 // Returns the reconstructed W from a nucleon and an outgoing pion
 //
 // Could do this a lot more clever (pp + ppi).Mag() would do the job, but this
 // would be less instructive
 //********************************************************************
-double FitUtils::MpPi(TLorentzVector pp, TLorentzVector ppi) {
+double FitUtils::MpPi(FitVector4 const &pp, FitVector4 const &ppi) {
   double E_p = pp.E();
   double p_p = pp.Vect().Mag();
   double m_p = sqrt(E_p * E_p - p_p * p_p);
@@ -482,6 +577,10 @@ double FitUtils::MpPi(TLorentzVector pp, TLorentzVector ppi) {
   return invMass;
 };
 
+double FitUtils::MpPi(TLorentzVector const &pp, TLorentzVector const &ppi) {
+  return MpPi(FitVector4(pp), FitVector4(ppi));
+}
+
 //********************************************************
 
 // Reconstruct the hadronic mass using neutrino and muon
@@ -492,7 +591,7 @@ double FitUtils::MpPi(TLorentzVector pp, TLorentzVector ppi) {
 // Only MINERvA uses this so far; and the Enu is Enu_true
 // If we want W_true need to take initial state nucleon motion into account
 // Return value is in MeV!!!
-double FitUtils::Wrec(TLorentzVector pnu, TLorentzVector pmu) {
+double FitUtils::Wrec(FitVector4 const &pnu, FitVector4 const &pmu) {
   //********************************************************
 
   double E_mu = pmu.E();
@@ -513,6 +612,10 @@ double FitUtils::Wrec(TLorentzVector pnu, TLorentzVector pmu) {
   return w_rec;
 };
 
+double FitUtils::Wrec(TLorentzVector const &pnu, TLorentzVector const &pmu) {
+  return Wrec(FitVector4(pnu), FitVector4(pmu));
+}
+
 //********************************************************
 // Reconstruct the true hadronic mass using the initial state and muon
 // Could technically do E_nu = EnuCC1pipRec(pnu,pmu,ppi) too, but this wwill be
@@ -521,8 +624,8 @@ double FitUtils::Wrec(TLorentzVector pnu, TLorentzVector pmu) {
 //
 // No one seems to use this because it's fairly MC dependent!
 // Return value is in MeV!!!
-double FitUtils::Wtrue(TLorentzVector pnu, TLorentzVector pmu,
-                       TLorentzVector pnuc) {
+double FitUtils::Wtrue(FitVector4 const &pnu, FitVector4 const &pmu,
+                       FitVector4 const &pnuc) {
   //********************************************************
 
   // Could simply do the TLorentzVector operators here but this is more
@@ -550,6 +653,11 @@ double FitUtils::Wtrue(TLorentzVector pnu, TLorentzVector pmu,
   return w_rec;
 };
 
+double FitUtils::Wtrue(TLorentzVector const &pnu, TLorentzVector const &pmu,
+                       TLorentzVector const &pnuc) {
+  return Wtrue(FitVector4(pnu), FitVector4(pmu), FitVector4(pnuc));
+}
+
 double FitUtils::SumKE_PartVect(std::vector<FitParticle *> const fps) {
   double sum = 0.0;
   for (size_t p_it = 0; p_it < fps.size(); ++p_it) {
@@ -27,6 +27,7 @@
 #include <unistd.h>
 
 #include "FitEvent.h"
+#include "FitVector.h"
 #include "TGraph.h"
 #include "TH2Poly.h"
 #include <TChain.h>
@@ -57,23 +58,36 @@ namespace FitUtils {
 double *GetArrayFromMap(std::vector<std::string> invals,
                         std::map<std::string, double> inmap);
 
+/*
+  The kinematic functions below take FitVector4 so that sample code working
+  on FitParticle::Vec4 does no TObject copies. The TLorentzVector overloads
+  convert and forward, so existing callers get identical results.
+*/
+
 /// Returns kinetic energy of particle
-double T(TLorentzVector part);
+double T(FitVector4 const &part);
+double T(TLorentzVector const &part);
 
 /// Returns momentum of particle
-double p(TLorentzVector part);
+double p(FitVector4 const &part);
+double p(TLorentzVector const &part);
 double p(FitParticle *part);
 
 /// Returns angle between particles (_NOT_ cosine!)
-double th(TLorentzVector part, TLorentzVector part2);
+double th(FitVector4 const &part, FitVector4 const &part2);
+double th(TLorentzVector const &part, TLorentzVector const &part2);
 double th(FitParticle *part1, FitParticle *part2);
 
 /// Hadronic mass reconstruction
-double Wrec(TLorentzVector pnu, TLorentzVector pmu);
+double Wrec(FitVector4 const &pnu, FitVector4 const &pmu);
+double Wrec(TLorentzVector const &pnu, TLorentzVector const &pmu);
 
 /// Hadronic mass true from initial state particles and muon; useful if the full
 /// FSI vectors aren't not saved and we for some reasons need W_true
-double Wtrue(TLorentzVector pnu, TLorentzVector pmu, TLorentzVector pnuc);
+double Wtrue(FitVector4 const &pnu, FitVector4 const &pmu,
+             FitVector4 const &pnuc);
+double Wtrue(TLorentzVector const &pnu, TLorentzVector const &pmu,
+             TLorentzVector const &pnuc);
 
 double SumKE_PartVect(std::vector<FitParticle *> const fps);
 double SumTE_PartVect(std::vector<FitParticle *> const fps);
@@ -89,23 +103,31 @@ double Eavailable(FitEvent *event);
   CCQE MiniBooNE/MINERvA
 */
 /// Function to calculate the reconstructed Q^{2}_{QE}
-double Q2QErec(TLorentzVector pmu, double costh, double binding,
+double Q2QErec(FitVector4 const &pmu, double costh, double binding,
+               bool neutrino = true);
+double Q2QErec(TLorentzVector const &pmu, double costh, double binding,
                bool neutrino = true);
 
 /// Function returns the reconstructed E_{nu} values
-double EnuQErec(TLorentzVector pmu, double costh, double binding,
+double EnuQErec(FitVector4 const &pmu, double costh, double binding,
+                bool neutrino = true);
+double EnuQErec(TLorentzVector const &pmu, double costh, double binding,
                 bool neutrino = true);
 
 /// Function returns the reconstructed E_{nu} values
-double EnuQErec(TLorentzVector pmu, TLorentzVector pnu, double binding,
+double EnuQErec(FitVector4 const &pmu, FitVector4 const &pnu, double binding,
                 bool neutrino = true);
+double EnuQErec(TLorentzVector const &pmu, TLorentzVector const &pnu,
+                double binding, bool neutrino = true);
 
 //! Function to calculate the reconstructed Q^{2}_{QE}
 double Q2QErec(double pl, double costh, double binding, bool neutrino = true);
 
 //! Function to calculate the reconstructed Q^{2}_{QE}
-double Q2QErec(TLorentzVector Pmu, TLorentzVector Pnu, double binding,
+double Q2QErec(FitVector4 const &Pmu, FitVector4 const &Pnu, double binding,
                bool neutrino = true);
+double Q2QErec(TLorentzVector const &Pmu, TLorentzVector const &Pnu,
+               double binding, bool neutrino = true);
 
 //! Function returns the reconstructed E_{nu} values
 double EnuQErec(double pl, double costh, double binding, bool neutrino = true);
@@ -143,11 +165,14 @@ double GetErecoil_MINERvA_LowRecoil(FitEvent *event);
   CC1pi0 MiniBooNE
 */
 /// Reconstruct Enu from CCpi0 vectors and binding energy
-double EnuCC1pi0rec(TLorentzVector pnu, TLorentzVector pmu,
-                    TLorentzVector ppi0 = TLorentzVector(0, 0, 0, 0));
+double EnuCC1pi0rec(FitVector4 const &pnu, FitVector4 const &pmu,
+                    FitVector4 const &ppi0 = FitVector4(0, 0, 0, 0));
+double EnuCC1pi0rec(TLorentzVector const &pnu, TLorentzVector const &pmu,
+                    TLorentzVector const &ppi0 = TLorentzVector(0, 0, 0, 0));
 
 /// Reconstruct Q2 from CCpi0 vectors and binding energy
-double Q2CC1pi0rec(TLorentzVector pnu, TLorentzVector pmu);
+double Q2CC1pi0rec(FitVector4 const &pnu, FitVector4 const &pmu);
+double Q2CC1pi0rec(TLorentzVector const &pnu, TLorentzVector const &pmu);
 
 /*
   CC1pi+ MiniBooNE
@@ -156,33 +181,50 @@ double Q2CC1pi0rec(TLorentzVector pnu, TLorentzVector pmu);
 /// returns reconstructed Enu a la MiniBooNE CCpi+
 /// returns reconstructed Enu a la MiniBooNE CCpi+
 // Also for when not having pion info (so when we have a Michel tag in T2K)
-double EnuCC1piprec(TLorentzVector pnu, TLorentzVector pmu, TLorentzVector ppip,
-                    bool pionInfo = true);
+double EnuCC1piprec(FitVector4 const &pnu, FitVector4 const &pmu,
+                    FitVector4 const &ppip, bool pionInfo = true);
+double EnuCC1piprec(TLorentzVector const &pnu, TLorentzVector const &pmu,
+                    TLorentzVector const &ppip, bool pionInfo = true);
 
 /// returns reconstructed Enu assumming resonance interaction where intermediate
 /// resonance was a Delta
-double EnuCC1piprecDelta(TLorentzVector pnu, TLorentzVector pmu);
+double EnuCC1piprecDelta(FitVector4 const &pnu, FitVector4 const &pmu);
+double EnuCC1piprecDelta(TLorentzVector const &pnu, TLorentzVector const &pmu);
 
 /// returns reconstructed in a variety of flavours
-double Q2CC1piprec(TLorentzVector pnu, TLorentzVector pmu, TLorentzVector ppip,
-                   int enuType = 0, bool pionInfo = true);
+double Q2CC1piprec(FitVector4 const &pnu, FitVector4 const &pmu,
+                   FitVector4 const &ppip, int enuType = 0,
+                   bool pionInfo = true);
+double Q2CC1piprec(TLorentzVector const &pnu, TLorentzVector const &pmu,
+                   TLorentzVector const &ppip, int enuType = 0,
+                   bool pionInfo = true);
 
 /*
   T2K CC1pi+ on CH
 */
-double thq3pi_CC1pip_T2K(TLorentzVector pnu, TLorentzVector pmu,
-                         TLorentzVector ppi);
-double q3_CC1pip_T2K(TLorentzVector pnu, TLorentzVector pmu,
-                     TLorentzVector ppi);
-double WrecCC1pip_T2K_MB(TLorentzVector pnu, TLorentzVector pmu,
-                         TLorentzVector ppip);
-double EnuCC1piprec_T2K_eMB(TLorentzVector pnu, TLorentzVector pmu,
-                            TLorentzVector ppi);
+double thq3pi_CC1pip_T2K(FitVector4 const &pnu, FitVector4 const &pmu,
+                         FitVector4 const &ppi);
+double thq3pi_CC1pip_T2K(TLorentzVector const &pnu, TLorentzVector const &pmu,
+                         TLorentzVector const &ppi);
+double q3_CC1pip_T2K(FitVector4 const &pnu, FitVector4 const &pmu,
+                     FitVector4 const &ppi);
+double q3_CC1pip_T2K(TLorentzVector const &pnu, TLorentzVector const &pmu,
+                     TLorentzVector const &ppi);
+double WrecCC1pip_T2K_MB(FitVector4 const &pnu, FitVector4 const &pmu,
+                         FitVector4 const &ppip);
+double WrecCC1pip_T2K_MB(TLorentzVector const &pnu, TLorentzVector const &pmu,
+                         TLorentzVector const &ppip);
+double EnuCC1piprec_T2K_eMB(FitVector4 const &pnu, FitVector4 const &pmu,
+                            FitVector4 const &ppi);
+double EnuCC1piprec_T2K_eMB(TLorentzVector const &pnu,
+                            TLorentzVector const &pmu,
+                            TLorentzVector const &ppi);
 
 /*
   nucleon single pion
 */
-double MpPi(TLorentzVector pp, TLorentzVector ppi);
+double MpPi(FitVector4 const &pp, FitVector4 const &ppi);
+double MpPi(TLorentzVector const &pp, TLorentzVector const &ppi);
 
 // For T2K inferred kinematics analyis - variables defined as on page 7 of T2K
 // TN287v11 (and now arXiv 1802.05078)
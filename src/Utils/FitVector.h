@@ -0,0 +1,194 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef FITVECTOR_H_SEEN
+#define FITVECTOR_H_SEEN
+
+#include "TLorentzVector.h"
+#include "TVector3.h"
+
+#include <cmath>
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+/// Plain three-vector for per-event kinematics. Unlike TVector3 it is not a
+/// TObject, so it is cheap to copy and return by value. The arithmetic
+/// follows TVector3 operation for operation, so results are bit identical.
+struct FitVector3 {
+  double fX, fY, fZ;
+
+  FitVector3() = default;
+  FitVector3(double x, double y, double z) : fX(x), fY(y), fZ(z) {}
+  explicit FitVector3(TVector3 const &v) : fX(v.X()), fY(v.Y()), fZ(v.Z()) {}
+
+  inline double X() const { return fX; }
+  inline double Y() const { return fY; }
+  inline double Z() const { return fZ; }
+
+  inline double Mag2() const { return fX * fX + fY * fY + fZ * fZ; }
+  inline double Mag() const { return std::sqrt(Mag2()); }
+  inline double Perp2() const { return fX * fX + fY * fY; }
+  inline double Perp() const { return std::sqrt(Perp2()); }
+
+  inline double Dot(FitVector3 const &v) const {
+    return fX * v.fX + fY * v.fY + fZ * v.fZ;
+  }
+
+  inline FitVector3 Cross(FitVector3 const &v) const {
+    return FitVector3(fY * v.fZ - v.fY * fZ, fZ * v.fX - v.fZ * fX,
+                      fX * v.fY - v.fX * fY);
+  }
+
+  inline double CosTheta() const {
+    double ptot = Mag();
+    return ptot == 0.0 ? 1.0 : fZ / ptot;
+  }
+
+  /// Angle to v in radians, 0 if either vector is null.
+  inline double Angle(FitVector3 const &v) const {
+    double ptot2 = Mag2() * v.Mag2();
+    if (ptot2 <= 0) {
+      return 0.0;
+    }
+    double arg = Dot(v) / std::sqrt(ptot2);
+    if (arg > 1.0) {
+      arg = 1.0;
+    }
+    if (arg < -1.0) {
+      arg = -1.0;
+    }
+    return std::acos(arg);
+  }
+
+  inline FitVector3 Unit() const {
+    double tot2 = Mag2();
+    double tot = (tot2 > 0) ? 1.0 / std::sqrt(tot2) : 1.0;
+    return FitVector3(fX * tot, fY * tot, fZ * tot);
+  }
+
+  inline TVector3 ToROOT() const { return TVector3(fX, fY, fZ); }
+
+  inline FitVector3 &operator+=(FitVector3 const &v) {
+    fX += v.fX;
+    fY += v.fY;
+    fZ += v.fZ;
+    return *this;
+  }
+  inline FitVector3 &operator-=(FitVector3 const &v) {
+    fX -= v.fX;
+    fY -= v.fY;
+    fZ -= v.fZ;
+    return *this;
+  }
+  inline FitVector3 operator-() const { return FitVector3(-fX, -fY, -fZ); }
+};
+
+inline FitVector3 operator+(FitVector3 const &a, FitVector3 const &b) {
+  return FitVector3(a.fX + b.fX, a.fY + b.fY, a.fZ + b.fZ);
+}
+inline FitVector3 operator-(FitVector3 const &a, FitVector3 const &b) {
+  return FitVector3(a.fX - b.fX, a.fY - b.fY, a.fZ - b.fZ);
+}
+/// Scalar product, as for TVector3.
+inline double operator*(FitVector3 const &a, FitVector3 const &b) {
+  return a.Dot(b);
+}
+inline FitVector3 operator*(FitVector3 const &v, double a) {
+  return FitVector3(a * v.fX, a * v.fY, a * v.fZ);
+}
+inline FitVector3 operator*(double a, FitVector3 const &v) {
+  return FitVector3(a * v.fX, a * v.fY, a * v.fZ);
+}
+
+/// Plain four-vector (px, py, pz, E), the TLorentzVector counterpart of
+/// FitVector3.
+struct FitVector4 {
+  double fX, fY, fZ, fE;
+
+  FitVector4() = default;
+  FitVector4(double x, double y, double z, double e)
+      : fX(x), fY(y), fZ(z), fE(e) {}
+  FitVector4(FitVector3 const &p, double e)
+      : fX(p.fX), fY(p.fY), fZ(p.fZ), fE(e) {}
+  explicit FitVector4(TLorentzVector const &v)
+      : fX(v.X()), fY(v.Y()), fZ(v.Z()), fE(v.T()) {}
+
+  inline double X() const { return fX; }
+  inline double Y() const { return fY; }
+  inline double Z() const { return fZ; }
+  inline double T() const { return fE; }
+  inline double E() const { return fE; }
+
+  inline FitVector3 Vect() const { return FitVector3(fX, fY, fZ); }
+  inline double P() const { return Vect().Mag(); }
+
+  inline double Mag2() const { return fE * fE - Vect().Mag2(); }
+  /// Negative for space-like vectors, as TLorentzVector::Mag.
+  inline double Mag() const {
+    double mm = Mag2();
+    return mm < 0.0 ? -std::sqrt(-mm) : std::sqrt(mm);
+  }
+  inline double M2() const { return Mag2(); }
+  inline double M() const { return Mag(); }
+
+  inline double Dot(FitVector4 const &v) const {
+    return fE * v.fE - fZ * v.fZ - fY * v.fY - fX * v.fX;
+  }
+
+  inline TLorentzVector ToROOT() const {
+    return TLorentzVector(fX, fY, fZ, fE);
+  }
+
+  inline FitVector4 &operator+=(FitVector4 const &v) {
+    fX += v.fX;
+    fY += v.fY;
+    fZ += v.fZ;
+    fE += v.fE;
+    return *this;
+  }
+  inline FitVector4 &operator-=(FitVector4 const &v) {
+    fX -= v.fX;
+    fY -= v.fY;
+    fZ -= v.fZ;
+    fE -= v.fE;
+    return *this;
+  }
+};
+
+inline FitVector4 operator+(FitVector4 const &a, FitVector4 const &b) {
+  return FitVector4(a.fX + b.fX, a.fY + b.fY, a.fZ + b.fZ, a.fE + b.fE);
+}
+inline FitVector4 operator-(FitVector4 const &a, FitVector4 const &b) {
+  return FitVector4(a.fX - b.fX, a.fY - b.fY, a.fZ - b.fZ, a.fE - b.fE);
+}
+/// Minkowski product, as for TLorentzVector.
+inline double operator*(FitVector4 const &a, FitVector4 const &b) {
+  return a.Dot(b);
+}
+inline FitVector4 operator*(FitVector4 const &v, double a) {
+  return FitVector4(a * v.fX, a * v.fY, a * v.fZ, a * v.fE);
+}
+inline FitVector4 operator*(double a, FitVector4 const &v) {
+  return FitVector4(a * v.fX, a * v.fY, a * v.fZ, a * v.fE);
+}
+
+/*! @} */
+#endif
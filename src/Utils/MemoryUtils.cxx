@@ -0,0 +1,169 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#include "MemoryUtils.h"
+
+#include "FitLogger.h"
+#include "NuisConfig.h"
+
+#include "TArrayC.h"
+#include "TArrayD.h"
+#include "TArrayF.h"
+#include "TArrayI.h"
+#include "TArrayS.h"
+#include "TClass.h"
+#include "TH1.h"
+
+#include <sys/resource.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace MemoryUtils {
+
+namespace {
+
+// Reads a "Key:   1234 kB" line from /proc/self/status, 0 if missing.
+size_t ReadProcStatus(const char *key) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  size_t keylen = strlen(key);
+  while (std::getline(status, line)) {
+    if (line.compare(0, keylen, key) != 0) {
+      continue;
+    }
+    std::stringstream ss(line.substr(keylen));
+    size_t kb = 0;
+    ss >> kb;
+    return kb * 1024;
+  }
+  return 0;
+}
+
+size_t AxisBytes(TAxis const *axis) {
+  return axis->GetXbins()->GetSize() * sizeof(double);
+}
+
+} // namespace
+
+size_t GetCurrentRSS() { return ReadProcStatus("VmRSS:"); }
+
+size_t GetPeakRSS() {
+  size_t peak = ReadProcStatus("VmHWM:");
+  if (peak) {
+    return peak;
+  }
+
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  return usage.ru_maxrss;
+#else
+  return usage.ru_maxrss * 1024;
+#endif
+}
+
+bool ResetPeakRSS() {
+  // Linux resets VmHWM to the current RSS when 5 is written here
+  FILE *clear = fopen("/proc/self/clear_refs", "w");
+  if (!clear) {
+    return false;
+  }
+  bool ok = (fputs("5", clear) >= 0);
+  ok = (fclose(clear) == 0) && ok;
+  return ok;
+}
+
+size_t GetHistBytes(TH1 const *hist) {
+  if (!hist) {
+    return 0;
+  }
+
+  size_t bytes = hist->IsA()->Size();
+
+  // TH1D, TH2F, ... store their bins by also being a TArray
+  TArray const *bins = dynamic_cast<TArray const *>(hist);
+  if (bins) {
+    size_t elsize = sizeof(double);
+    if (dynamic_cast<TArrayF const *>(hist) ||
+        dynamic_cast<TArrayI const *>(hist)) {
+      elsize = 4;
+    } else if (dynamic_cast<TArrayS const *>(hist)) {
+      elsize = 2;
+    } else if (dynamic_cast<TArrayC const *>(hist)) {
+      elsize = 1;
+    }
+    bytes += bins->GetSize() * elsize;
+  }
+
+  bytes += hist->GetSumw2N() * sizeof(double);
+  bytes += AxisBytes(hist->GetXaxis()) + AxisBytes(hist->GetYaxis()) +
+           AxisBytes(hist->GetZaxis());
+  return bytes;
+}
+
+size_t GetMatrixBytes(TMatrixDBase const *mat) {
+  if (!mat) {
+    return 0;
+  }
+  return mat->IsA()->Size() + mat->GetNoElements() * sizeof(double);
+}
+
+void ByteTally::Add(TH1 const *hist) {
+  if (!hist || !fSeen.insert(hist).second) {
+    return;
+  }
+  fBytes += GetHistBytes(hist);
+}
+
+void ByteTally::AddMatrix(TMatrixDBase const *mat) {
+  if (!mat || !fSeen.insert(mat).second) {
+    return;
+  }
+  fBytes += GetMatrixBytes(mat);
+}
+
+double GetBudgetMB() { return FitPar::Config().GetParD("MemoryBudgetMB"); }
+
+bool OverBudget(size_t extrabytes) {
+  double budget = GetBudgetMB();
+  if (budget <= 0) {
+    return false;
+  }
+  return (GetCurrentRSS() + extrabytes) > budget * 1024. * 1024.;
+}
+
+void LogPhase(std::string const &phase) {
+  NUIS_LOG(REC, "Memory after " << phase << ": RSS = "
+                                << ToMB(GetCurrentRSS())
+                                << ", peak RSS = " << ToMB(GetPeakRSS()));
+  ResetPeakRSS();
+}
+
+std::string ToMB(size_t bytes) {
+  std::stringstream ss;
+  ss.precision(1);
+  ss << std::fixed << double(bytes) / (1024. * 1024.) << " MB";
+  return ss.str();
+}
+
+} // namespace MemoryUtils
@@ -0,0 +1,86 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef MEMORYUTILS_H_SEEN
+#define MEMORYUTILS_H_SEEN
+
+#include "TMatrixDBase.h"
+
+#include <cstddef>
+#include <set>
+#include <string>
+
+class TH1;
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+/// Byte counting for the caches and histograms NUISANCE holds, process
+/// resident memory, and the optional MemoryBudgetMB limit.
+namespace MemoryUtils {
+
+/// Current resident set size in bytes, 0 if it cannot be read.
+size_t GetCurrentRSS();
+
+/// Peak resident set size in bytes since the process started or the last
+/// successful ResetPeakRSS.
+size_t GetPeakRSS();
+
+/// Restart peak RSS tracking. Returns false if the OS does not support it,
+/// in which case GetPeakRSS stays the process peak.
+bool ResetPeakRSS();
+
+/// Heap bytes held by a histogram: bin contents, sumw2 and variable bin edges.
+size_t GetHistBytes(TH1 const *hist);
+
+/// Heap bytes held by a matrix.
+size_t GetMatrixBytes(TMatrixDBase const *mat);
+
+/// Sum of histogram and matrix bytes, each object counted once however many
+/// lists it appears in.
+class ByteTally {
+public:
+  ByteTally() : fBytes(0) {}
+  void Add(TH1 const *hist);
+  void AddMatrix(TMatrixDBase const *mat);
+  void AddBytes(size_t bytes) { fBytes += bytes; }
+  size_t GetBytes() const { return fBytes; }
+
+private:
+  std::set<void const *> fSeen;
+  size_t fBytes;
+};
+
+/// MemoryBudgetMB from the config, <= 0 means no budget.
+double GetBudgetMB();
+
+/// Would holding extrabytes more than now take the process over budget.
+bool OverBudget(size_t extrabytes = 0);
+
+/// Log current and peak RSS for a phase then restart the peak tracking.
+void LogPhase(std::string const &phase);
+
+/// Bytes as a MB string for logging.
+std::string ToMB(size_t bytes);
+
+} // namespace MemoryUtils
+
+/*! @} */
+#endif
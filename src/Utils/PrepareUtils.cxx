@@ -0,0 +1,236 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#include "PrepareUtils.h"
+
+#include "FitLogger.h"
+#include "NuisConfig.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+
+namespace PrepareUtils {
+
+namespace {
+
+// Each record is an int label index followed by the EntrySummary. The index
+// equal to the number of labels seen so far in the chunk introduces a new
+// label, whose length and characters follow the index.
+const int kNoLabel = -1;
+
+FILE *OpenTempFile() {
+  const char *tmpdir = getenv("TMPDIR");
+  std::string templ = std::string((tmpdir && tmpdir[0]) ? tmpdir : "/tmp") +
+                      "/nuisance_prepare_XXXXXX";
+  std::vector<char> name(templ.begin(), templ.end());
+  name.push_back('\0');
+
+  int fd = mkstemp(&name[0]);
+  if (fd < 0) {
+    NUIS_ABORT("Could not create a temporary file from " << templ);
+  }
+  unlink(&name[0]);
+
+  FILE *f = fdopen(fd, "w+b");
+  if (!f) {
+    close(fd);
+    NUIS_ABORT("Could not open temporary file for writing.");
+  }
+  return f;
+}
+
+// Runs in the worker process, never returns.
+void RunWorker(EntryReader &reader, Long64_t first, Long64_t last, FILE *out) {
+  reader.OpenWorker();
+
+  std::map<std::string, int> labels;
+  EntrySummary sum;
+  std::string label;
+  bool ok = true;
+
+  for (Long64_t i = first; ok && i < last; i++) {
+    label.clear();
+    reader.Read(i, sum, label);
+
+    int index = kNoLabel;
+    bool newlabel = false;
+    if (!label.empty()) {
+      std::map<std::string, int>::iterator it = labels.find(label);
+      if (it == labels.end()) {
+        index = labels.size();
+        labels[label] = index;
+        newlabel = true;
+      } else {
+        index = it->second;
+      }
+    }
+
+    ok = (fwrite(&index, sizeof(index), 1, out) == 1);
+    if (ok && newlabel) {
+      size_t len = label.size();
+      ok = (fwrite(&len, sizeof(len), 1, out) == 1) &&
+           (fwrite(label.data(), 1, len, out) == len);
+    }
+    ok = ok && (fwrite(&sum, sizeof(sum), 1, out) == 1);
+  }
+
+  ok = (fflush(out) == 0) && ok;
+  // Skip atexit handlers and static destructors, they belong to the parent.
+  _exit(ok ? 0 : 1);
+}
+
+} // namespace
+
+ChunkedEntryLoop::ChunkedEntryLoop(Long64_t nentries, int nworkers)
+    : fNEntries(nentries), fNWorkersRequested(nworkers), fReader(NULL),
+      fCurrentChunk(0), fNext(0) {}
+
+ChunkedEntryLoop::~ChunkedEntryLoop() { Finish(); }
+
+int ChunkedEntryLoop::ResolveNWorkers(int requested) {
+  if (requested < 0) {
+    requested = FitPar::Config().GetParI("PrepareNWorkers");
+  }
+  if (requested == 0) {
+    long ncores = sysconf(_SC_NPROCESSORS_ONLN);
+    requested = (ncores > 0) ? ncores : 1;
+  }
+  return requested;
+}
+
+void ChunkedEntryLoop::Start(EntryReader &reader) {
+  fReader = &reader;
+  fNext = 0;
+  fCurrentChunk = 0;
+
+  int nworkers = fNWorkersRequested;
+  if (nworkers > fNEntries) {
+    nworkers = fNEntries;
+  }
+  if (nworkers <= 1) {
+    return;
+  }
+
+  NUIS_LOG(FIT, "Reading " << fNEntries << " entries with " << nworkers
+                           << " worker processes.");
+
+  // Anything still buffered would otherwise be printed by every worker.
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(NULL);
+
+  for (int c = 0; c < nworkers; c++) {
+    Chunk chunk;
+    chunk.First = (fNEntries * c) / nworkers;
+    chunk.Last = (fNEntries * (c + 1)) / nworkers;
+    chunk.File = OpenTempFile();
+    chunk.PID = fork();
+
+    if (chunk.PID < 0) {
+      NUIS_ABORT("Failed to fork worker " << c << " for entries "
+                                          << chunk.First << " to "
+                                          << chunk.Last);
+    } else if (chunk.PID == 0) {
+      RunWorker(reader, chunk.First, chunk.Last, chunk.File);
+    }
+
+    fChunks.push_back(chunk);
+  }
+
+  OpenChunk(0);
+}
+
+void ChunkedEntryLoop::OpenChunk(size_t ichunk) {
+  Chunk &chunk = fChunks[ichunk];
+
+  int status = 0;
+  if (waitpid(chunk.PID, &status, 0) != chunk.PID || !WIFEXITED(status) ||
+      WEXITSTATUS(status) != 0) {
+    NUIS_ABORT("Worker reading entries " << chunk.First << " to "
+                                         << chunk.Last << " failed.");
+  }
+  chunk.PID = 0;
+
+  rewind(chunk.File);
+  fLabels.clear();
+  fCurrentChunk = ichunk;
+}
+
+void ChunkedEntryLoop::Next(Long64_t i, EntrySummary &sum,
+                            std::string &label) {
+  if (fChunks.empty()) {
+    label.clear();
+    fReader->Read(i, sum, label);
+    return;
+  }
+
+  if (i != fNext || i >= fNEntries) {
+    NUIS_ABORT("Entry " << i << " requested out of order, expected " << fNext);
+  }
+  fNext++;
+
+  while (i >= fChunks[fCurrentChunk].Last) {
+    fclose(fChunks[fCurrentChunk].File);
+    fChunks[fCurrentChunk].File = NULL;
+    OpenChunk(fCurrentChunk + 1);
+  }
+  FILE *in = fChunks[fCurrentChunk].File;
+
+  int index = kNoLabel;
+  bool ok = (fread(&index, sizeof(index), 1, in) == 1);
+  if (ok && index == int(fLabels.size())) {
+    size_t len = 0;
+    ok = (fread(&len, sizeof(len), 1, in) == 1);
+    if (ok) {
+      std::string newlabel(len, ' ');
+      ok = (fread(&newlabel[0], 1, len, in) == len);
+      fLabels.push_back(newlabel);
+    }
+  }
+  ok = ok && (index == kNoLabel || index < int(fLabels.size()));
+  ok = ok && (fread(&sum, sizeof(sum), 1, in) == 1);
+  if (!ok) {
+    NUIS_ABORT("Failed to read worker summary for entry " << i);
+  }
+
+  if (index == kNoLabel) {
+    label.clear();
+  } else {
+    label = fLabels[index];
+  }
+}
+
+void ChunkedEntryLoop::Finish() {
+  for (size_t c = 0; c < fChunks.size(); c++) {
+    if (fChunks[c].PID > 0) {
+      int status = 0;
+      waitpid(fChunks[c].PID, &status, 0);
+    }
+    if (fChunks[c].File) {
+      fclose(fChunks[c].File);
+    }
+  }
+  fChunks.clear();
+  fLabels.clear();
+}
+
+} // namespace PrepareUtils
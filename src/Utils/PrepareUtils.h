@@ -0,0 +1,111 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef PREPAREUTILS_H_SEEN
+#define PREPAREUTILS_H_SEEN
+
+#include "Rtypes.h"
+
+#include <sys/types.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+/// Helpers shared by the Prepare* generator applications.
+namespace PrepareUtils {
+
+/// The few numbers a Prepare app needs from each generator entry.
+struct EntrySummary {
+  double E;
+  double Weight;
+  int Key;
+};
+
+/// Reads generator entries into summaries. Read is called in entry order,
+/// either in the main process or in a worker that has called OpenWorker.
+class EntryReader {
+public:
+  virtual ~EntryReader() {}
+
+  /// Called once in each worker process before it reads anything. Workers
+  /// must open their own copy of the input rather than share the parent's.
+  virtual void OpenWorker() = 0;
+
+  /// Fill sum, and label if the app groups entries by a string, for entry i.
+  virtual void Read(Long64_t i, EntrySummary &sum, std::string &label) = 0;
+};
+
+/// Splits [0, nentries) into one contiguous range per worker process. Each
+/// worker reads its range through an EntryReader and writes the summaries to
+/// an unlinked temporary file, which the parent hands back through Next in
+/// entry order. Histograms filled from Next are therefore filled in the same
+/// order, and with the same values, as a single process loop, so the output
+/// does not depend on the number of workers.
+///
+/// With nworkers <= 1 Next just calls the reader in the current process.
+class ChunkedEntryLoop {
+public:
+  /// Temporary files go to $TMPDIR or /tmp.
+  ChunkedEntryLoop(Long64_t nentries, int nworkers);
+  ~ChunkedEntryLoop();
+
+  /// Start the workers, if any.
+  void Start(EntryReader &reader);
+
+  /// Get entry i. Entries must be requested in order from 0.
+  void Next(Long64_t i, EntrySummary &sum, std::string &label);
+
+  /// Close temporary files and reap any workers still running.
+  void Finish();
+
+  inline int GetNWorkers() const { return fChunks.size(); };
+
+  /// Number of workers to use for a -j request: config PrepareNWorkers if
+  /// requested < 0, one per online core if it is 0.
+  static int ResolveNWorkers(int requested);
+
+private:
+  struct Chunk {
+    Long64_t First;
+    Long64_t Last;
+    pid_t PID;
+    FILE *File;
+  };
+
+  void OpenChunk(size_t ichunk);
+
+  Long64_t fNEntries;
+  int fNWorkersRequested;
+  EntryReader *fReader;
+
+  std::vector<Chunk> fChunks;
+  size_t fCurrentChunk;
+  Long64_t fNext;
+  std::vector<std::string> fLabels;
+};
+
+} // namespace PrepareUtils
+
+/*! @} */
+#endif
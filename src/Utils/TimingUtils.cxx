@@ -0,0 +1,186 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#include "TimingUtils.h"
+
+#include "FitLogger.h"
+#include "NuisConfig.h"
+
+#include "TDirectory.h"
+#include "TObjString.h"
+#include "TTree.h"
+
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <vector>
+
+namespace TimingUtils {
+
+int gEnabled = -1;
+
+namespace {
+
+struct Owner {
+  std::string Type;
+  std::string Name;
+  double Seconds[kNStages];
+  long Calls[kNStages];
+};
+
+std::vector<Owner> gOwners;
+std::map<std::string, int> gOwnerIDs;
+
+const char *const kStageNames[kNStages] = {
+    "FillEventVariables", "isSignal",   "FillHistograms", "ConvertEventRates",
+    "GetLikelihood",      "CalcWeight", "ReadEvent"};
+
+} // namespace
+
+std::string GetStageName(int stage) {
+  if (stage < 0 || stage >= kNStages) {
+    return "Unknown";
+  }
+  return kStageNames[stage];
+}
+
+bool ReadEnabled() {
+  gEnabled = FitPar::Config().GetParB("ProfileHotPaths");
+  return gEnabled;
+}
+
+void SetEnabled(bool enable) { gEnabled = enable; }
+
+int Register(std::string const &type, std::string const &name) {
+  std::string key = type + "/" + name;
+  std::map<std::string, int>::iterator it = gOwnerIDs.find(key);
+  if (it != gOwnerIDs.end()) {
+    return it->second;
+  }
+
+  Owner own;
+  own.Type = type;
+  own.Name = name;
+  for (int i = 0; i < kNStages; i++) {
+    own.Seconds[i] = 0;
+    own.Calls[i] = 0;
+  }
+
+  int id = gOwners.size();
+  gOwners.push_back(own);
+  gOwnerIDs[key] = id;
+  return id;
+}
+
+void Add(int id, int stage, double seconds) {
+  Owner &own = gOwners[id];
+  own.Seconds[stage] += seconds;
+  own.Calls[stage]++;
+}
+
+void Reset() {
+  for (size_t i = 0; i < gOwners.size(); i++) {
+    for (int j = 0; j < kNStages; j++) {
+      gOwners[i].Seconds[j] = 0;
+      gOwners[i].Calls[j] = 0;
+    }
+  }
+}
+
+void PrintSummary() {
+  if (gOwners.empty()) {
+    return;
+  }
+
+  NUIS_LOG(FIT, "Hot path timings:");
+  NUIS_LOG(FIT, std::left << std::setw(14) << "Type" << std::setw(52)
+                          << "Name" << std::setw(20) << "Stage" << std::right
+                          << std::setw(12) << "Calls" << std::setw(12)
+                          << "Total [s]" << std::setw(15) << "Per call [us]");
+  for (size_t i = 0; i < gOwners.size(); i++) {
+    Owner const &own = gOwners[i];
+    for (int j = 0; j < kNStages; j++) {
+      if (!own.Calls[j]) {
+        continue;
+      }
+      NUIS_LOG(FIT, std::left
+                        << std::setw(14) << own.Type << std::setw(52)
+                        << own.Name << std::setw(20) << kStageNames[j]
+                        << std::right << std::setw(12) << own.Calls[j]
+                        << std::setw(12) << std::fixed << std::setprecision(3)
+                        << own.Seconds[j] << std::setw(15)
+                        << std::setprecision(3)
+                        << 1E6 * own.Seconds[j] / double(own.Calls[j]));
+    }
+  }
+}
+
+void Write(TDirectory *dir) {
+  if (gOwners.empty()) {
+    return;
+  }
+
+  TDirectory *olddir = gDirectory;
+  dir->cd();
+
+  std::string type, name, stage;
+  long calls = 0;
+  double seconds = 0;
+
+  TTree *tree = new TTree("HotPathTimings", "HotPathTimings");
+  tree->Branch("type", &type);
+  tree->Branch("name", &name);
+  tree->Branch("stage", &stage);
+  tree->Branch("calls", &calls, "calls/L");
+  tree->Branch("seconds", &seconds, "seconds/D");
+
+  std::stringstream json;
+  json << "[";
+  bool first = true;
+  for (size_t i = 0; i < gOwners.size(); i++) {
+    Owner const &own = gOwners[i];
+    for (int j = 0; j < kNStages; j++) {
+      if (!own.Calls[j]) {
+        continue;
+      }
+      type = own.Type;
+      name = own.Name;
+      stage = kStageNames[j];
+      calls = own.Calls[j];
+      seconds = own.Seconds[j];
+      tree->Fill();
+
+      json << (first ? "\n" : ",\n") << "  {\"type\": \"" << type
+           << "\", \"name\": \"" << name << "\", \"stage\": \"" << stage
+           << "\", \"calls\": " << calls << ", \"seconds\": "
+           << std::setprecision(9) << seconds << "}";
+      first = false;
+    }
+  }
+  json << "\n]\n";
+
+  tree->Write();
+  delete tree;
+
+  TObjString jsonstr(json.str().c_str());
+  jsonstr.Write("HotPathTimings_json");
+
+  olddir->cd();
+}
+
+} // namespace TimingUtils
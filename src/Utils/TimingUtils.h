@@ -0,0 +1,121 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef TIMINGUTILS_H_SEEN
+#define TIMINGUTILS_H_SEEN
+
+#include <time.h>
+
+#include <string>
+
+class TDirectory;
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+/// Wall time and call counts of the per-event and per-evaluation hot paths,
+/// accumulated per sample, weight engine and input. Enabled with the
+/// ProfileHotPaths config option, otherwise each timer costs one branch.
+/// Only the main thread should record timings.
+namespace TimingUtils {
+
+/// Timed stages, a single owner will usually only use some of them.
+enum Stage {
+  kFillEventVariables = 0,
+  kIsSignal,
+  kFillHistograms,
+  kConvertEventRates,
+  kGetLikelihood,
+  kCalcWeight,
+  kReadEvent,
+  kNStages
+};
+
+/// Name used for a stage in the summary and output tree.
+std::string GetStageName(int stage);
+
+/// -1 until the config has been read, then 0 or 1.
+extern int gEnabled;
+
+/// Read ProfileHotPaths from the config.
+bool ReadEnabled();
+
+/// Is profiling turned on. Read from the config on first use.
+inline bool IsEnabled() { return (gEnabled < 0) ? ReadEnabled() : gEnabled; }
+
+/// Force profiling on or off, e.g. from an application flag.
+void SetEnabled(bool enable);
+
+/// Get the id of a named owner, registering it on first use.
+/// Owners with the same type and name share their counters.
+int Register(std::string const &type, std::string const &name);
+
+/// Add a timed call to an owner's stage.
+void Add(int id, int stage, double seconds);
+
+/// Drop all accumulated timings, keeping the registered owners.
+void Reset();
+
+/// Print a table of every owner/stage that was called.
+void PrintSummary();
+
+/// Write a "HotPathTimings" TTree and a JSON copy of the table to dir.
+void Write(TDirectory *dir);
+
+/// Monotonic wall time in seconds.
+inline double Now() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1E-9 * ts.tv_nsec;
+}
+
+/// Times its own lifetime against an owner stage if profiling is enabled.
+/// The owner keeps id (initially -1) so it is only registered once.
+class ScopedTimer {
+public:
+  ScopedTimer(int &id, const char *type, std::string const &name, int stage)
+      : fID(id), fStage(stage), fStart(-1) {
+    if (IsEnabled()) {
+      if (id < 0) {
+        id = Register(type, name);
+      }
+      fID = id;
+      fStart = Now();
+    }
+  }
+  /// Time against an already registered id, nothing is timed if id < 0.
+  ScopedTimer(int id, int stage)
+      : fID(id), fStage(stage), fStart((id >= 0) ? Now() : -1) {}
+  ~ScopedTimer() {
+    if (fStart >= 0) {
+      Add(fID, fStage, Now() - fStart);
+    }
+  }
+
+private:
+  int fID;
+  int fStage;
+  double fStart;
+};
+
+} // namespace TimingUtils
+
+/*! @} */
+#endif